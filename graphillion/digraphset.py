@@ -21,8 +21,9 @@
 """
 
 from functools import partial
+import json
 import _graphillion
-from graphillion.universe import ObjectTable
+from graphillion.universe import ObjectTable, Universe
 from graphillion.setset_base import setset_base
 import pickle
 import heapq
@@ -771,6 +772,154 @@ class DiGraphSet(object):
             except StopIteration:
                 return
 
+    def min_cost(self, weights=None):
+        """Returns the minimum total weight of digraphs in `self`.
+
+        The weights of edges are specified by the argument `weights`
+        or those set as the universe (1.0 for unspecified edges), as
+        in min_iter().
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = DiGraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.min_cost(weights)
+          -1.0
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          The minimum weight, or float('inf') if `self` is empty.
+
+        See Also:
+          max_cost(), argmin(), min_cost_sets(), min_iter()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return self._ss.min_cost(DiGraphSet._objtable, weights)
+
+    def max_cost(self, weights=None):
+        """Returns the maximum total weight of digraphs in `self`.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          The maximum weight, or float('-inf') if `self` is empty.
+
+        See Also:
+          min_cost(), argmax(), max_cost_sets(), max_iter()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return self._ss.max_cost(DiGraphSet._objtable, weights)
+
+    def argmin(self, weights=None):
+        """Returns a digraph of the minimum total weight in `self`.
+
+        If several digraphs have the minimum weight, one of them is
+        returned.
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = DiGraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.argmin(weights)
+          [(1, 2), (1, 4)]
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A digraph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmax(), min_cost(), min_cost_sets()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return DiGraphSet._conv_ret(self._ss.argmin(DiGraphSet._objtable, weights))
+
+    def argmax(self, weights=None):
+        """Returns a digraph of the maximum total weight in `self`.
+
+        If several digraphs have the maximum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A digraph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmin(), max_cost(), max_cost_sets()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return DiGraphSet._conv_ret(self._ss.argmax(DiGraphSet._objtable, weights))
+
+    def min_cost_sets(self, weights=None):
+        """Returns a new DiGraphSet with all digraphs of the minimum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A new DiGraphSet object.
+
+        See Also:
+          max_cost_sets(), min_cost(), argmin()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return DiGraphSet(self._ss.min_cost_sets(DiGraphSet._objtable, weights))
+
+    def max_cost_sets(self, weights=None):
+        """Returns a new DiGraphSet with all digraphs of the maximum total weight.
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = DiGraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.max_cost_sets(weights)
+          DiGraphSet([[(2, 3)]])
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A new DiGraphSet object.
+
+        See Also:
+          min_cost_sets(), max_cost(), argmax()
+
+        """
+        if weights is None:
+            weights = DiGraphSet._weights
+        return DiGraphSet(self._ss.max_cost_sets(DiGraphSet._objtable, weights))
+
     def __contains__(self, obj):
         """Returns True if `obj` is in the `self`, False otherwise.
 
@@ -1145,6 +1294,59 @@ class DiGraphSet(object):
         """
         return DiGraphSet(self._ss.set_size(size))
 
+    def graph_size_between(self, lower, upper):
+        """Returns a new DiGraphSet with digraphs that have `lower` to `upper` edges.
+
+        This method returns a new DiGraphSet with digraphs whose number
+        of edges is between `lower` and `upper` inclusive.  It
+        traverses the diagram once, instead of combining smaller() and
+        larger().
+
+        Examples:
+          >>> graph1 = [(1, 2)]
+          >>> graph2 = [(1, 2), (1, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (2, 3)]
+          >>> gs = DiGraphSet([graph1, graph2, graph3])
+          >>> gs.graph_size_between(1, 2)
+          DiGraphSet([[(1, 2)], [(1, 2), (1, 4)]])
+
+        Args:
+          lower: The lower limit of the number of edges in a digraph.
+          upper: The upper limit of the number of edges in a digraph.
+
+        Returns:
+          A new DiGraphSet object.
+
+        See Also:
+          graph_size(), smaller(), larger()
+
+        """
+        return DiGraphSet(self._ss.size_between(lower, upper))
+
+    def graph_size_distribution(self):
+        """Returns the number of digraphs in `self` for each number of edges.
+
+        The counts for all sizes are computed in a single pass over the
+        diagram.
+
+        Examples:
+          >>> graph1 = [(1, 2)]
+          >>> graph2 = [(1, 2), (1, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (2, 3)]
+          >>> gs = DiGraphSet([graph1, graph2, graph3])
+          >>> gs.graph_size_distribution()
+          {1: 1, 2: 1, 3: 1}
+
+        Returns:
+          A dictionary mapping each number of edges to the number
+          of digraphs of that size.
+
+        See Also:
+          graph_size(), len()
+
+        """
+        return self._ss.size_dist()
+
     def complement(self):
         """Returns a new DiGraphSet with complement digraphs of `self`.
 
@@ -1594,9 +1796,80 @@ class DiGraphSet(object):
           TypeError: If at least one cost is not integer.
 
         """
-        le_ss = self._ss.cost_le(objtable=DiGraphSet._objtable, costs=costs, cost_bound=cost_bound)
-        lt_ss = self._ss.cost_le(objtable=DiGraphSet._objtable, costs=costs, cost_bound=cost_bound - 1)
-        return DiGraphSet(le_ss.difference(lt_ss))
+        return DiGraphSet(self._ss.cost_between(objtable=DiGraphSet._objtable, costs=costs, lower=cost_bound, upper=cost_bound))
+
+    def cost_between(self, costs, lower, upper):
+        """Returns a new DiGraphSet with subgraphs whose cost is between the lower and upper bounds.
+
+        This method constructs a DiGraphSet of subgraphs
+        whose cost is greater than or equal to `lower` and
+        less than or equal to `upper`, where `costs` of each edge
+        are given as an argument.  The subgraphs are selected in a single
+        pass over the diagram.
+
+        Examples:
+          >>> universe = [(1, 2), (1, 4), (2, 3), (3, 4)]
+          >>> DiGraphSet.set_universe(universe)
+
+          >>> graph1 = [(1, 2), (2, 3)]
+          >>> graph2 = [(3, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (3, 4)]
+          >>> gs = DiGraphSet([graph1, graph2, graph3])
+          >>> costs = {(1, 2): 2, (1, 4): 3, (2, 3): 1, (3, 4): 7}
+          >>> print(gs.cost_between(costs, 3, 7))
+          DiGraphSet([[(3, 4)], [(1, 2), (2, 3)]])
+
+        Args:
+          costs: A dictionary of the cost of each edge.
+          lower: The lower limit of the cost of each digraph. 32 bit signed integer.
+          upper: The upper limit of the cost of each digraph. 32 bit signed integer.
+
+        Returns:
+          A new DiGraphSet object.
+
+        Raises:
+          KeyError: If a given edge is not found in the universe.
+          AssertionError: If the cost of at least one edge is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        """
+        return DiGraphSet(self._ss.cost_between(objtable=DiGraphSet._objtable, costs=costs, lower=lower, upper=upper))
+
+    def cost_distribution(self, costs, probabilities=None, max_cost=None):
+        """Returns the number of digraphs in `self` for each total cost.
+
+        This method computes, in a single pass over the diagram, how
+        many digraphs have each total cost given `costs` of each edge.
+        If `probabilities` of each edge are given, the probability
+        of occurrence of the digraphs having each total cost is returned
+        instead of the number.
+
+        Examples:
+          >>> DiGraphSet.set_universe([(1, 2), (1, 4), (2, 3)])
+          >>> gs = DiGraphSet([[(1, 2), (1, 4)], [(2, 3)], [(1, 4), (2, 3)]])
+          >>> costs = {(1, 2): 2, (1, 4): 3, (2, 3): 2}
+          >>> gs.cost_distribution(costs)
+          {2: 1, 5: 2}
+
+        Args:
+          costs: A dictionary of the cost of each edge.
+          probabilities: Optional.  A dictionary of the probability of each edge.
+          max_cost: Optional.  Costs larger than `max_cost` are omitted,
+            which also saves work if no cost is negative.
+
+        Returns:
+          A dictionary mapping each total cost to the number (or the
+          probability) of digraphs of that cost.
+
+        Raises:
+          KeyError: If a given edge is not found in the universe.
+          AssertionError: If the cost of at least one edge is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        See Also:
+          cost_le(), probability()
+        """
+        return self._ss.cost_dist(objtable=DiGraphSet._objtable, costs=costs, probabilities=probabilities, max_cost=max_cost)
 
     def remove_some_edge(self):
         """Returns a new DiGraphSet with digraphs that are obtained by removing some edge from a digraph in `self`.
@@ -1748,8 +2021,14 @@ class DiGraphSet(object):
             The default is 'greedy', best-first search from `source`
             with respect to the number of unused incident edges.
             Other options include 'bfs', the breadth-first search, 
-            'dfs', the depth-first search, and 'as-is', the order of
-            `universe` list.
+            'dfs', the depth-first search, 'frontier', which searches
+            for an order keeping the largest frontier of the
+            frontier-based search small, 'frontier-sum', which keeps
+            the total of the frontiers small instead, and 'as-is', the
+            order of `universe` list.  The 'frontier' traversals start
+            from the 'greedy' order and spend a fixed amount of search,
+            so they give the same order on every run unless cut off by
+            `Universe.frontier_time_limit` seconds (1.0 by default).
 
           source: Optional.  This argument specifies the starting
             point of the edge traversal.
@@ -2009,33 +2288,8 @@ class DiGraphSet(object):
             graph.append(
                 (pickle.dumps(e[0], protocol=0), pickle.dumps(e[1], protocol=0)))
 
-        in_dc = None
-        if in_degree_constraints is not None:
-            in_dc = {}
-            for v, r in in_degree_constraints.items():
-                if v not in DiGraphSet._vertices:
-                    raise KeyError(v)
-                if isinstance(r, int):
-                    in_dc[pickle.dumps(v, protocol=0)] = (r, r + 1, 1)
-                elif len(r) == 1:
-                    in_dc[pickle.dumps(v, protocol=0)] = (r[0], r[0] + 1, 1)
-                else:
-                    in_dc[pickle.dumps(v, protocol=0)] = (
-                        r[0], r[-1] + 1, r[1] - r[0])
-
-        out_dc = None
-        if out_degree_constraints is not None:
-            out_dc = {}
-            for v, r in out_degree_constraints.items():
-                if v not in DiGraphSet._vertices:
-                    raise KeyError(v)
-                if isinstance(r, int):
-                    out_dc[pickle.dumps(v, protocol=0)] = (r, r + 1, 1)
-                elif len(r) == 1:
-                    out_dc[pickle.dumps(v, protocol=0)] = (r[0], r[0] + 1, 1)
-                else:
-                    out_dc[pickle.dumps(v, protocol=0)] = (
-                        r[0], r[-1] + 1, r[1] - r[0])
+        in_dc = DiGraphSet._degree_constraints_arg(in_degree_constraints)
+        out_dc = DiGraphSet._degree_constraints_arg(out_degree_constraints)
 
         ss = None if graphset is None else graphset._ss
 
@@ -2043,6 +2297,146 @@ class DiGraphSet(object):
             graph=graph, in_degree_constraints=in_dc, out_degree_constraints=out_dc, search_space=ss)
         return DiGraphSet(ss)
 
+    @staticmethod
+    def count_directed_cycles(graphset=None):
+        """Returns the number of digraphs that directed_cycles() would return.
+
+        The digraphs are counted level by level with multiple threads,
+        without building the decision diagram; only the states of the
+        current and the pending levels are kept in memory.  The other
+        count_*() methods work in the same way.
+
+        Examples:
+          >>> DiGraphSet.count_directed_cycles() == len(DiGraphSet.directed_cycles())
+          True
+
+          Args:
+            graphset: Optional.  The same as directed_cycles().
+
+          Returns:
+            The number of digraphs.
+        """
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._directed_cycles(
+            graph=DiGraphSet._graph_arg(), search_space=ss, count=True)
+
+    @staticmethod
+    def count_directed_hamiltonian_cycles(graphset=None):
+        """Returns the number of digraphs that directed_hamiltonian_cycles()
+        would return.
+
+          Args:
+            graphset: Optional.  The same as directed_hamiltonian_cycles().
+
+          Returns:
+            The number of digraphs.
+        """
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._directed_hamiltonian_cycles(
+            graph=DiGraphSet._graph_arg(), search_space=ss, count=True)
+
+    @staticmethod
+    def count_directed_st_paths(s, t, is_hamiltonian=False, graphset=None):
+        """Returns the number of digraphs that directed_st_paths() would
+        return.
+
+          Args:
+            s, t, is_hamiltonian, graphset: The same as
+              directed_st_paths().
+
+          Returns:
+            The number of digraphs.
+        """
+        assert(s in DiGraphSet._vertices and t in DiGraphSet._vertices)
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._directed_st_path(
+            graph=DiGraphSet._graph_arg(), s=pickle.dumps(s, protocol=0),
+            t=pickle.dumps(t, protocol=0), is_hamiltonian=is_hamiltonian,
+            search_space=ss, count=True)
+
+    @staticmethod
+    def count_rooted_forests(roots=None, is_spanning=False, graphset=None):
+        """Returns the number of digraphs that rooted_forests() would
+        return.
+
+          Args:
+            roots, is_spanning, graphset: Optional.  The same as
+              rooted_forests().
+
+          Returns:
+            The number of digraphs.
+        """
+        rs = []
+        if roots is not None:
+            for root in roots:
+                assert root in DiGraphSet._vertices
+                rs.append(pickle.dumps(root, protocol=0))
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._rooted_forests(
+            graph=DiGraphSet._graph_arg(), roots=rs, is_spanning=is_spanning,
+            search_space=ss, count=True)
+
+    @staticmethod
+    def count_rooted_trees(root, is_spanning=False, graphset=None):
+        """Returns the number of digraphs that rooted_trees() would return.
+
+          Args:
+            root, is_spanning, graphset: The same as rooted_trees().
+
+          Returns:
+            The number of digraphs.
+        """
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._rooted_trees(
+            graph=DiGraphSet._graph_arg(), root=pickle.dumps(root, protocol=0),
+            is_spanning=is_spanning, search_space=ss, count=True)
+
+    @staticmethod
+    def count_graphs(in_degree_constraints=None, out_degree_constraints=None,
+                     graphset=None):
+        """Returns the number of digraphs that graphs() would return.
+
+          Args:
+            in_degree_constraints, out_degree_constraints, graphset:
+              Optional.  The same as graphs().
+
+          Returns:
+            The number of digraphs.
+        """
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._directed_graphs(
+            graph=DiGraphSet._graph_arg(),
+            in_degree_constraints=DiGraphSet._degree_constraints_arg(
+                in_degree_constraints),
+            out_degree_constraints=DiGraphSet._degree_constraints_arg(
+                out_degree_constraints),
+            search_space=ss, count=True)
+
+    @staticmethod
+    def _graph_arg():
+        graph = []
+        for e in DiGraphSet._objtable.universe():
+            assert e[0] in DiGraphSet._vertices and e[1] in DiGraphSet._vertices
+            graph.append(
+                (pickle.dumps(e[0], protocol=0), pickle.dumps(e[1], protocol=0)))
+        return graph
+
+    @staticmethod
+    def _degree_constraints_arg(degree_constraints):
+        if degree_constraints is None:
+            return None
+        dc = {}
+        for v, r in degree_constraints.items():
+            if v not in DiGraphSet._vertices:
+                raise KeyError(v)
+            if isinstance(r, int):
+                dc[pickle.dumps(v, protocol=0)] = (r, r + 1, 1)
+            elif len(r) == 1:
+                dc[pickle.dumps(v, protocol=0)] = (r[0], r[0] + 1, 1)
+            else:
+                dc[pickle.dumps(v, protocol=0)] = (r[0], r[-1] + 1, r[1] - r[0])
+        return dc
+
     @staticmethod
     def show_messages(flag=True):
         """Enables/disables status messages.
@@ -2057,6 +2451,120 @@ class DiGraphSet(object):
         """
         return _graphillion._show_messages(flag)
 
+    @staticmethod
+    def spill_budget(nbytes):
+        """Sets the memory budget for pending search states.
+
+        Graph searches keep the states waiting at lower levels of the
+        decision diagram in memory.  Beyond the budget, whole levels
+        are moved to temporary files and read back when they are
+        processed, which trades time for memory on large graphs.
+        Searches do not use multiple threads while a budget is set.
+
+        Args:
+          nbytes: int.  The budget in bytes.  0 means unlimited
+          (initial setting).
+
+        Returns:
+          The budget before the method call.
+        """
+        return _graphillion._spill_budget(nbytes)
+
+    @staticmethod
+    def pack_states(flag=True):
+        """Packs pending search states in memory.
+
+        Graph searches keep the states waiting at lower levels of the
+        decision diagram in memory.  If enabled, each waiting state is
+        stored as the bytes that differ from the state stored before it
+        on the same level, and a level is unpacked when it is
+        processed.  States of a level that share most of their entries,
+        as in partition searches on large graphs, take a fraction of
+        their memory.  Packed levels are spilled before the others when
+        spill_budget() is set.  Searches do not use multiple threads
+        while packing is enabled.
+
+        Args:
+          flag: Optional.  True or False.  If True, pending states are
+          packed.  If False, they are not (initial setting).
+
+        Returns:
+          The setting before the method call.
+        """
+        return _graphillion._pack_states(flag)
+
+    @staticmethod
+    def build_control(max_nodes=0, max_bytes=0, time_limit=0, progress=None):
+        """Limits and monitors the construction of graph sets.
+
+        The settings apply to the searches that build graph sets, such
+        as graphs(), paths() and the other constructors.  They are
+        checked between the levels of each decision diagram, and a
+        search exceeding them stops and releases its memory.
+
+        Examples:
+          >>> def report(level, nodes, nbytes, elapsed):
+          ...     print(level, nodes, nbytes, elapsed)
+          >>> old = DiGraphSet.build_control(max_nodes=10**7, time_limit=60,
+          ...                              progress=report)
+          >>> gs = DiGraphSet.directed_st_paths(1, 64)
+          >>> DiGraphSet.build_control(**old)
+
+        Args:
+          max_nodes: int.  The maximum number of nodes of a decision
+            diagram; MemoryError is raised beyond it.  0 means unlimited.
+
+          max_bytes: int.  The maximum memory in bytes of a decision
+            diagram and the search states waiting for it; MemoryError
+            is raised beyond it.  0 means unlimited.
+
+          time_limit: float.  The maximum seconds of a search;
+            TimeoutError is raised beyond it.  0 means unlimited.
+
+          progress: A function called with the level, the number of
+            nodes, the memory in bytes and the elapsed seconds after
+            each level.  Returning False cancels the search with
+            RuntimeError, and an exception raised by the function is
+            passed through.  It must not build graph sets.
+
+        Returns:
+          A dictionary of the settings before the method call.
+        """
+        return _graphillion._build_control(max_nodes, max_bytes, time_limit,
+                                           progress)
+
+    @staticmethod
+    def build_metrics(flag=True):
+        """Records statistics of the decision diagram operations.
+
+        While recording, each search that builds graph sets, such as
+        directed_cycles() and directed_st_paths(), records its construction, subsetting,
+        reduction and evaluation passes.  A record is a dictionary with
+        keys 'name', 'size' (nodes of the result), 'elapsed' (seconds),
+        'rss_delta' (growth of the maximum resident set in KB),
+        'aborted' and 'levels'.  Each level is a dictionary with keys
+        'level', 'nodes', 'merged' (states or nodes merged into
+        others), 'dead' (nodes whose children are all empty),
+        'load_factor' (of the unique table) and 'elapsed'.  Merged and
+        dead counts and load factors are not recorded by the
+        multi-threaded passes.
+
+        Examples:
+          >>> DiGraphSet.build_metrics(True)
+          []
+          >>> gs = DiGraphSet.directed_st_paths(1, 64)
+          >>> records = DiGraphSet.build_metrics(False)
+          >>> [r['name'] for r in records]
+          ['FrontierDirectedSTPathSpec', 'reduction + ToZBDD']
+
+        Args:
+          flag: True or False.  Whether to record from now on.
+
+        Returns:
+          A list of the records since the previous method call.
+        """
+        return json.loads(_graphillion._build_metrics(flag))
+
     @staticmethod
     def _traverse(indexed_edges, traversal, source):
         neighbors = {}
@@ -2076,7 +2584,12 @@ class DiGraphSet(object):
         visited_vertices = set()
         u = source
 
-        if traversal == 'greedy':
+        if traversal == 'frontier' or traversal == 'frontier-sum':
+            sorted_edges = DiGraphSet._traverse(
+                indexed_edges, 'greedy', source)
+            return Universe._frontier_order(
+                sorted_edges, source, traversal == 'frontier-sum')
+        elif traversal == 'greedy':
             degree = dict()
             for v in vertices:
                 degree[v] = len(neighbors[v])
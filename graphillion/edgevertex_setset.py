@@ -675,6 +675,130 @@ class EdgeVertexSetSet(object):
             except StopIteration:
                 return
 
+    def min_cost(self, weights=None):
+        """Returns the minimum total weight of graphs in `self`.
+
+        The weights of edge/vertexs are specified by the argument `weights`
+        or those set as the universe (1.0 for unspecified edge/vertexs), as
+        in min_iter().
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          The minimum weight, or float('inf') if `self` is empty.
+
+        See Also:
+          max_cost(), argmin(), min_cost_sets(), min_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.min_cost(Universe.ev_objtable, weights)
+
+    def max_cost(self, weights=None):
+        """Returns the maximum total weight of graphs in `self`.
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          The maximum weight, or float('-inf') if `self` is empty.
+
+        See Also:
+          min_cost(), argmax(), max_cost_sets(), max_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.max_cost(Universe.ev_objtable, weights)
+
+    def argmin(self, weights=None):
+        """Returns a graph of the minimum total weight in `self`.
+
+        If several graphs have the minimum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          A graph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmax(), min_cost(), min_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return EdgeVertexSetSet._conv_ret(self._ss.argmin(Universe.ev_objtable, weights))
+
+    def argmax(self, weights=None):
+        """Returns a graph of the maximum total weight in `self`.
+
+        If several graphs have the maximum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          A graph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmin(), max_cost(), max_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return EdgeVertexSetSet._conv_ret(self._ss.argmax(Universe.ev_objtable, weights))
+
+    def min_cost_sets(self, weights=None):
+        """Returns a new EdgeVertexSetSet with all graphs of the minimum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          A new EdgeVertexSetSet object.
+
+        See Also:
+          max_cost_sets(), min_cost(), argmin()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return EdgeVertexSetSet(self._ss.min_cost_sets(Universe.ev_objtable, weights))
+
+    def max_cost_sets(self, weights=None):
+        """Returns a new EdgeVertexSetSet with all graphs of the maximum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of edge/vertexs to the weight
+            values.
+
+        Returns:
+          A new EdgeVertexSetSet object.
+
+        See Also:
+          min_cost_sets(), max_cost(), argmax()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return EdgeVertexSetSet(self._ss.max_cost_sets(Universe.ev_objtable, weights))
+
     def __contains__(self, obj):
         """Returns True if `obj` is in the `self`, False otherwise.
         When `obj` is a graph (list of edges/vertices), returns True
@@ -1015,6 +1139,51 @@ class EdgeVertexSetSet(object):
         """
         return EdgeVertexSetSet(self._ss.set_size(size))
 
+    def graph_size_between(self, lower, upper):
+        """Returns a new EdgeVertexSetSet with graphs that have `lower` to `upper` edges/vertices.
+
+        This method returns a new EdgeVertexSetSet with graphs whose number
+        of edges/vertices is between `lower` and `upper` inclusive.  It
+        traverses the diagram once, instead of combining smaller() and
+        larger().
+
+        Args:
+          lower: The lower limit of the number of edges/vertices in a graph.
+          upper: The upper limit of the number of edges/vertices in a graph.
+
+        Returns:
+          A new EdgeVertexSetSet object.
+
+        See Also:
+          graph_size(), smaller(), larger()
+
+        """
+        return EdgeVertexSetSet(self._ss.size_between(lower, upper))
+
+    def graph_size_distribution(self):
+        """Returns the number of graphs in `self` for each number of edges/vertices.
+
+        The counts for all sizes are computed in a single pass over the
+        diagram.
+
+        Examples:
+          >>> graph1 = [(1, 2), 1, 2]
+          >>> graph2 = [(1, 2), (1, 4), 1, 2, 4]
+          >>> graph3 = [(1, 2), (1, 4), (2, 3), 1, 2, 3, 4]
+          >>> gs = EdgeVertexSetSet([graph1, graph2, graph3])
+          >>> gs.graph_size_distribution()
+          {3: 1, 5: 1, 7: 1}
+
+        Returns:
+          A dictionary mapping each number of edges/vertices to the number
+          of graphs of that size.
+
+        See Also:
+          graph_size(), len()
+
+        """
+        return self._ss.size_dist()
+
     def join(self, other):
         """Returns a new EdgeVertexSetSet of join between `self` and `other`.
 
@@ -1448,9 +1617,73 @@ class EdgeVertexSetSet(object):
           TypeError: If at least one cost is not integer.
 
         """
-        le_ss = self._ss.cost_le(objtable=Universe.ev_objtable, costs=costs, cost_bound=cost_bound)
-        lt_ss = self._ss.cost_le(objtable=Universe.ev_objtable, costs=costs, cost_bound=cost_bound - 1)
-        return EdgeVertexSetSet(le_ss.difference(lt_ss))
+        return EdgeVertexSetSet(self._ss.cost_between(objtable=Universe.ev_objtable, costs=costs, lower=cost_bound, upper=cost_bound))
+
+    def cost_between(self, costs, lower, upper):
+        """Returns a new EdgeVertexSetSet with subgraphs whose cost is between the lower and upper bounds.
+
+        This method constructs a EdgeVertexSetSet of subgraphs
+        whose cost is greater than or equal to `lower` and
+        less than or equal to `upper`, where `costs` of each edge/vertex
+        are given as an argument.  The subgraphs are selected in a single
+        pass over the diagram.
+
+        Examples:
+          >>> universe = [(1, 2), (1, 4), (2, 3), (3, 4)]
+          >>> Universe.set_universe(universe)
+
+          >>> graph1 = [(1, 2), (2, 3), 1, 2, 3]
+          >>> graph2 = [(3, 4), 3, 4]
+          >>> graph3 = [(1, 2), (1, 4), (3, 4), 1, 2, 3, 4]
+          >>> gs = EdgeVertexSetSet([graph1, graph2, graph3])
+          >>> costs = {(1, 2): 2, (1, 4): 3, (2, 3): 1, (3, 4): 7}
+          >>> print(gs.cost_between(costs, 3, 7))
+          EdgeVertexSetSet([[(3, 4), 3, 4]])
+
+        Args:
+          costs: A dictionary of the cost of each edge/vertex.
+          lower: The lower limit of the cost of each graph. 32 bit signed integer.
+          upper: The upper limit of the cost of each graph. 32 bit signed integer.
+
+        Returns:
+          A new EdgeVertexSetSet object.
+
+        Raises:
+          KeyError: If a given edge/vertex is not found in the universe.
+          AssertionError: If the cost of at least one edge/vertex is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        """
+        return EdgeVertexSetSet(self._ss.cost_between(objtable=Universe.ev_objtable, costs=costs, lower=lower, upper=upper))
+
+    def cost_distribution(self, costs, probabilities=None, max_cost=None):
+        """Returns the number of graphs in `self` for each total cost.
+
+        This method computes, in a single pass over the diagram, how
+        many graphs have each total cost given `costs` of each edge/vertex.
+        If `probabilities` of each edge/vertex are given, the probability
+        of occurrence of the graphs having each total cost is returned
+        instead of the number.
+
+        Args:
+          costs: A dictionary of the cost of each edge/vertex.
+          probabilities: Optional.  A dictionary of the probability of each edge/vertex.
+          max_cost: Optional.  Costs larger than `max_cost` are omitted,
+            which also saves work if no cost is negative.
+
+        Returns:
+          A dictionary mapping each total cost to the number (or the
+          probability) of graphs of that cost.
+
+        Raises:
+          KeyError: If a given edge/vertex is not found in the universe.
+          AssertionError: If the cost of at least one edge/vertex is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        See Also:
+          cost_le(), probability()
+        """
+        return self._ss.cost_dist(objtable=Universe.ev_objtable, costs=costs, probabilities=probabilities, max_cost=max_cost)
 
     def dump(self, fp):
         """Serialize `self` to a file `fp`.
@@ -22,6 +22,7 @@
 
 from functools import partial
 from builtins import range, int
+import json
 import _graphillion
 from graphillion.universe import Universe
 from graphillion.setset_base import setset_base
@@ -771,6 +772,154 @@ class GraphSet(object):
             except StopIteration:
                 return
 
+    def min_cost(self, weights=None):
+        """Returns the minimum total weight of graphs in `self`.
+
+        The weights of edges are specified by the argument `weights`
+        or those set as the universe (1.0 for unspecified edges), as
+        in min_iter().
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = GraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.min_cost(weights)
+          -1.0
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          The minimum weight, or float('inf') if `self` is empty.
+
+        See Also:
+          max_cost(), argmin(), min_cost_sets(), min_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.min_cost(Universe.e_objtable, weights)
+
+    def max_cost(self, weights=None):
+        """Returns the maximum total weight of graphs in `self`.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          The maximum weight, or float('-inf') if `self` is empty.
+
+        See Also:
+          min_cost(), argmax(), max_cost_sets(), max_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.max_cost(Universe.e_objtable, weights)
+
+    def argmin(self, weights=None):
+        """Returns a graph of the minimum total weight in `self`.
+
+        If several graphs have the minimum weight, one of them is
+        returned.
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = GraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.argmin(weights)
+          [(1, 2), (1, 4)]
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A graph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmax(), min_cost(), min_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return GraphSet._conv_ret(self._ss.argmin(Universe.e_objtable, weights))
+
+    def argmax(self, weights=None):
+        """Returns a graph of the maximum total weight in `self`.
+
+        If several graphs have the maximum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A graph.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmin(), max_cost(), max_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return GraphSet._conv_ret(self._ss.argmax(Universe.e_objtable, weights))
+
+    def min_cost_sets(self, weights=None):
+        """Returns a new GraphSet with all graphs of the minimum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A new GraphSet object.
+
+        See Also:
+          max_cost_sets(), min_cost(), argmin()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return GraphSet(self._ss.min_cost_sets(Universe.e_objtable, weights))
+
+    def max_cost_sets(self, weights=None):
+        """Returns a new GraphSet with all graphs of the maximum total weight.
+
+        Examples:
+          >>> graph1 = [(1, 2), (1, 4)]
+          >>> graph2 = [(2, 3)]
+          >>> gs = GraphSet([graph1, graph2])
+          >>> weights = {(1, 2): 2.0, (1, 4): -3.0}  # (2, 3): 1.0
+          >>> gs.max_cost_sets(weights)
+          GraphSet([[(2, 3)]])
+
+        Args:
+          weights: Optional.  A dictionary of edges to the weight
+            values.
+
+        Returns:
+          A new GraphSet object.
+
+        See Also:
+          min_cost_sets(), max_cost(), argmax()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return GraphSet(self._ss.max_cost_sets(Universe.e_objtable, weights))
+
     def __contains__(self, obj):
         """Returns True if `obj` is in the `self`, False otherwise.
         When `obj` is a graph (list of edges), returns True if the graph is in the `self`.
@@ -1156,6 +1305,59 @@ class GraphSet(object):
         """
         return GraphSet(self._ss.set_size(size))
 
+    def graph_size_between(self, lower, upper):
+        """Returns a new GraphSet with graphs that have `lower` to `upper` edges.
+
+        This method returns a new GraphSet with graphs whose number
+        of edges is between `lower` and `upper` inclusive.  It
+        traverses the diagram once, instead of combining smaller() and
+        larger().
+
+        Examples:
+          >>> graph1 = [(1, 2)]
+          >>> graph2 = [(1, 2), (1, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (2, 3)]
+          >>> gs = GraphSet([graph1, graph2, graph3])
+          >>> gs.graph_size_between(1, 2)
+          GraphSet([[(1, 2)], [(1, 2), (1, 4)]])
+
+        Args:
+          lower: The lower limit of the number of edges in a graph.
+          upper: The upper limit of the number of edges in a graph.
+
+        Returns:
+          A new GraphSet object.
+
+        See Also:
+          graph_size(), smaller(), larger()
+
+        """
+        return GraphSet(self._ss.size_between(lower, upper))
+
+    def graph_size_distribution(self):
+        """Returns the number of graphs in `self` for each number of edges.
+
+        The counts for all sizes are computed in a single pass over the
+        diagram.
+
+        Examples:
+          >>> graph1 = [(1, 2)]
+          >>> graph2 = [(1, 2), (1, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (2, 3)]
+          >>> gs = GraphSet([graph1, graph2, graph3])
+          >>> gs.graph_size_distribution()
+          {1: 1, 2: 1, 3: 1}
+
+        Returns:
+          A dictionary mapping each number of edges to the number
+          of graphs of that size.
+
+        See Also:
+          graph_size(), len()
+
+        """
+        return self._ss.size_dist()
+
     def complement(self):
         """Returns a new GraphSet with complement graphs of `self`.
 
@@ -1521,10 +1723,17 @@ class GraphSet(object):
           >>> cost_bound = 7
           >>> print(gs.cost_le(costs, cost_bound))
           GraphSet([[(3, 4)], [(1, 2), (2, 3)]])
+          >>> costs = {(1, 2): (2, 1), (1, 4): (3, 1), (2, 3): (1, 1), (3, 4): (7, 1)}
+          >>> print(gs.cost_le(costs, (7, 1)))
+          GraphSet([[(3, 4)]])
 
         Args:
-          costs: A dictionary of the cost of each edge.
+          costs: A dictionary of the cost of each edge.  For multiple
+            cost criteria, the cost of each edge is a sequence of
+            costs, one per criterion.
           cost_bound: The upper limit of the cost of each graph. 32 bit signed integer.
+            For multiple cost criteria, a sequence of upper limits;
+            graphs satisfying all of them are selected in a single pass.
 
         Returns:
           A new GraphSet object.
@@ -1606,9 +1815,121 @@ class GraphSet(object):
           TypeError: If at least one cost is not integer.
 
         """
-        le_ss = self._ss.cost_le(objtable=Universe.e_objtable, costs=costs, cost_bound=cost_bound)
-        lt_ss = self._ss.cost_le(objtable=Universe.e_objtable, costs=costs, cost_bound=cost_bound - 1)
-        return GraphSet(le_ss.difference(lt_ss))
+        return GraphSet(self._ss.cost_between(objtable=Universe.e_objtable, costs=costs, lower=cost_bound, upper=cost_bound))
+
+    def cost_between(self, costs, lower, upper):
+        """Returns a new GraphSet with subgraphs whose cost is between the lower and upper bounds.
+
+        This method constructs a GraphSet of subgraphs
+        whose cost is greater than or equal to `lower` and
+        less than or equal to `upper`, where `costs` of each edge
+        are given as an argument.  The subgraphs are selected in a single
+        pass over the diagram.
+
+        Examples:
+          >>> universe = [(1, 2), (1, 4), (2, 3), (3, 4)]
+          >>> GraphSet.set_universe(universe)
+
+          >>> graph1 = [(1, 2), (2, 3)]
+          >>> graph2 = [(3, 4)]
+          >>> graph3 = [(1, 2), (1, 4), (3, 4)]
+          >>> gs = GraphSet([graph1, graph2, graph3])
+          >>> costs = {(1, 2): 2, (1, 4): 3, (2, 3): 1, (3, 4): 7}
+          >>> print(gs.cost_between(costs, 3, 7))
+          GraphSet([[(3, 4)], [(1, 2), (2, 3)]])
+
+        Args:
+          costs: A dictionary of the cost of each edge.
+          lower: The lower limit of the cost of each graph. 32 bit signed integer.
+          upper: The upper limit of the cost of each graph. 32 bit signed integer.
+
+        Returns:
+          A new GraphSet object.
+
+        Raises:
+          KeyError: If a given edge is not found in the universe.
+          AssertionError: If the cost of at least one edge is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        """
+        return GraphSet(self._ss.cost_between(objtable=Universe.e_objtable, costs=costs, lower=lower, upper=upper))
+
+    def cost_distribution(self, costs, probabilities=None, max_cost=None):
+        """Returns the number of graphs in `self` for each total cost.
+
+        This method computes, in a single pass over the diagram, how
+        many graphs have each total cost given `costs` of each edge.
+        If `probabilities` of each edge are given, the probability
+        of occurrence of the graphs having each total cost is returned
+        instead of the number.
+
+        Examples:
+          >>> GraphSet.set_universe([(1, 2), (1, 4), (2, 3)])
+          >>> gs = GraphSet([[(1, 2), (1, 4)], [(2, 3)], [(1, 4), (2, 3)]])
+          >>> costs = {(1, 2): 2, (1, 4): 3, (2, 3): 2}
+          >>> gs.cost_distribution(costs)
+          {2: 1, 5: 2}
+
+        Args:
+          costs: A dictionary of the cost of each edge.
+          probabilities: Optional.  A dictionary of the probability of each edge.
+          max_cost: Optional.  Costs larger than `max_cost` are omitted,
+            which also saves work if no cost is negative.
+
+        Returns:
+          A dictionary mapping each total cost to the number (or the
+          probability) of graphs of that cost.
+
+        Raises:
+          KeyError: If a given edge is not found in the universe.
+          AssertionError: If the cost of at least one edge is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        See Also:
+          cost_le(), probability()
+        """
+        return self._ss.cost_dist(objtable=Universe.e_objtable, costs=costs, probabilities=probabilities, max_cost=max_cost)
+
+    @staticmethod
+    def cost_context(costs):
+        """Returns a context for cost queries that share `costs`.
+
+        The context keeps the results computed for each node of the
+        diagrams between its queries, so sweeping the cost bound over
+        the same (or an overlapping) GraphSet does not start from
+        scratch each time, as cost_le() does.  The results are dropped
+        after a garbage collection, and those of le(), between(), and
+        dist() also when the universe grows.  A context must not be
+        used from more than one thread at a time.
+
+        Examples:
+          >>> GraphSet.set_universe([(1, 2), (1, 4), (2, 3)])
+          >>> gs = GraphSet([[(1, 2), (1, 4)], [(2, 3)], [(1, 4), (2, 3)]])
+          >>> ctx = GraphSet.cost_context({(1, 2): 2, (1, 4): 3, (2, 3): 2})
+          >>> [len(ctx.le(gs, b)) for b in range(6)]
+          [0, 0, 1, 1, 1, 3]
+
+        Args:
+          costs: A dictionary of the cost of each edge.
+
+        Returns:
+          A context with methods le(gs, cost_bound), between(gs, lower,
+          upper), and dist(gs, max_cost=None), which return the same as
+          gs.cost_le(costs, cost_bound), gs.cost_between(costs, lower,
+          upper), and gs.cost_distribution(costs, max_cost=max_cost).
+          It also has min_cost(gs), max_cost(gs), argmin(gs),
+          argmax(gs), min_cost_sets(gs), and max_cost_sets(gs), which
+          take `costs` as the weights of gs.min_cost(weights) and so on.
+
+        Raises:
+          KeyError: If a given edge is not found in the universe.
+          AssertionError: If the cost of at least one edge is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        See Also:
+          cost_le(), cost_between(), cost_distribution(), min_cost()
+        """
+        return _GraphSetCostContext(costs)
 
     def remove_some_edge(self):
         """Returns a new GraphSet with graphs that are obtained by removing some edge from a graph in `self`.
@@ -1815,8 +2136,14 @@ class GraphSet(object):
             The default is 'greedy', best-first search from `source`
             with respect to the number of unused incident edges.
             Other options include 'bfs', the breadth-first search, 
-            'dfs', the depth-first search, and 'as-is', the order of
-            `universe` list.
+            'dfs', the depth-first search, 'frontier', which searches
+            for an order keeping the largest frontier of the
+            frontier-based search small, 'frontier-sum', which keeps
+            the total of the frontiers small instead, and 'as-is', the
+            order of `universe` list.  The 'frontier' traversals start
+            from the 'greedy' order and spend a fixed amount of search,
+            so they give the same order on every run unless cut off by
+            `Universe.frontier_time_limit` seconds (1.0 by default).
 
           source: Optional.  This argument specifies the starting
             point of the edge traversal.
@@ -1913,6 +2240,88 @@ class GraphSet(object):
           cycles(), paths()
 
         """
+        args = GraphSet._graphs_args(vertex_groups, degree_constraints,
+                                     num_edges, no_loop, linear_constraints)
+        ss = None if graphset is None else graphset._ss
+        ss = _graphillion._graphs(search_space=ss, **args)
+        return GraphSet(ss)
+
+    @staticmethod
+    def estimate_graphs(vertex_groups=None, degree_constraints=None,
+                        num_edges=None, no_loop=False,
+                        linear_constraints=None, sample_size=1000, seed=1):
+        """Estimates the size of the decision diagram built by graphs().
+
+        The diagram is built top-down, but at most `sample_size` nodes
+        chosen at random are expanded at each level, and the nodes
+        never built are estimated from the merges among those built.
+        The estimate is exact for levels not wider than `sample_size`
+        and tends to be low beyond that.  It helps to decide whether
+        graphs() fits in memory, or which universe order to use.
+
+        Examples:
+          >>> est = GraphSet.estimate_graphs(vertex_groups=[[1, 6]],
+          ...                                degree_constraints={1: 1, 6: 1})
+          >>> est['nodes']
+          18.0
+
+        Args:
+          vertex_groups, degree_constraints, num_edges, no_loop,
+            linear_constraints: Optional.  The same as graphs().
+
+          sample_size: Optional.  The maximum number of nodes expanded
+            at a level.
+
+          seed: Optional.  The seed of the sampling.
+
+        Returns:
+          A dict with 'width', a list of the estimated numbers of
+          nodes for the edges in the universe order, 'nodes', their
+          total, 'bytes', the estimated memory usage, and
+          'sampled_nodes', the number of nodes expanded.
+
+        See Also:
+          graphs(), estimate_partitions()
+        """
+        args = GraphSet._graphs_args(vertex_groups, degree_constraints,
+                                     num_edges, no_loop, linear_constraints)
+        return _graphillion._graphs(estimate=sample_size, seed=seed, **args)
+
+    @staticmethod
+    def count_graphs(vertex_groups=None, degree_constraints=None,
+                     num_edges=None, no_loop=False, graphset=None,
+                     linear_constraints=None):
+        """Returns the number of graphs that graphs() would return.
+
+        The graphs are counted level by level with multiple threads,
+        without building the decision diagram; only the states of
+        the current and the pending levels are kept in memory.  It
+        is useful when only len(GraphSet.graphs(...)) is needed.
+
+        Examples:
+          >>> GraphSet.count_graphs(vertex_groups=[[1, 6]],
+          ...                       degree_constraints={1: 1, 6: 1})
+          11
+
+        Args:
+          vertex_groups, degree_constraints, num_edges, no_loop,
+            graphset, linear_constraints: Optional.  The same as
+            graphs().
+
+        Returns:
+          The number of graphs.
+
+        See Also:
+          graphs(), estimate_graphs()
+        """
+        args = GraphSet._graphs_args(vertex_groups, degree_constraints,
+                                     num_edges, no_loop, linear_constraints)
+        ss = None if graphset is None else graphset._ss
+        return _graphillion._graphs(search_space=ss, count=True, **args)
+
+    @staticmethod
+    def _graphs_args(vertex_groups, degree_constraints, num_edges, no_loop,
+                     linear_constraints):
         graph = []
         for e in Universe.e_objtable.universe():
             assert e[0] in Universe.vertices and e[1] in Universe.vertices
@@ -1955,8 +2364,6 @@ class GraphSet(object):
                 ne = (num_edges[0], num_edges[-1] + 1,
                       num_edges[1] - num_edges[0])
 
-        ss = None if graphset is None else graphset._ss
-
         lc = None
         if linear_constraints is not None:
             lc = []
@@ -1971,12 +2378,10 @@ class GraphSet(object):
                 max = float(c[1][1])
                 lc.append((expr, (min, max)))
 
-        ss = _graphillion._graphs(graph=graph, vertex_groups=vg,
-                                  degree_constraints=dc, num_edges=ne,
-                                  num_comps=nc, no_loop=no_loop,
-                                  search_space=ss,
-                                  linear_constraints=lc)
-        return GraphSet(ss)
+        return {'graph': graph, 'vertex_groups': vg,
+                'degree_constraints': dc, 'num_edges': ne,
+                'num_comps': nc, 'no_loop': no_loop,
+                'linear_constraints': lc}
 
     @staticmethod
     def connected_components(vertices, graphset=None):
@@ -2714,6 +3119,61 @@ class GraphSet(object):
           graph=graph, num_comp_lb=num_comp_lb, num_comp_ub=num_comp_ub)
         return GraphSet(ss)
 
+    @staticmethod
+    def estimate_partitions(num_comp_lb=1, num_comp_ub=32767,
+                            sample_size=1000, seed=1):
+        """Estimates the size of the decision diagram built by partitions().
+
+        Args:
+          num_comp_lb, num_comp_ub: Optional.  The same as partitions().
+
+          sample_size: Optional.  The maximum number of nodes expanded
+            at a level.
+
+          seed: Optional.  The seed of the sampling.
+
+        Returns:
+          A dict like estimate_graphs().
+
+        See Also:
+          partitions(), estimate_graphs()
+        """
+        graph = []
+        for e in Universe.e_objtable.universe():
+            assert e[0] in Universe.vertices and e[1] in Universe.vertices
+            graph.append(
+              (pickle.dumps(e[0], protocol=0), pickle.dumps(e[1], protocol=0)))
+
+        return _graphillion._partitions(
+          graph=graph, num_comp_lb=num_comp_lb, num_comp_ub=num_comp_ub,
+          estimate=sample_size, seed=seed)
+
+    @staticmethod
+    def count_partitions(num_comp_lb=1, num_comp_ub=32767):
+        """Returns the number of partitions that partitions() would return.
+
+        The partitions are counted without building the decision
+        diagram; see count_graphs().
+
+        Args:
+          num_comp_lb, num_comp_ub: Optional.  The same as partitions().
+
+        Returns:
+          The number of partitions.
+
+        See Also:
+          partitions(), count_graphs()
+        """
+        graph = []
+        for e in Universe.e_objtable.universe():
+            assert e[0] in Universe.vertices and e[1] in Universe.vertices
+            graph.append(
+              (pickle.dumps(e[0], protocol=0), pickle.dumps(e[1], protocol=0)))
+
+        return _graphillion._partitions(
+          graph=graph, num_comp_lb=num_comp_lb, num_comp_ub=num_comp_ub,
+          count=True)
+
     @staticmethod
     def balanced_partitions(weight_list=None, ratio=0.0, lower=0, upper=4294967295 // 4, num_comps=-1):
         """Returns a GraphSet with balanced partitions of the graph.
@@ -2779,6 +3239,27 @@ class GraphSet(object):
         ss = _graphillion._induced_graphs(graph=graph)
         return GraphSet(ss)
 
+    @staticmethod
+    def count_induced_graphs():
+        """Returns the number of graphs that induced_graphs() would return.
+
+        The graphs are counted without building the decision diagram;
+        see count_graphs().
+
+        Returns:
+          The number of connected induced graphs.
+
+        See Also:
+          induced_graphs(), count_graphs()
+        """
+        graph = []
+        for e in Universe.e_objtable.universe():
+            assert e[0] in Universe.vertices and e[1] in Universe.vertices
+            graph.append(
+                (pickle.dumps(e[0], protocol=0), pickle.dumps(e[1], protocol=0)))
+
+        return _graphillion._induced_graphs(graph=graph, count=True)
+
     @staticmethod
     def weighted_induced_graphs(weight_list=None, lower=0, upper=4294967295//2):
         """Return a GraphSet with weighted connected induced graphs.
@@ -2903,6 +3384,141 @@ class GraphSet(object):
         """
         return _graphillion._show_messages(flag)
 
+    @staticmethod
+    def spill_budget(nbytes):
+        """Sets the memory budget for pending search states.
+
+        Graph searches keep the states waiting at lower levels of the
+        decision diagram in memory.  Beyond the budget, whole levels
+        are moved to temporary files and read back when they are
+        processed, which trades time for memory on large graphs.
+        Searches do not use multiple threads while a budget is set.
+
+        Args:
+          nbytes: int.  The budget in bytes.  0 means unlimited
+          (initial setting).
+
+        Returns:
+          The budget before the method call.
+        """
+        return _graphillion._spill_budget(nbytes)
+
+    @staticmethod
+    def pack_states(flag=True):
+        """Packs pending search states in memory.
+
+        Graph searches keep the states waiting at lower levels of the
+        decision diagram in memory.  If enabled, each waiting state is
+        stored as the bytes that differ from the state stored before it
+        on the same level, and a level is unpacked when it is
+        processed.  States of a level that share most of their entries,
+        as in partition searches on large graphs, take a fraction of
+        their memory.  Packed levels are spilled before the others when
+        spill_budget() is set.  Searches do not use multiple threads
+        while packing is enabled.
+
+        Args:
+          flag: Optional.  True or False.  If True, pending states are
+          packed.  If False, they are not (initial setting).
+
+        Returns:
+          The setting before the method call.
+        """
+        return _graphillion._pack_states(flag)
+
+    @staticmethod
+    def cache_dir(path):
+        """Sets the directory to cache graph sets in.
+
+        If set, the decision diagrams built by graphs() and
+        partitions() are saved in files of the directory, named by a
+        hash of the universe, the edge order and the constraints.  A
+        later call with the same arguments, even in another process,
+        loads the file instead of searching again.  Searches within
+        graphset are not cached.  Files are never removed; delete them
+        to free the disk space.
+
+        Args:
+          path: str.  An existing directory, or '' to disable the cache
+          (initial setting).
+
+        Returns:
+          The directory before the method call.
+        """
+        return _graphillion._cache_dir(path)
+
+    @staticmethod
+    def build_control(max_nodes=0, max_bytes=0, time_limit=0, progress=None):
+        """Limits and monitors the construction of graph sets.
+
+        The settings apply to the searches that build graph sets, such
+        as graphs(), paths() and the other constructors.  They are
+        checked between the levels of each decision diagram, and a
+        search exceeding them stops and releases its memory.
+
+        Examples:
+          >>> def report(level, nodes, nbytes, elapsed):
+          ...     print(level, nodes, nbytes, elapsed)
+          >>> old = GraphSet.build_control(max_nodes=10**7, time_limit=60,
+          ...                              progress=report)
+          >>> gs = GraphSet.paths(1, 64)
+          >>> GraphSet.build_control(**old)
+
+        Args:
+          max_nodes: int.  The maximum number of nodes of a decision
+            diagram; MemoryError is raised beyond it.  0 means unlimited.
+
+          max_bytes: int.  The maximum memory in bytes of a decision
+            diagram and the search states waiting for it; MemoryError
+            is raised beyond it.  0 means unlimited.
+
+          time_limit: float.  The maximum seconds of a search;
+            TimeoutError is raised beyond it.  0 means unlimited.
+
+          progress: A function called with the level, the number of
+            nodes, the memory in bytes and the elapsed seconds after
+            each level.  Returning False cancels the search with
+            RuntimeError, and an exception raised by the function is
+            passed through.  It must not build graph sets.
+
+        Returns:
+          A dictionary of the settings before the method call.
+        """
+        return _graphillion._build_control(max_nodes, max_bytes, time_limit,
+                                           progress)
+
+    @staticmethod
+    def build_metrics(flag=True):
+        """Records statistics of the decision diagram operations.
+
+        While recording, each search that builds graph sets, such as
+        graphs() and paths(), records its construction, subsetting,
+        reduction and evaluation passes.  A record is a dictionary with
+        keys 'name', 'size' (nodes of the result), 'elapsed' (seconds),
+        'rss_delta' (growth of the maximum resident set in KB),
+        'aborted' and 'levels'.  Each level is a dictionary with keys
+        'level', 'nodes', 'merged' (states or nodes merged into
+        others), 'dead' (nodes whose children are all empty),
+        'load_factor' (of the unique table) and 'elapsed'.  Merged and
+        dead counts and load factors are not recorded by the
+        multi-threaded passes.
+
+        Examples:
+          >>> GraphSet.build_metrics(True)
+          []
+          >>> gs = GraphSet.paths(1, 64)
+          >>> records = GraphSet.build_metrics(False)
+          >>> [r['name'] for r in records]
+          ['DegreeConstraint', 'FrontierBasedSearch', 'reduction + ToZBDD']
+
+        Args:
+          flag: True or False.  Whether to record from now on.
+
+        Returns:
+          A list of the records since the previous method call.
+        """
+        return json.loads(_graphillion._build_metrics(flag))
+
     @staticmethod
     def omp_get_max_threads():
         """Returns the maximum number of threads for OpenMP.
@@ -2988,4 +3604,43 @@ class GraphSet(object):
 
     # _objtable = ObjectTable()
 
+
+class _GraphSetCostContext(object):
+    """Cost queries on GraphSets sharing one cost dictionary.
+
+    See GraphSet.cost_context().
+    """
+
+    def __init__(self, costs):
+        self._objtable = Universe.e_objtable
+        self._ctx = setset_base.cost_context(self._objtable, costs)
+
+    def le(self, gs, cost_bound):
+        return GraphSet(self._ctx.le(gs._ss, cost_bound))
+
+    def between(self, gs, lower, upper):
+        return GraphSet(self._ctx.between(gs._ss, lower, upper))
+
+    def dist(self, gs, max_cost=None):
+        return self._ctx.dist(gs._ss, max_cost)
+
+    def min_cost(self, gs):
+        return self._ctx.min_cost(gs._ss)
+
+    def max_cost(self, gs):
+        return self._ctx.max_cost(gs._ss)
+
+    def argmin(self, gs):
+        return GraphSet._conv_ret(self._objtable.conv_ret(self._ctx.argmin(gs._ss)))
+
+    def argmax(self, gs):
+        return GraphSet._conv_ret(self._objtable.conv_ret(self._ctx.argmax(gs._ss)))
+
+    def min_cost_sets(self, gs):
+        return GraphSet(self._ctx.min_cost_sets(gs._ss))
+
+    def max_cost_sets(self, gs):
+        return GraphSet(self._ctx.max_cost_sets(gs._ss))
+
+
 EdgeSetSet = GraphSet
@@ -96,6 +96,24 @@ class setset(setset_base):
     def max_iter(self, weights=None, default=1):
         return setset_base.max_iter(self, setset._objtable, weights, default)
 
+    def min_cost(self, weights=None, default=1):
+        return setset_base.min_cost(self, setset._objtable, weights, default)
+
+    def max_cost(self, weights=None, default=1):
+        return setset_base.max_cost(self, setset._objtable, weights, default)
+
+    def argmin(self, weights=None, default=1):
+        return setset_base.argmin(self, setset._objtable, weights, default)
+
+    def argmax(self, weights=None, default=1):
+        return setset_base.argmax(self, setset._objtable, weights, default)
+
+    def min_cost_sets(self, weights=None, default=1):
+        return setset_base.min_cost_sets(self, setset._objtable, weights, default)
+
+    def max_cost_sets(self, weights=None, default=1):
+        return setset_base.max_cost_sets(self, setset._objtable, weights, default)
+
     def supersets(self, obj):
         return setset_base.supersets(self, setset._objtable, obj)
 
@@ -111,6 +129,12 @@ class setset(setset_base):
     def cost_le(self, costs, cost_bound):
         return setset_base.cost_le(self, setset._objtable, costs, cost_bound)
 
+    def cost_between(self, costs, lower, upper):
+        return setset_base.cost_between(self, setset._objtable, costs, lower, upper)
+
+    def cost_dist(self, costs, probabilities=None, max_cost=None):
+        return setset_base.cost_dist(self, setset._objtable, costs, probabilities, max_cost)
+
     def add_some_element(self):
         return setset_base.add_some_element(self, setset._objtable)
 
@@ -136,7 +136,28 @@ class setset_base(_graphillion.setset):
     def max_iter(self, objtable, weights=None, default=1):
         return self._optimize(objtable, weights, default, _graphillion.setset.max_iter)
 
-    def _optimize(self, objtable, weights, default, generator):
+    def min_cost(self, objtable, weights=None, default=1):
+        return _graphillion.setset.min_cost(self, setset_base._conv_weights(objtable, weights, default))
+
+    def max_cost(self, objtable, weights=None, default=1):
+        return _graphillion.setset.max_cost(self, setset_base._conv_weights(objtable, weights, default))
+
+    def argmin(self, objtable, weights=None, default=1):
+        s = _graphillion.setset.argmin(self, setset_base._conv_weights(objtable, weights, default))
+        return objtable.conv_ret(s)
+
+    def argmax(self, objtable, weights=None, default=1):
+        s = _graphillion.setset.argmax(self, setset_base._conv_weights(objtable, weights, default))
+        return objtable.conv_ret(s)
+
+    def min_cost_sets(self, objtable, weights=None, default=1):
+        return _graphillion.setset.min_cost_sets(self, setset_base._conv_weights(objtable, weights, default))
+
+    def max_cost_sets(self, objtable, weights=None, default=1):
+        return _graphillion.setset.max_cost_sets(self, setset_base._conv_weights(objtable, weights, default))
+
+    @staticmethod
+    def _conv_weights(objtable, weights, default):
         ws = [default] * (objtable.num_elems() + 1)
         if weights:
             universe = objtable.universe()
@@ -144,6 +165,10 @@ class setset_base(_graphillion.setset):
                 if e in universe:
                     i = objtable.obj2int[e]
                     ws[i] = w
+        return ws
+
+    def _optimize(self, objtable, weights, default, generator):
+        ws = setset_base._conv_weights(objtable, weights, default)
         i = generator(self, ws)
         while (True):
             try:
@@ -174,6 +199,42 @@ class setset_base(_graphillion.setset):
         return _graphillion.setset.probability(self, objtable.num_elems(), ps)
 
     def cost_le(self, objtable, costs, cost_bound):
+        if isinstance(cost_bound, (list, tuple)):
+            # multi-dimensional costs: each cost is a sequence of len(cost_bound)
+            dim = len(cost_bound)
+            cs = [[-1] * (objtable.num_elems() + 1) for _ in range(dim)]
+            for e, c in costs.items():
+                i = objtable.obj2int[e]
+                assert len(c) == dim
+                for d in range(dim):
+                    cs[d][i] = c[d]
+            for d in range(dim):
+                assert len([c for c in cs[d][1:] if c < -(1 << 31) or (1 << 31) <= c]) == 0
+            return _graphillion.setset.cost_le(self, costs=[c[1:] for c in cs], cost_bound=list(cost_bound))
+        cs = setset_base._conv_costs(objtable, costs)
+        return _graphillion.setset.cost_le(self, costs=cs, cost_bound=cost_bound)
+
+    def cost_between(self, objtable, costs, lower, upper):
+        cs = setset_base._conv_costs(objtable, costs)
+        return _graphillion.setset.cost_between(self, costs=cs, lower=lower, upper=upper)
+
+    def cost_dist(self, objtable, costs, probabilities=None, max_cost=None):
+        cs = setset_base._conv_costs(objtable, costs)
+        if probabilities is None:
+            return _graphillion.setset.cost_dist(self, costs=cs, max_cost=max_cost)
+        ps = [-1] * (objtable.num_elems() + 1)
+        for e, p in probabilities.items():
+            i = objtable.obj2int[e]
+            ps[i] = p
+        assert len([p for p in ps[1:] if p < 0 or 1 < p]) == 0
+        return _graphillion.setset.cost_dist(self, costs=cs, probabilities=ps, max_cost=max_cost)
+
+    @staticmethod
+    def cost_context(objtable, costs):
+        return _graphillion.cost_context(setset_base._conv_costs(objtable, costs))
+
+    @staticmethod
+    def _conv_costs(objtable, costs):
         cs = [-1] * (objtable.num_elems() + 1)
         for e, c in costs.items():
             i = objtable.obj2int[e]
@@ -181,7 +242,7 @@ class setset_base(_graphillion.setset):
         # Each cost must be in the range of 32 bit signed integer
         # due to the implementation of BDDCT class of SAPPOROBDD.
         assert len([c for c in cs[1:] if c < -(1 << 31) or (1 << 31) <= c]) == 0
-        return _graphillion.setset.cost_le(self, costs=cs[1:], cost_bound=cost_bound)
+        return cs[1:]
 
     def add_some_element(self, objtable):
         return _graphillion.setset.add_some_element(self, objtable.num_elems())
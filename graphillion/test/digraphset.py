@@ -983,6 +983,34 @@ class TestDiGraphSet(unittest.TestCase):
 
         self.assertTrue(trees.issubset(gs))
 
+    def test_count(self):
+        DiGraphSet.set_universe(universe_edges)
+
+        self.assertEqual(DiGraphSet.count_directed_cycles(),
+                         len(DiGraphSet.directed_cycles()))
+        self.assertEqual(DiGraphSet.count_directed_hamiltonian_cycles(), 2)
+        self.assertEqual(DiGraphSet.count_directed_st_paths(1, 6),
+                         len(DiGraphSet.directed_st_paths(1, 6)))
+        self.assertEqual(DiGraphSet.count_directed_st_paths(1, 6, True),
+                         len(DiGraphSet.directed_st_paths(1, 6, True)))
+        self.assertEqual(DiGraphSet.count_rooted_forests([1, 6]),
+                         len(DiGraphSet.rooted_forests([1, 6])))
+        self.assertEqual(DiGraphSet.count_rooted_trees(1, True),
+                         len(DiGraphSet.rooted_trees(1, True)))
+        self.assertEqual(DiGraphSet.count_graphs(), 2**len(universe_edges))
+
+        in_dc = {}
+        out_dc = {}
+        for v in DiGraphSet._vertices:
+            in_dc[v] = out_dc[v] = range(1, 2)
+        self.assertEqual(DiGraphSet.count_graphs(in_degree_constraints=in_dc,
+                                                 out_degree_constraints=out_dc),
+                         9)
+
+        cycles = DiGraphSet.directed_cycles()
+        self.assertEqual(DiGraphSet.count_rooted_trees(1, graphset=cycles),
+                         len(DiGraphSet.rooted_trees(1, graphset=cycles)))
+
     def test_with_graphset(self):
         graphillion_universe = [f1, f2, f3, f4, f5, f6, f7]
         GraphSet.set_universe(graphillion_universe)
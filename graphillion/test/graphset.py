@@ -20,6 +20,8 @@
 from builtins import range
 from graphillion.universe import Universe
 from graphillion import GraphSet
+import os
+import shutil
 import tempfile
 import unittest
 
@@ -47,6 +49,17 @@ g234 = [e2, e3, e4]
 g1234 = [e1, e2, e3, e4]
 
 
+def _grid(n):
+    """Returns the edges of an n x n grid graph of vertices 1 to n * n."""
+    edges = []
+    for v in range(1, n * n + 1):
+        if v % n != 0:
+            edges.append((v, v + 1))
+        if v <= (n - 1) * n:
+            edges.append((v, v + n))
+    return edges
+
+
 class TestGraphSet(unittest.TestCase):
 
     def setUp(self):
@@ -83,6 +96,132 @@ class TestGraphSet(unittest.TestCase):
         GraphSet.set_universe([(1,2), (3,4)])  # disconnected graph
         self.assertEqual(GraphSet.universe(), [(1,2), (3,4)])
 
+    def test_estimate_graphs(self):
+        n = 5
+        grid = _grid(n)
+        GraphSet.set_universe(grid)
+
+        GraphSet.build_metrics()
+        GraphSet.graphs(vertex_groups=[[1, n * n]])
+        search = GraphSet.build_metrics(False)[0]
+        est = GraphSet.estimate_graphs(vertex_groups=[[1, n * n]],
+                                       sample_size=search['size'])
+        self.assertEqual(est['nodes'], search['size'])
+        self.assertEqual(est['width'],
+                         [l['nodes'] for l in search['levels']])
+        self.assertTrue(est['bytes'] > est['nodes'])
+
+        est = GraphSet.estimate_graphs(vertex_groups=[[1, n * n]],
+                                       sample_size=10)
+        self.assertEqual(len(est['width']), len(grid))
+        self.assertTrue(0 < est['nodes'] < search['size'] * 10)
+        self.assertEqual(est, GraphSet.estimate_graphs(
+            vertex_groups=[[1, n * n]], sample_size=10))
+
+        est = GraphSet.estimate_partitions(num_comp_lb=2, num_comp_ub=3)
+        self.assertEqual(len(est['width']), len(grid))
+        self.assertTrue(est['nodes'] > 0)
+
+    def test_count_graphs(self):
+        n = 5
+        grid = _grid(n)
+        GraphSet.set_universe(grid)
+
+        dc = dict((v, range(0, 3, 2)) for v in range(2, n * n))
+        dc[1] = dc[n * n] = 1
+        paths = GraphSet.graphs(vertex_groups=[[1, n * n]],
+                                degree_constraints=dc, no_loop=True)
+        self.assertEqual(GraphSet.count_graphs(vertex_groups=[[1, n * n]],
+                                               degree_constraints=dc,
+                                               no_loop=True), len(paths))
+        self.assertEqual(GraphSet.count_graphs(vertex_groups=[[1, n * n]],
+                                               degree_constraints=dc,
+                                               num_edges=range(8, 11),
+                                               no_loop=True),
+                         len(paths.smaller(11)))
+        space = GraphSet.graphs(num_edges=range(10))
+        self.assertEqual(GraphSet.count_graphs(vertex_groups=[[1, n * n]],
+                                               degree_constraints=dc,
+                                               no_loop=True, graphset=space),
+                         len(paths & space))
+        self.assertEqual(GraphSet.count_graphs(), 2**len(grid))
+
+        self.assertEqual(GraphSet.count_partitions(num_comp_lb=2,
+                                                   num_comp_ub=3),
+                         len(GraphSet.partitions(num_comp_lb=2,
+                                                 num_comp_ub=3)))
+        self.assertEqual(GraphSet.count_induced_graphs(),
+                         len(GraphSet.induced_graphs()))
+
+    def test_pack_states(self):
+        n = 5
+        grid = _grid(n)
+        GraphSet.set_universe(grid)
+
+        dc = dict((v, range(0, 3, 2)) for v in range(2, n * n))
+        dc[1] = dc[n * n] = 1
+        paths = GraphSet.graphs(vertex_groups=[[1, n * n]],
+                                degree_constraints=dc, no_loop=True)
+        partitions = GraphSet.partitions(num_comp_lb=2, num_comp_ub=3)
+
+        self.assertFalse(GraphSet.pack_states(True))
+        try:
+            self.assertEqual(GraphSet.graphs(vertex_groups=[[1, n * n]],
+                                             degree_constraints=dc,
+                                             no_loop=True), paths)
+            self.assertEqual(GraphSet.partitions(num_comp_lb=2,
+                                                 num_comp_ub=3), partitions)
+        finally:
+            self.assertTrue(GraphSet.pack_states(False))
+
+    def test_cache_dir(self):
+        n = 4
+        grid = _grid(n)
+        GraphSet.set_universe(grid)
+
+        dc = dict((v, range(0, 3, 2)) for v in range(2, n * n))
+        dc[1] = dc[n * n] = 1
+        paths = GraphSet.graphs(vertex_groups=[[1, n * n]],
+                                degree_constraints=dc, no_loop=True)
+        partitions = GraphSet.partitions(num_comp_lb=2, num_comp_ub=3)
+
+        d = tempfile.mkdtemp()
+        self.assertEqual(GraphSet.cache_dir(d), '')
+        try:
+            for i in range(2):
+                self.assertEqual(GraphSet.graphs(vertex_groups=[[1, n * n]],
+                                                 degree_constraints=dc,
+                                                 no_loop=True), paths)
+                self.assertEqual(GraphSet.partitions(num_comp_lb=2,
+                                                     num_comp_ub=3),
+                                 partitions)
+                self.assertEqual(len(os.listdir(d)), 2)
+            self.assertEqual(GraphSet.graphs(num_edges=range(3)),
+                             GraphSet.graphs(num_edges=range(3)))
+            self.assertEqual(len(os.listdir(d)), 3)
+        finally:
+            self.assertEqual(GraphSet.cache_dir(''), d)
+            shutil.rmtree(d)
+
+    def test_frontier_traversal(self):
+        n = 5
+        grid = _grid(n)
+
+        GraphSet.set_universe(grid, traversal='greedy')
+        num_paths = len(GraphSet.paths(1, n * n))
+
+        for traversal in ['frontier', 'frontier-sum']:
+            GraphSet.set_universe(grid, traversal=traversal, source=1)
+            self.assertEqual(len(GraphSet.universe()), len(grid))
+            self.assertEqual(set(GraphSet.universe()), set(grid))
+            self.assertEqual(len(GraphSet.paths(1, n * n)), num_paths)
+
+        GraphSet.set_universe([(1,2), (3,4)], traversal='frontier')
+        self.assertEqual(set(GraphSet.universe()), set([(1,2), (3,4)]))
+
+        self.assertRaises(ValueError, GraphSet.set_universe, grid,
+                          traversal='unknown')
+
     def test_constructors(self):
         gs = GraphSet()
         self.assertTrue(isinstance(gs, GraphSet))
@@ -417,6 +556,48 @@ class TestGraphSet(unittest.TestCase):
         self.assertTrue(isinstance(c, int))
         GraphSet.omp_set_num_threads(a)
 
+    def test_build_control(self):
+        n = 6
+        GraphSet.set_universe(_grid(n))
+        gs = GraphSet.paths(1, n * n)
+
+        old = GraphSet.build_control(max_nodes=100)
+        self.assertEqual(old, {'max_nodes': 0, 'max_bytes': 0,
+                               'time_limit': 0, 'progress': None})
+        self.assertRaises(MemoryError, GraphSet.paths, 1, n * n)
+        GraphSet.build_control(max_bytes=1000)
+        self.assertRaises(MemoryError, GraphSet.paths, 1, n * n)
+
+        levels = []
+        def progress(level, nodes, nbytes, elapsed):
+            levels.append(level)
+        GraphSet.build_control(progress=progress)
+        self.assertEqual(GraphSet.paths(1, n * n), gs)
+        self.assertTrue(len(levels) >= len(GraphSet.universe()))
+
+        GraphSet.build_control(progress=lambda level, *args: level != 30)
+        self.assertRaises(RuntimeError, GraphSet.paths, 1, n * n)
+        def fail(*args):
+            raise ValueError()
+        GraphSet.build_control(progress=fail)
+        self.assertRaises(ValueError, GraphSet.paths, 1, n * n)
+
+        old = GraphSet.build_control(**old)
+        self.assertEqual(old['progress'], fail)
+        self.assertEqual(GraphSet.paths(1, n * n), gs)
+
+    def test_build_metrics(self):
+        GraphSet.build_metrics(True)
+        gs = GraphSet.paths(1, 4)
+        records = GraphSet.build_metrics(False)
+        self.assertTrue(records)
+        for r in records:
+            self.assertFalse(r['aborted'])
+            self.assertEqual(len(r['levels']), len(GraphSet.universe()))
+            self.assertEqual(sum(l['nodes'] for l in r['levels']), r['size'])
+        GraphSet.paths(1, 4)
+        self.assertEqual(GraphSet.build_metrics(False), [])
+
     def test_bicliques(self):
         GraphSet.set_universe([(1, 2), (1, 3), (1, 4), (2, 3), (2, 4), (3, 4)])
 
@@ -832,6 +1013,12 @@ class TestGraphSet(unittest.TestCase):
         self.assertEqual(gs.graph_size(3), GraphSet([g123, g134]))
         self.assertTrue(isinstance(gs.len(3), GraphSet))
         self.assertEqual(gs.len(3), GraphSet([g123, g134]))
+        self.assertTrue(isinstance(gs.graph_size_between(1, 2), GraphSet))
+        self.assertEqual(gs.graph_size_between(1, 2), GraphSet([g1, g12, g14, g4]))
+        self.assertEqual(gs.graph_size_between(0, 4), gs)
+        self.assertEqual(gs.graph_size_between(3, 2), GraphSet())
+        self.assertEqual(gs.graph_size_distribution(), {0: 1, 1: 2, 2: 2, 3: 2, 4: 1})
+        self.assertEqual(GraphSet().graph_size_distribution(), {})
 
         gs = GraphSet([g12, g123, g234])
         self.assertTrue(isinstance(gs.minimal(), GraphSet))
@@ -1249,6 +1436,126 @@ class TestGraphSet(unittest.TestCase):
         self.assertNotIn(g234, equal_cost_gs) # cost: 25
         self.assertNotIn(g1234, equal_cost_gs) # cost: 27
 
+    def test_cost_between(self):
+        GraphSet.set_universe([e1, e2, e3, e4])
+        gs = GraphSet([g0, g1, g2, g3, g4, g12, g14, g134, g234, g1234])
+
+        costs = {e1: 2, e2: 14, e3: 4, e4: 7}
+
+        mid_cost_gs = gs.cost_between(costs, 4, 14)
+        self.assertNotIn(g0, mid_cost_gs) # cost: 0
+        self.assertNotIn(g1, mid_cost_gs) # cost: 2
+        self.assertIn(g2, mid_cost_gs) # cost: 14
+        self.assertIn(g3, mid_cost_gs) # cost: 4
+        self.assertIn(g4, mid_cost_gs) # cost: 7
+        self.assertNotIn(g12, mid_cost_gs) # cost: 16
+        self.assertIn(g14, mid_cost_gs) # cost: 9
+        self.assertIn(g134, mid_cost_gs) # cost: 13
+        self.assertNotIn(g234, mid_cost_gs) # cost: 25
+        self.assertNotIn(g1234, mid_cost_gs) # cost: 27
+
+        self.assertEqual(gs.cost_between(costs, 0, 27), gs)
+        self.assertEqual(gs.cost_between(costs, 14, 4), GraphSet())
+        self.assertEqual(gs.cost_between(costs, 10, 25),
+                         gs.cost_le(costs, 25) - gs.cost_le(costs, 9))
+
+    def test_cost_context(self):
+        GraphSet.set_universe([e1, e2, e3, e4])
+        gs = GraphSet([g0, g1, g2, g3, g4, g12, g14, g134, g234, g1234])
+
+        costs = {e1: 2, e2: 14, e3: 4, e4: 7}
+        ctx = GraphSet.cost_context(costs)
+        for b in range(-1, 29):
+            self.assertEqual(ctx.le(gs, b), gs.cost_le(costs, b))
+            self.assertEqual(ctx.le(gs - GraphSet([g134]), b),
+                             gs.cost_le(costs, b) - GraphSet([g134]))
+        self.assertTrue(isinstance(ctx.le(gs, 13), GraphSet))
+        self.assertEqual(ctx.between(gs, 4, 14), gs.cost_between(costs, 4, 14))
+        self.assertEqual(ctx.dist(gs), gs.cost_distribution(costs))
+        self.assertEqual(ctx.dist(gs, 9), gs.cost_distribution(costs, max_cost=9))
+
+        self.assertEqual(ctx.min_cost(gs), gs.min_cost(costs))
+        self.assertEqual(ctx.max_cost(gs), 27)
+        self.assertEqual(ctx.max_cost(gs - GraphSet([g1234])), 25)
+        self.assertEqual(ctx.argmin(gs), gs.argmin(costs))
+        self.assertEqual(ctx.argmax(gs), gs.argmax(costs))
+        self.assertEqual(ctx.min_cost_sets(gs), gs.min_cost_sets(costs))
+        self.assertEqual(ctx.max_cost_sets(gs), GraphSet([g1234]))
+        self.assertRaises(KeyError, ctx.argmin, GraphSet())
+
+        self.assertRaises(KeyError, GraphSet.cost_context, {(5, 6): 1})
+        self.assertRaises(TypeError, ctx.le, gs, 1.5)
+
+    def test_cost_le_multi(self):
+        GraphSet.set_universe([e1, e2, e3, e4])
+        gs = GraphSet([g0, g1, g2, g3, g4, g12, g14, g134, g234, g1234])
+
+        costs = {e1: (2, 1), e2: (14, 1), e3: (4, 1), e4: (7, 1)}
+
+        small_cost_gs = gs.cost_le(costs, (13, 2))
+        self.assertIn(g0, small_cost_gs) # cost: (0, 0)
+        self.assertIn(g1, small_cost_gs) # cost: (2, 1)
+        self.assertNotIn(g2, small_cost_gs) # cost: (14, 1)
+        self.assertIn(g3, small_cost_gs) # cost: (4, 1)
+        self.assertIn(g4, small_cost_gs) # cost: (7, 1)
+        self.assertNotIn(g12, small_cost_gs) # cost: (16, 2)
+        self.assertIn(g14, small_cost_gs) # cost: (9, 2)
+        self.assertNotIn(g134, small_cost_gs) # cost: (13, 3)
+        self.assertNotIn(g234, small_cost_gs) # cost: (25, 3)
+        self.assertNotIn(g1234, small_cost_gs) # cost: (27, 4)
+
+        self.assertEqual(gs.cost_le(costs, (13, 2)),
+                         gs.cost_le({e: c[0] for e, c in costs.items()}, 13) & gs.smaller(3))
+
+    def test_cost_distribution(self):
+        GraphSet.set_universe([e1, e2, e3, e4])
+        gs = GraphSet([g0, g1, g2, g3, g4, g12, g14, g134, g234, g1234])
+
+        costs = {e1: 2, e2: 14, e3: 4, e4: 7}
+        self.assertEqual(gs.cost_distribution(costs),
+                         {0: 1, 2: 1, 4: 1, 7: 1, 9: 1, 13: 1, 14: 1, 16: 1, 25: 1, 27: 1})
+        self.assertEqual(gs.cost_distribution(costs, max_cost=9),
+                         {0: 1, 2: 1, 4: 1, 7: 1, 9: 1})
+
+        costs = {e1: 1, e2: 1, e3: 1, e4: 1}
+        self.assertEqual(gs.cost_distribution(costs), {0: 1, 1: 4, 2: 2, 3: 2, 4: 1})
+        for c, n in gs.cost_distribution(costs).items():
+            self.assertEqual(len(gs.cost_eq(costs, c)), n)
+
+        probabilities = {e1: .9, e2: .8, e3: .7, e4: .6}
+        dist = gs.cost_distribution(costs, probabilities)
+        self.assertAlmostEqual(sum(dist.values()), gs.probability(probabilities))
+        self.assertAlmostEqual(dist[4], .9 * .8 * .7 * .6)
+        self.assertAlmostEqual(dist[0], .1 * .2 * .3 * .4)
+
+    def test_min_max_cost(self):
+        gs = GraphSet([g0, g1, g12, g123, g1234, g134, g14, g4])
+
+        self.assertAlmostEqual(gs.min_cost(), -.1)
+        self.assertAlmostEqual(gs.max_cost(), .7)
+        self.assertEqual(gs.argmin(), g123)
+        self.assertEqual(gs.argmax(), g14)
+
+        weights = {e1: -.3, e2: .2, e3: .2, e4: -.4}
+        self.assertAlmostEqual(gs.min_cost(weights), -.7)
+        self.assertAlmostEqual(gs.max_cost(weights), .1)
+        self.assertEqual(gs.argmin(weights), g14)
+        self.assertEqual(gs.argmax(weights), g123)
+        self.assertEqual(gs.min_cost_sets(weights), GraphSet([g14]))
+
+        weights = {e1: -1, e2: 0, e3: 0, e4: -1}
+        self.assertEqual(gs.min_cost(weights), -2)
+        self.assertTrue(isinstance(gs.min_cost_sets(weights), GraphSet))
+        self.assertEqual(gs.min_cost_sets(weights), GraphSet([g14, g134, g1234]))
+        self.assertIn(gs.argmin(weights), gs.min_cost_sets(weights))
+        self.assertEqual(gs.max_cost_sets(weights), GraphSet([g0]))
+
+        gs = GraphSet()
+        self.assertEqual(gs.min_cost(), float('inf'))
+        self.assertEqual(gs.max_cost(), float('-inf'))
+        self.assertEqual(gs.min_cost_sets(), GraphSet())
+        self.assertRaises(KeyError, gs.argmin)
+
     def test_remove_some_edge(self):
 
         gs = GraphSet([])
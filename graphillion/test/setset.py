@@ -473,6 +473,21 @@ class TestSetset(unittest.TestCase):
         ss = setset([s0, s1, s2, s12, s13, s1234])
         self.assertAlmostEqual(ss.probability(p), .4728)
 
+    def test_min_max_cost(self):
+        import _graphillion
+        ss = setset([s1, s14, s2])
+        self.assertEqual(ss.min_cost({'1': -1, '4': -1}), -2)
+        self.assertEqual(ss.max_cost({'2': 2}), 2)
+
+        # weights must cover every element of the family
+        w = [0, 1.0]
+        for op in [_graphillion.setset.min_cost, _graphillion.setset.max_cost,
+                   _graphillion.setset.argmin, _graphillion.setset.argmax,
+                   _graphillion.setset.min_cost_sets,
+                   _graphillion.setset.max_cost_sets]:
+            self.assertRaises(ValueError, op, ss, w)
+        self.assertEqual(_graphillion.setset.min_cost(setset([s1]), w), 1)
+
     def test_remove_some_element(self):
 
         ss = setset([])
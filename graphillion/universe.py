@@ -89,6 +89,7 @@ class Universe:
     isolated_vertices = set()
     weights = {}
     edge_vertex_kind = {}
+    frontier_time_limit = 1.0  # upper bound in seconds of the 'frontier' traversals
 
     e_objtable = ObjectTable()
     v_objtable = ObjectTable()
@@ -185,8 +186,14 @@ class Universe:
             The default is 'greedy', best-first search from `source`
             with respect to the number of unused incident edges.
             Other options include 'bfs', the breadth-first search, 
-            'dfs', the depth-first search, and 'as-is', the order of
-            `universe` list.
+            'dfs', the depth-first search, 'frontier', which searches
+            for an order keeping the largest frontier of the
+            frontier-based search small, 'frontier-sum', which keeps
+            the total of the frontiers small instead, and 'as-is', the
+            order of `universe` list.  The 'frontier' traversals start
+            from the 'greedy' order and spend a fixed amount of search,
+            so they give the same order on every run unless cut off by
+            `Universe.frontier_time_limit` seconds (1.0 by default).
 
           source: Optional.  This argument specifies the starting
             point of the edge traversal.
@@ -358,7 +365,11 @@ class Universe:
         visited_vertices = set()
         u = source
 
-        if traversal == 'greedy':
+        if traversal == 'frontier' or traversal == 'frontier-sum':
+            sorted_edges = Universe._traverse(indexed_edges, 'greedy', source)
+            return Universe._frontier_order(
+                sorted_edges, source, traversal == 'frontier-sum')
+        elif traversal == 'greedy':
             degree = dict()
             for v in vertices:
                 degree[v] = len(neighbors[v])
@@ -412,3 +423,14 @@ class Universe:
             return sorted_edges
         else:
             raise ValueError('invalid `traversal`: {}'.format(traversal))
+
+    @staticmethod
+    def _frontier_order(sorted_edges, source, minimize_sum):
+        index = {source: 0}
+        for u, v in sorted_edges:
+            index.setdefault(u, len(index))
+            index.setdefault(v, len(index))
+        order = _graphillion._frontier_edge_order(
+            len(index), [(index[u], index[v]) for u, v in sorted_edges],
+            0, minimize_sum, Universe.frontier_time_limit)
+        return [sorted_edges[i] for i in order]
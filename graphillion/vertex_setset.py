@@ -795,6 +795,130 @@ class VertexSetSet(object):
             except StopIteration:
                 return
 
+    def min_cost(self, weights=None):
+        """Returns the minimum total weight of vertex sets in `self`.
+
+        The weights of vertexs are specified by the argument `weights`
+        or those set as the universe (1.0 for unspecified vertexs), as
+        in min_iter().
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          The minimum weight, or float('inf') if `self` is empty.
+
+        See Also:
+          max_cost(), argmin(), min_cost_sets(), min_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.min_cost(Universe.v_objtable, weights)
+
+    def max_cost(self, weights=None):
+        """Returns the maximum total weight of vertex sets in `self`.
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          The maximum weight, or float('-inf') if `self` is empty.
+
+        See Also:
+          min_cost(), argmax(), max_cost_sets(), max_iter()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.max_cost(Universe.v_objtable, weights)
+
+    def argmin(self, weights=None):
+        """Returns a vertex set of the minimum total weight in `self`.
+
+        If several vertex sets have the minimum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          A vertex set.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmax(), min_cost(), min_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.argmin(Universe.v_objtable, weights)
+
+    def argmax(self, weights=None):
+        """Returns a vertex set of the maximum total weight in `self`.
+
+        If several vertex sets have the maximum weight, one of them is
+        returned.
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          A vertex set.
+
+        Raises:
+          KeyError: If `self` is empty.
+
+        See Also:
+          argmin(), max_cost(), max_cost_sets()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return self._ss.argmax(Universe.v_objtable, weights)
+
+    def min_cost_sets(self, weights=None):
+        """Returns a new VertexSetSet with all vertex sets of the minimum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          A new VertexSetSet object.
+
+        See Also:
+          max_cost_sets(), min_cost(), argmin()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return VertexSetSet(self._ss.min_cost_sets(Universe.v_objtable, weights))
+
+    def max_cost_sets(self, weights=None):
+        """Returns a new VertexSetSet with all vertex sets of the maximum total weight.
+
+        Args:
+          weights: Optional.  A dictionary of vertexs to the weight
+            values.
+
+        Returns:
+          A new VertexSetSet object.
+
+        See Also:
+          min_cost_sets(), max_cost(), argmax()
+
+        """
+        if weights is None:
+            weights = Universe.weights
+        return VertexSetSet(self._ss.max_cost_sets(Universe.v_objtable, weights))
+
     def __contains__(self, obj):
         """Returns True if `obj` is in the `self`, False otherwise.
 
@@ -1163,6 +1287,51 @@ class VertexSetSet(object):
         """
         return VertexSetSet(self._ss.set_size(size))
 
+    def graph_size_between(self, lower, upper):
+        """Returns a new VertexSetSet with vertex sets that have `lower` to `upper` vertices.
+
+        This method returns a new VertexSetSet with vertex sets whose number
+        of vertices is between `lower` and `upper` inclusive.  It
+        traverses the diagram once, instead of combining smaller() and
+        larger().
+
+        Args:
+          lower: The lower limit of the number of vertices in a vertex set.
+          upper: The upper limit of the number of vertices in a vertex set.
+
+        Returns:
+          A new VertexSetSet object.
+
+        See Also:
+          graph_size(), smaller(), larger()
+
+        """
+        return VertexSetSet(self._ss.size_between(lower, upper))
+
+    def graph_size_distribution(self):
+        """Returns the number of vertex sets in `self` for each number of vertices.
+
+        The counts for all sizes are computed in a single pass over the
+        diagram.
+
+        Examples:
+          >>> vertex_set1 = [1]
+          >>> vertex_set2 = [1, 2]
+          >>> vertex_set3 = [1, 2, 3]
+          >>> vss = VertexSetSet([vertex_set1, vertex_set2, vertex_set3])
+          >>> vss.graph_size_distribution()
+          {1: 1, 2: 1, 3: 1}
+
+        Returns:
+          A dictionary mapping each number of vertices to the number
+          of vertex sets of that size.
+
+        See Also:
+          graph_size(), len()
+
+        """
+        return self._ss.size_dist()
+
     def complement(self):
         """Returns a new VertexSetSet with complement vertex sets of `self`.
 
@@ -1659,7 +1828,75 @@ class VertexSetSet(object):
 
         """
         #assert costs.keys() == VertexSetSet._vertex2obj.keys()
-        return self.cost_le(costs, cost_bound) - self.cost_le(costs, cost_bound - 1)
+        return self.cost_between(costs, cost_bound, cost_bound)
+
+    def cost_between(self, costs, lower, upper):
+        """Returns a new VertexSetSet with subsets whose cost is between the lower and upper bounds.
+
+        This method constructs a VertexSetSet of subsets in which each vertex set's
+        cost is greater than or equal to `lower` and less than or equal to `upper`
+        given `costs` of each vertex.  The subsets are selected in a single
+        pass over the diagram.
+
+        Examples:
+          >>> vertex_set1 = [1, 3]
+          >>> vertex_set2 = [4]
+          >>> vertex_set3 = [1, 2, 4]
+          >>> vss = VertexSetSet([vertex_set1, vertex_set2, vertex_set3])
+          >>> costs = {1: 2, 2: 3, 3: 1, 4: 7}
+          >>> vss.cost_between(costs, 3, 7)
+          VertexSetSet([[4], [1, 3]])
+
+        Args:
+          costs: A dictionary of cost of each vertex.
+          lower: The lower limit of cost of each vertex set. 32 bit signed integer.
+          upper: The upper limit of cost of each vertex set. 32 bit signed integer.
+
+        Returns:
+          A new VertexSetSet object.
+
+        Raises:
+          KeyError: If a given vertex is not found in the universe.
+          AssertionError: If the cost of at least one vertex is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        """
+        return VertexSetSet(self._ss.cost_between(Universe.v_objtable, costs, lower, upper))
+
+    def cost_distribution(self, costs, probabilities=None, max_cost=None):
+        """Returns the number of vertex sets in `self` for each total cost.
+
+        This method computes, in a single pass over the diagram, how
+        many vertex sets have each total cost given `costs` of each vertex.
+        If `probabilities` of each vertex are given, the probability
+        of occurrence of the vertex sets having each total cost is returned
+        instead of the number.
+
+        Examples:
+          >>> vss = VertexSetSet([[1, 3], [4], [1, 2, 4]])
+          >>> costs = {1: 2, 2: 3, 3: 1, 4: 7}
+          >>> vss.cost_distribution(costs)
+          {3: 1, 7: 1, 12: 1}
+
+        Args:
+          costs: A dictionary of the cost of each vertex.
+          probabilities: Optional.  A dictionary of the probability of each vertex.
+          max_cost: Optional.  Costs larger than `max_cost` are omitted,
+            which also saves work if no cost is negative.
+
+        Returns:
+          A dictionary mapping each total cost to the number (or the
+          probability) of vertex sets of that cost.
+
+        Raises:
+          KeyError: If a given vertex is not found in the universe.
+          AssertionError: If the cost of at least one vertex is not given, or outside the range of 32 bit signed integer.
+          TypeError: If at least one cost is not integer.
+
+        See Also:
+          cost_le(), probability()
+        """
+        return self._ss.cost_dist(objtable=Universe.v_objtable, costs=costs, probabilities=probabilities, max_cost=max_cost)
 
     def remove_some_vertex(self):
         """Returns a new VertexSetSet with vertex sets that are obtained by removing some vertex from a vertex set in `self`.
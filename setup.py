@@ -75,7 +75,9 @@ sources_list = [os.path.join('src', 'pygraphillion.cc'),
                 os.path.join('src', 'graphillion', 'setset.cc'),
                 os.path.join('src', 'graphillion', 'util.cc'),
                 os.path.join('src', 'graphillion', 'zdd.cc'),
+                os.path.join('src', 'graphillion', 'cost_query.cc'),
                 os.path.join('src', 'graphillion', 'reconf.cc'),
+                os.path.join('src', 'graphillion', 'dd_cache.cc'),
                 os.path.join('src', 'SAPPOROBDD', 'bddc.cc'),
                 os.path.join('src', 'SAPPOROBDD', 'BDD.cc'),
                 os.path.join('src', 'SAPPOROBDD', 'ZBDD.cc'),
@@ -90,6 +92,7 @@ sources_list = [os.path.join('src', 'pygraphillion.cc'),
                 os.path.join('src', 'graphillion', 'forbidden_induced', 'ForbiddenInducedSubgraphs.cc'),
                 os.path.join('src', 'graphillion', 'odd_edges_subgraphs', 'OddEdgeSubgraphs.cc'),
                 os.path.join('src', 'graphillion', 'degree_distribution', 'DegreeDistributionGraphs.cc'),
+                os.path.join('src', 'graphillion', 'ordering', 'EdgeOrdering.cc'),
                 os.path.join('src', 'graphillion', 'variable_converter', 'variable_converter.cc')]
 
 if sys.platform == 'win32':
@@ -167,7 +170,9 @@ trillions of graphs can be processed on a single computer.
                   sources=sources_list,
                   include_dirs=['src', 'src/SAPPOROBDD'],
                   libraries=libraries_list,
-                  define_macros=[('B_64', None)],
+                  define_macros=[('B_64', None),
+                                 ('GRAPHILLION_VERSION',
+                                  '"%s"' % release.version)],
                   extra_compile_args=extra_compile_args_list,
                   extra_link_args=extra_link_args_list,
                   ),
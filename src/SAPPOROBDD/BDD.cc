@@ -125,6 +125,8 @@ bddword BDD_Used(void) { return bddused(); }
 
 void BDD_GC() { bddgc(); }
 
+bddword BDD_GCCount() { return bddgccount(); }
+
 BDD BDD_Import(FILE *strm)
 {
 	bddword bdd;
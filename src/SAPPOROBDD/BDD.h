@@ -107,6 +107,7 @@ extern int     BDD_NewVarOfLev(int);
 extern int     BDD_VarUsed(void);
 extern bddword BDD_Used(void);
 extern void    BDD_GC(void);
+extern bddword BDD_GCCount(void);
 extern BDD BDD_Import(FILE *strm = stdin);
 extern BDD BDD_Random(int, int density = 50);
 extern void BDDerr(const char *);
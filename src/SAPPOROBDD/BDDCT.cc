@@ -9,17 +9,23 @@ using namespace std;
 BDDCT::BDDCT()
 {
   _n = 0;
+  _dim = 1;
   _cost = 0;
   _label = 0;
 
   _casize = 0;
   _caent = 0;
+  _cakey = 0;
   _ca = 0;
 
   _ca0size = 0;
   _ca0ent = 0;
   _ca0 = 0;
 
+  _calimit = 1 << 22;
+  CacheStatClear();
+
+  _gc = BDD_GCCount();
   _call = 0;
 }
 
@@ -35,9 +41,10 @@ BDDCT::~BDDCT()
   if(_ca0) delete[] _ca0; 
 }
 
-bddcost BDDCT::Cost(const int ix) const
+bddcost BDDCT::Cost(const int ix, const int d) const
 {
-  return (ix >= _n)? bddcost_null: (ix < 0)? 1: _cost[ix];
+  if(d < 0 || d >= _dim) return bddcost_null;
+  return (ix >= _n)? bddcost_null: (ix < 0)? 1: _cost[ix * _dim + d];
 }
 
 char* BDDCT::Label(const int ix) const
@@ -45,12 +52,14 @@ char* BDDCT::Label(const int ix) const
   return (ix >= _n || ix < 0)? 0: _label[ix];
 }
 
-int BDDCT::SetCost(const int ix, const bddcost cost)
+int BDDCT::SetCost(const int ix, const int d, const bddcost cost)
 {
   if(ix < 0 || ix >= _n) return 1;
-  _cost[ix] = cost;
+  if(d < 0 || d >= _dim) return 1;
+  _cost[ix * _dim + d] = cost;
   if(_caent > 0) if(CacheClear()) return 1;
   if(_ca0ent > 0) if(Cache0Clear()) return 1;
+  if(!_cav.empty()) if(CacheVClear()) return 1;
   return 0;
 }
 
@@ -67,7 +76,7 @@ int BDDCT::SetLabel(const int ix, const char* label)
   return 0;
 }
 
-int BDDCT::Alloc(const int n, const bddcost cost)
+int BDDCT::AllocDim(const int n, const int dim, const bddcost cost)
 {
   if(_cost) { delete[] _cost; _cost = 0; }
   if(_label)
@@ -77,16 +86,16 @@ int BDDCT::Alloc(const int n, const bddcost cost)
   }
 
   _n = (n < 0)? 0: n;
+  // Cache0 keeps min/max of dimension d as op 4+2d and 5+2d (< 255).
+  _dim = (dim < 1 || dim > 125)? 1: dim;
+  if(_dim != dim) { Alloc(0); return 1; }
 
   if(_n > 0)
   {
-    if(!(_cost = new bddcost[_n])) { Alloc(0); return 1; }
+    if(!(_cost = new bddcost[_n * _dim])) { Alloc(0); return 1; }
     if(!(_label = new char*[_n])) { Alloc(0); return 1; }
-    for(int i=0; i<_n; i++)
-    {
-      _cost[i] = cost;
-      _label[i] = 0;
-    }
+    for(int i=0; i<_n * _dim; i++) _cost[i] = cost;
+    for(int i=0; i<_n; i++) _label[i] = 0;
     for(int i=0; i<_n; i++)
       if((_label[i] = new char[CT_STRLEN + 1])) _label[i][0] = 0;
       else { Alloc(0); return 1; }
@@ -94,6 +103,8 @@ int BDDCT::Alloc(const int n, const bddcost cost)
 
   if(CacheClear()) return 1;
   if(Cache0Clear()) return 1;
+  if(CacheVClear()) return 1;
+  _gc = BDD_GCCount();
   return 0;
 }
 
@@ -142,7 +153,7 @@ void BDDCT::Export() const
   cout << "#n " << _n << "\n";
   for(int i=0; i<_n; i++)
   {
-    cout << _cost[i];
+    cout << _cost[i * _dim];
     if(_label[i] && _label[i][0])
       cout << " #" << _label[i];
     cout << "\n";
@@ -154,6 +165,7 @@ int BDDCT::CacheClear()
   if(_ca) { delete[] _ca; _ca = 0; }
   _casize = 1 << 4;
   _caent = 0;
+  _cakey = 0;
   if(!(_ca = new CacheEntry[_casize])) return 1;
   return 0;
 }
@@ -193,6 +205,7 @@ ZBDD BDDCT::CacheRef(const ZBDD& f, const bddcost bound,
                       bddcost& acc_worst, bddcost& rej_best)
 {
   if(!_casize) return -1;
+  _stat[CA]._ref++;
   bddword id = f.GetID();
   bddword k = Hash(id) & (_casize - 1);
   while(1)
@@ -209,10 +222,12 @@ ZBDD BDDCT::CacheRef(const ZBDD& f, const bddcost bound,
 	acc_worst = bddcost_null;
 	--itr;
 	rej_best = -(itr->first);
+	_stat[CA]._hit++;
 	return 0;
       }
       ZBDD h = itr->second;
       if(h == -1) return -1;
+      _stat[CA]._hit++;
       acc_worst = -(itr->first);
       if(acc_worst == -bddcost_null) acc_worst = bddcost_null;
       if(itr == zm->begin()) rej_best = bddcost_null;
@@ -232,7 +247,12 @@ int BDDCT::CacheEnt(const ZBDD& f, const ZBDD& h,
                      const bddcost acc_worst, const bddcost rej_best)
 {
   if(!_casize) return 1;
-  if(_caent >= (_casize >> 1) && CacheEnlarge()) return 1;
+  if(_calimit && _caent + _cakey >= _calimit)
+  {
+    _stat[CA]._flush++;
+    if(CacheClear()) return 1;
+  }
+  else if(_caent >= (_casize >> 1) && CacheEnlarge()) return 1;
   bddword id = f.GetID();
   bddword k = Hash(id) & (_casize - 1);
   while(1)
@@ -240,6 +260,7 @@ int BDDCT::CacheEnt(const ZBDD& f, const ZBDD& h,
     if(!_ca[k]._zmap)
     {
       _caent++;
+      _stat[CA]._ent++;
       if(!(_ca[k]._zmap = new Zmap)) return 1;
       _ca[k]._id = id;
       break;
@@ -249,10 +270,12 @@ int BDDCT::CacheEnt(const ZBDD& f, const ZBDD& h,
     k &= _casize - 1;
   }
   Zmap* zm = _ca[k]._zmap;
+  bddword keys = zm->size();
   if(acc_worst != bddcost_null) (*zm)[-acc_worst] = h;
   else if(h == 0) (*zm)[bddcost_null] = 0;
   if(rej_best != bddcost_null)
      if(zm->find(-rej_best) == zm->end()) (*zm)[-rej_best] = -1;
+  _cakey += zm->size() - keys;
   return 0;
 }
 
@@ -300,11 +323,16 @@ int BDDCT::Cache0Enlarge()
 bddcost BDDCT::Cache0Ref(const unsigned char op, const bddword id) const
 {
   if(!_ca0size) return bddcost_null;
+  _stat[CA0]._ref++;
   bddword k = Hash0(op, id) & (_ca0size - 1);
   while(1)
   {
     if(_ca0[k]._b == bddcost_null) return bddcost_null;
-    if(_ca0[k]._op == op && _ca0[k]._id == id) return _ca0[k]._b;
+    if(_ca0[k]._op == op && _ca0[k]._id == id)
+    {
+      _stat[CA0]._hit++;
+      return _ca0[k]._b;
+    }
     k++;
     k &= _ca0size - 1;
   }
@@ -313,11 +341,21 @@ bddcost BDDCT::Cache0Ref(const unsigned char op, const bddword id) const
 int BDDCT::Cache0Ent(const unsigned char op, const bddword id, const bddcost b)
 {
   if(!_ca0size) return 1;
-  if(_ca0ent >= (_ca0size >> 1) && Cache0Enlarge()) return 1;
+  if(_calimit && _ca0ent >= _calimit)
+  {
+    _stat[CA0]._flush++;
+    if(Cache0Clear()) return 1;
+  }
+  else if(_ca0ent >= (_ca0size >> 1) && Cache0Enlarge()) return 1;
   bddword k = Hash0(op, id) & (_ca0size - 1);
   while(1)
   {
-    if(_ca0[k]._b == bddcost_null) { _ca0ent++; break; }
+    if(_ca0[k]._b == bddcost_null)
+    {
+      _ca0ent++;
+      _stat[CA0]._ent++;
+      break;
+    }
     if(_ca0[k]._op == op && _ca0[k]._id == id) break;
     k++;
     k &= _ca0size - 1;
@@ -328,12 +366,80 @@ int BDDCT::Cache0Ent(const unsigned char op, const bddword id, const bddcost b)
   return 0;
 }
 
-static BDDCT* CT;
-static ZBDD CLE(const ZBDD &, const bddcost, bddcost &, bddcost &);
-ZBDD CLE(const ZBDD& f, const bddcost bound,
+int BDDCT::CacheVClear()
+{
+  _cav.clear();
+  return 0;
+}
+
+ZBDD BDDCT::CacheVRef(const unsigned char op, const ZBDD& f,
+                      const vector<bddcost>& b) const
+{
+  _stat[CAV]._ref++;
+  vector<bddcost> k(b);
+  k.push_back(op);
+  ZVmap::const_iterator itr = _cav.find(make_pair(f.GetID(), k));
+  if(itr == _cav.end()) return -1;
+  _stat[CAV]._hit++;
+  return itr->second;
+}
+
+int BDDCT::CacheVEnt(const unsigned char op, const ZBDD& f,
+                     const vector<bddcost>& b, const ZBDD& h)
+{
+  if(_calimit && _cav.size() >= _calimit)
+  {
+    _stat[CAV]._flush++;
+    if(CacheVClear()) return 1;
+  }
+  vector<bddcost> k(b);
+  k.push_back(op);
+  _cav[make_pair(f.GetID(), k)] = h;
+  _stat[CAV]._ent++;
+  return 0;
+}
+
+void BDDCT::CacheStatClear()
+{
+  for(int c=0; c<3; c++)
+  {
+    _stat[c]._ref = 0;
+    _stat[c]._hit = 0;
+    _stat[c]._ent = 0;
+    _stat[c]._flush = 0;
+  }
+}
+
+void BDDCT::CacheStatus() const
+{
+  static const char* name[3] = { "cost_le", "min_max", "vector" };
+  bddword size[3] = { _caent + _cakey, _ca0ent, (bddword)_cav.size() };
+  cout << "#cache limit " << _calimit << "\n";
+  for(int c=0; c<3; c++)
+  {
+    cout << name[c] << ": size " << size[c]
+         << " ref " << _stat[c]._ref << " hit " << _stat[c]._hit
+         << " ent " << _stat[c]._ent << " flush " << _stat[c]._flush << "\n";
+  }
+}
+
+// Caches are keyed by node IDs, which may be recycled once a GC has
+// freed them; entries are kept across calls only while no GC occurs.
+int BDDCT::CacheCheckGC()
+{
+  if(_gc == BDD_GCCount()) return 0;
+  _gc = BDD_GCCount();
+  if(_caent > 0) if(CacheClear()) return 1;
+  if(_ca0ent > 0) if(Cache0Clear()) return 1;
+  if(!_cav.empty()) if(CacheVClear()) return 1;
+  return 0;
+}
+
+static ZBDD CLE(BDDCT *, const ZBDD &, const bddcost, bddcost &, bddcost &);
+ZBDD CLE(BDDCT* ct, const ZBDD& f, const bddcost bound,
           bddcost& acc_worst, bddcost& rej_best)
 {
-  CT->_call++;
+  ct->_call++;
   if(f == 0)
   {
     acc_worst = bddcost_null;
@@ -356,16 +462,16 @@ ZBDD CLE(const ZBDD& f, const bddcost bound,
     }
   }
   ZBDD h;
-  h =  CT->CacheRef(f, bound, acc_worst, rej_best);
+  h =  ct->CacheRef(f, bound, acc_worst, rej_best);
   if(h != -1) return h;
   int top = f.Top();
-  bddcost cost = CT->CostOfLev(BDD_LevOfVar(top));
+  bddcost cost = ct->CostOfLev(BDD_LevOfVar(top));
   bddcost aw0, aw1, rb0, rb1;
-  h = CLE(f.OnSet0(top), bound - cost, aw1, rb1).Change(top)
-    + CLE(f.OffSet(top), bound, aw0, rb0);
+  h = CLE(ct, f.OnSet0(top), bound - cost, aw1, rb1).Change(top)
+    + CLE(ct, f.OffSet(top), bound, aw0, rb0);
   /*
-  h = CLE(f.OffSet(top), bound, aw0, rb0)
-    + CLE(f.OnSet0(top), bound - cost, aw1, rb1).Change(top);
+  h = CLE(ct, f.OffSet(top), bound, aw0, rb0)
+    + CLE(ct, f.OnSet0(top), bound - cost, aw1, rb1).Change(top);
   */
   if(aw1 == bddcost_null) acc_worst = aw0;
   else
@@ -379,118 +485,363 @@ ZBDD CLE(const ZBDD& f, const bddcost bound,
     rb1 += cost;
     rej_best = (rb0 == bddcost_null)? rb1: (rb0 < rb1)? rb0: rb1;
   }
-  CT->CacheEnt(f, h, acc_worst, rej_best);
+  ct->CacheEnt(f, h, acc_worst, rej_best);
   /*
-  if(h == 0) CT->CacheEnt(f, h, bddcost_null, bound+1);
-  else if(h == f) CT->CacheEnt(f, h, bound, bddcost_null);
-  else CT->CacheEnt(f, h, bound, bound+1);
+  if(h == 0) ct->CacheEnt(f, h, bddcost_null, bound+1);
+  else if(h == f) ct->CacheEnt(f, h, bound, bddcost_null);
+  else ct->CacheEnt(f, h, bound, bound+1);
   */
-  //CT->CacheEnt(f, h, bound, bound+1);
+  //ct->CacheEnt(f, h, bound, bound+1);
   return h;
 }
 
 ZBDD BDDCT::ZBDD_CostLE(const ZBDD& f, const bddcost bound,
                          bddcost& acc_worst, bddcost& rej_best)
 {
-  CT = this;
+  CacheCheckGC();
   _call = 0;
-  ZBDD h = CLE(f, bound, acc_worst, rej_best);
+  ZBDD h = CLE(this, f, bound, acc_worst, rej_best);
   return h;
 }
 
-static bddcost MinC(const ZBDD&);
-bddcost MinC(const ZBDD& f)
+static bddcost MinC(BDDCT *, const ZBDD&, const int);
+bddcost MinC(BDDCT* ct, const ZBDD& f, const int d)
 {
   if(f == 0) return bddcost_null;
   if(f == 1) return 0;
-  bddcost min = CT->Cache0Ref(4, f.GetID());
+  bddcost min = ct->Cache0Ref(4 + 2*d, f.GetID());
   if(min != bddcost_null) return min;
   int top = f.Top();
-  min = MinC(f.OffSet(top));
-  bddcost min1 = MinC(f.OnSet0(top))
-               + CT->CostOfLev(BDD_LevOfVar(top));
+  min = MinC(ct, f.OffSet(top), d);
+  bddcost min1 = MinC(ct, f.OnSet0(top), d)
+               + ct->CostOfLev(BDD_LevOfVar(top), d);
   min = (min != bddcost_null && min < min1)? min: min1;
-  CT->Cache0Ent(4, f.GetID(), min);
+  ct->Cache0Ent(4 + 2*d, f.GetID(), min);
   return min;
 }
 
-bddcost BDDCT::MinCost(const ZBDD& f)
+bddcost BDDCT::MinCost(const ZBDD& f, const int d)
 {
-  CT = this;
-  return MinC(f);
+  if(d < 0 || d >= _dim) return bddcost_null;
+  CacheCheckGC();
+  return MinC(this, f, d);
 }
 
-static bddcost MaxC(const ZBDD&);
-bddcost MaxC(const ZBDD& f)
+static bddcost MaxC(BDDCT *, const ZBDD&, const int);
+bddcost MaxC(BDDCT* ct, const ZBDD& f, const int d)
 {
   if(f == 0) return bddcost_null;
   if(f == 1) return 0;
-  bddcost max = CT->Cache0Ref(5, f.GetID());
+  bddcost max = ct->Cache0Ref(5 + 2*d, f.GetID());
   if(max != bddcost_null) return max;
   int top = f.Top();
-  max = MaxC(f.OffSet(top));
-  bddcost max1 = MaxC(f.OnSet0(top))
-               + CT->CostOfLev(BDD_LevOfVar(top));
+  max = MaxC(ct, f.OffSet(top), d);
+  bddcost max1 = MaxC(ct, f.OnSet0(top), d)
+               + ct->CostOfLev(BDD_LevOfVar(top), d);
   max = (max != bddcost_null && max > max1)? max: max1;
-  CT->Cache0Ent(5, f.GetID(), max);
+  ct->Cache0Ent(5 + 2*d, f.GetID(), max);
   return max;
 }
 
-bddcost BDDCT::MaxCost(const ZBDD& f)
+bddcost BDDCT::MaxCost(const ZBDD& f, const int d)
 {
-  CT = this;
-  return MaxC(f);
+  if(d < 0 || d >= _dim) return bddcost_null;
+  CacheCheckGC();
+  return MaxC(this, f, d);
 }
 
-static bddcost B;
-static bddcost RetMin;
-static bddcost RetMax;
-static ZBDD CLE0(const ZBDD &, const bddcost);
-ZBDD CLE0(const ZBDD& f, const bddcost spent)
+// State of one ZBDD_CostLE0 call: the bound, and the min/max costs of
+// the subgraph just visited.
+struct CLE0Arg
+{
+  BDDCT* ct;
+  bddcost b;
+  bddcost retMin;
+  bddcost retMax;
+};
+
+static ZBDD CLE0(CLE0Arg &, const ZBDD &, const bddcost);
+ZBDD CLE0(CLE0Arg& a, const ZBDD& f, const bddcost spent)
 {
   if(f == 0)
   {
-    RetMin = bddcost_null; RetMax = bddcost_null;
+    a.retMin = bddcost_null; a.retMax = bddcost_null;
     return 0;
   }
   if(f == 1)
   {
-    RetMin = 0; RetMax = 0;
-    return (B >= spent)? 1: 0;
+    a.retMin = 0; a.retMax = 0;
+    return (a.b >= spent)? 1: 0;
   }
-  bddcost min = CT->Cache0Ref(4, f.GetID());
-  bddcost max = CT->Cache0Ref(5, f.GetID());
-  RetMin = min; RetMax = max;
-  if(min != bddcost_null) if(B < min + spent) return 0;
-  if(max != bddcost_null) if(B >= max + spent) return f;
+  bddcost min = a.ct->Cache0Ref(4, f.GetID());
+  bddcost max = a.ct->Cache0Ref(5, f.GetID());
+  a.retMin = min; a.retMax = max;
+  if(min != bddcost_null) if(a.b < min + spent) return 0;
+  if(max != bddcost_null) if(a.b >= max + spent) return f;
   int top = f.Top();
   int tlev = BDD_LevOfVar(top);
-  ZBDD h = CLE0(f.OffSet(top), spent);
-  int min0 = RetMin;
-  int max0 = RetMax;
-  bddcost cost = CT->CostOfLev(tlev);
-  h += CLE0(f.OnSet0(top), spent + cost).Change(top);
+  ZBDD h = CLE0(a, f.OffSet(top), spent);
+  int min0 = a.retMin;
+  int max0 = a.retMax;
+  bddcost cost = a.ct->CostOfLev(tlev);
+  h += CLE0(a, f.OnSet0(top), spent + cost).Change(top);
   if(min == bddcost_null)
   {
-    min = RetMin + cost;
+    min = a.retMin + cost;
     if(min0 != bddcost_null) min = (min0 <= min)? min0: min;
-    CT->Cache0Ent(4, f.GetID(), min);
+    a.ct->Cache0Ent(4, f.GetID(), min);
   }
   if(max == bddcost_null)
   {
-    max = RetMax + cost;
+    max = a.retMax + cost;
     if(max0 != bddcost_null) max = (max0 >= max)? max0: max;
-    CT->Cache0Ent(5, f.GetID(), max);
+    a.ct->Cache0Ent(5, f.GetID(), max);
   }
-  RetMin = min; RetMax = max;
+  a.retMin = min; a.retMax = max;
   return h;
 }
 
 ZBDD BDDCT::ZBDD_CostLE0(const ZBDD& f, const bddcost bound)
 {
-  CT = this;
-  B = bound;
-  ZBDD h = CLE0(f, 0);
+  CacheCheckGC();
+  CLE0Arg a;
+  a.ct = this;
+  a.b = bound;
+  ZBDD h = CLE0(a, f, 0);
   return h;
 }
 
+static ZBDD CBT(BDDCT *, const ZBDD &, const bddcost, const bddcost);
+ZBDD CBT(BDDCT* ct, const ZBDD& f, const bddcost lb, const bddcost ub)
+{
+  ct->_call++;
+  if(f == 0) return 0;
+  if(f == 1) return (lb <= 0 && 0 <= ub)? 1: 0;
+  bddcost min = MinC(ct, f, 0);
+  bddcost max = MaxC(ct, f, 0);
+  if(ub < min || lb > max) return 0;
+  if(lb <= min && max <= ub) return f;
+  // A one-sided interval is answered by the CostLE cache.
+  bddcost aw, rb;
+  if(lb <= min) return CLE(ct, f, ub, aw, rb);
+  if(max <= ub) return f - CLE(ct, f, lb - 1, aw, rb);
+  vector<bddcost> b(2);
+  b[0] = lb; b[1] = ub;
+  ZBDD h = ct->CacheVRef(0, f, b);
+  if(h != -1) return h;
+  int top = f.Top();
+  bddcost cost = ct->CostOfLev(BDD_LevOfVar(top));
+  h = CBT(ct, f.OnSet0(top), lb - cost, ub - cost).Change(top)
+    + CBT(ct, f.OffSet(top), lb, ub);
+  ct->CacheVEnt(0, f, b, h);
+  return h;
+}
+
+ZBDD BDDCT::ZBDD_CostBetween(const ZBDD& f, const bddcost lb,
+                              const bddcost ub)
+{
+  if(lb > ub) return 0;
+  CacheCheckGC();
+  _call = 0;
+  return CBT(this, f, lb, ub);
+}
+
+static ZBDD CLEV(BDDCT *, const ZBDD &, const vector<bddcost> &);
+ZBDD CLEV(BDDCT* ct, const ZBDD& f, const vector<bddcost>& bound)
+{
+  ct->_call++;
+  if(f == 0) return 0;
+  int dim = ct->Dim();
+  if(f == 1)
+  {
+    for(int d=0; d<dim; d++) if(bound[d] < 0) return 0;
+    return 1;
+  }
+  int all = 1;
+  for(int d=0; d<dim; d++)
+  {
+    if(bound[d] < MinC(ct, f, d)) return 0;
+    if(bound[d] < MaxC(ct, f, d)) all = 0;
+  }
+  if(all) return f;
+  ZBDD h = ct->CacheVRef(1, f, bound);
+  if(h != -1) return h;
+  int top = f.Top();
+  int tlev = BDD_LevOfVar(top);
+  vector<bddcost> bound1(bound);
+  for(int d=0; d<dim; d++) bound1[d] -= ct->CostOfLev(tlev, d);
+  h = CLEV(ct, f.OnSet0(top), bound1).Change(top)
+    + CLEV(ct, f.OffSet(top), bound);
+  ct->CacheVEnt(1, f, bound, h);
+  return h;
+}
+
+ZBDD BDDCT::ZBDD_CostLEV(const ZBDD& f, const vector<bddcost>& bound)
+{
+  if((int)bound.size() != _dim) return -1;
+  if(_dim == 1) return ZBDD_CostLE(f, bound[0]);
+  CacheCheckGC();
+  _call = 0;
+  return CLEV(this, f, bound);
+}
+
+// Multiprecision natural numbers in 32-bit words, lowest word first.
+typedef vector<unsigned int> MPnum;
+typedef map<bddcost, MPnum> MPdist;
+
+static void MPAdd(MPnum& a, const MPnum& b)
+{
+  if(a.size() < b.size()) a.resize(b.size(), 0);
+  unsigned long long c = 0;
+  for(size_t i=0; i<a.size(); i++)
+  {
+    c += a[i];
+    if(i < b.size()) c += b[i];
+    a[i] = (unsigned int)c;
+    c >>= 32;
+  }
+  if(c) a.push_back((unsigned int)c);
+}
+
+static string MPStr(MPnum a)
+{
+  string s;
+  while(!a.empty())
+  {
+    unsigned long long r = 0;
+    for(size_t i=a.size(); i-- > 0; )
+    {
+      r = (r << 32) | a[i];
+      a[i] = (unsigned int)(r / 1000000000);
+      r %= 1000000000;
+    }
+    while(!a.empty() && a.back() == 0) a.pop_back();
+    char buf[16];
+    snprintf(buf, sizeof(buf), a.empty()? "%llu": "%09llu", r);
+    s = buf + s;
+  }
+  return s.empty()? "0": s;
+}
+
+static inline int LevOf(const ZBDD& f)
+{
+  return (f.Top() == 0)? 0: BDD_LevOfVar(f.Top());
+}
+
+// State of one CostDist/CostDistProb call.  Costs above max can be
+// dropped at every node only when no cost is negative (trunc); otherwise
+// the bound is applied to the root distribution.
+struct DistArg
+{
+  BDDCT* ct;
+  bddcost max;
+  int trunc;
+  map<bddword, MPdist> memo;
+  const vector<double>* prob;
+  map<bddword, CTpdist> pmemo;
+};
+
+static const MPdist& CD(DistArg &, const ZBDD &);
+const MPdist& CD(DistArg& a, const ZBDD& f)
+{
+  map<bddword, MPdist>::iterator itr = a.memo.find(f.GetID());
+  if(itr != a.memo.end()) return itr->second;
+  MPdist& d = a.memo[f.GetID()];
+  if(f == 0) return d;
+  if(f == 1) { d[0] = MPnum(1, 1); return d; }
+  a.ct->_call++;
+  int top = f.Top();
+  bddcost cost = a.ct->CostOfLev(BDD_LevOfVar(top));
+  d = CD(a, f.OffSet(top));
+  const MPdist& d1 = CD(a, f.OnSet0(top));
+  for(MPdist::const_iterator i=d1.begin(); i!=d1.end(); ++i)
+  {
+    bddcost c = i->first + cost;
+    if(a.trunc && c > a.max) break;
+    MPAdd(d[c], i->second);
+  }
+  return d;
+}
+
+int BDDCT::CostDist(const ZBDD& f, CTdist& dist, const bddcost max)
+{
+  dist.clear();
+  if(f == -1) return 1;
+  if(LevOf(f) > _n) return 1;
+  _call = 0;
+  DistArg a;
+  a.ct = this;
+  a.max = max;
+  a.trunc = (max != bddcost_null);
+  for(int ix=0; ix<_n; ix++) if(Cost(ix) < 0) a.trunc = 0;
+  a.prob = 0;
+  const MPdist& d = CD(a, f);
+  for(MPdist::const_iterator i=d.begin(); i!=d.end(); ++i)
+  {
+    if(i->first > max) break;
+    dist[i->first] = MPStr(i->second);
+  }
+  return 0;
+}
+
+// Probability that the levels in (to, from] are all absent.
+static double SkipProb(const DistArg& a, const int from, const int to)
+{
+  double p = 1;
+  for(int lev=to+1; lev<=from; lev++) p *= 1 - (*a.prob)[a.ct->_n - lev];
+  return p;
+}
+
+static const CTpdist& CDP(DistArg &, const ZBDD &);
+const CTpdist& CDP(DistArg& a, const ZBDD& f)
+{
+  map<bddword, CTpdist>::iterator itr = a.pmemo.find(f.GetID());
+  if(itr != a.pmemo.end()) return itr->second;
+  CTpdist& d = a.pmemo[f.GetID()];
+  if(f == 0) return d;
+  if(f == 1) { d[0] = 1; return d; }
+  a.ct->_call++;
+  int top = f.Top();
+  int tlev = BDD_LevOfVar(top);
+  bddcost cost = a.ct->CostOfLev(tlev);
+  double p = (*a.prob)[a.ct->_n - tlev];
+  ZBDD f0 = f.OffSet(top);
+  ZBDD f1 = f.OnSet0(top);
+  double q0 = (1 - p) * SkipProb(a, tlev - 1, LevOf(f0));
+  double q1 = p * SkipProb(a, tlev - 1, LevOf(f1));
+  const CTpdist& d0 = CDP(a, f0);
+  for(CTpdist::const_iterator i=d0.begin(); i!=d0.end(); ++i)
+    d[i->first] += q0 * i->second;
+  const CTpdist& d1 = CDP(a, f1);
+  for(CTpdist::const_iterator i=d1.begin(); i!=d1.end(); ++i)
+  {
+    bddcost c = i->first + cost;
+    if(a.trunc && c > a.max) break;
+    d[c] += q1 * i->second;
+  }
+  return d;
+}
+
+int BDDCT::CostDistProb(const ZBDD& f, const vector<double>& prob,
+                        CTpdist& dist, const bddcost max)
+{
+  dist.clear();
+  if(f == -1) return 1;
+  if((int)prob.size() != _n) return 1;
+  if(LevOf(f) > _n) return 1;
+  _call = 0;
+  DistArg a;
+  a.ct = this;
+  a.max = max;
+  a.trunc = (max != bddcost_null);
+  for(int ix=0; ix<_n; ix++) if(Cost(ix) < 0) a.trunc = 0;
+  a.prob = &prob;
+  double q = SkipProb(a, _n, LevOf(f));
+  const CTpdist& d = CDP(a, f);
+  for(CTpdist::const_iterator i=d.begin(); i!=d.end(); ++i)
+  {
+    if(i->first > max) break;
+    dist[i->first] = q * i->second;
+  }
+  return 0;
+}
@@ -19,7 +19,12 @@ typedef int bddcost;
 #define CT_STRLEN 15
 
 #include <map>
+#include <string>
+#include <vector>
 typedef std::map<bddcost, ZBDD> Zmap;
+typedef std::map<std::pair<bddword, std::vector<bddcost> >, ZBDD> ZVmap;
+typedef std::map<bddcost, std::string> CTdist;
+typedef std::map<bddcost, double> CTpdist;
 
 class BDDCT
 {
@@ -35,7 +40,7 @@ public:
     }
     ~CacheEntry(void)
     {
-      if(!_zmap) delete _zmap;
+      if(_zmap) delete _zmap;
     }
   };
 
@@ -53,40 +58,68 @@ public:
     ~Cache0Entry(void) { }
   };
 
+  // Statistics of a cache since the last CacheStatClear().
+  struct CacheStat
+  {
+    bddword _ref;   // lookups
+    bddword _hit;   // lookups answered
+    bddword _ent;   // new entries
+    bddword _flush; // clears due to the entry limit
+  };
+  enum { CA = 0, CA0 = 1, CAV = 2 };
+
   int _n;
+  int _dim;
   bddcost *_cost;
   char **_label;
 
   bddword _casize;
   bddword _caent;
+  bddword _cakey;  // bounds kept in the _zmap of the entries
   CacheEntry* _ca;
 
   bddword _ca0size;
   bddword _ca0ent;
   Cache0Entry* _ca0;
   
+  ZVmap _cav;
+
+  bddword _calimit;
+  mutable CacheStat _stat[3];
+
+  bddword _gc;
   bddword _call;
 
   BDDCT(void);
   ~BDDCT(void);
 
   inline int Size(void) const { return _n; }
+  inline int Dim(void) const { return _dim; }
 
-  bddcost Cost(const int ix) const;
+  inline bddcost Cost(const int ix) const { return Cost(ix, 0); }
+  bddcost Cost(const int ix, const int d) const;
   inline bddcost CostOfLev(const int lev) const 
   { return Cost(_n-lev); }
+  inline bddcost CostOfLev(const int lev, const int d) const 
+  { return Cost(_n-lev, d); }
   char* Label(const int) const;
   inline char* LabelOfLev(const int lev) const 
   { return Label(_n-lev); }
 
-  int SetCost(const int, const bddcost);
+  inline int SetCost(const int ix, const bddcost cost)
+  { return SetCost(ix, 0, cost); }
+  int SetCost(const int, const int, const bddcost);
   inline int SetCostOfLev(const int lev, const bddcost cost) 
   { return SetCost(_n-lev, cost); }
+  inline int SetCostOfLev(const int lev, const int d, const bddcost cost) 
+  { return SetCost(_n-lev, d, cost); }
   int SetLabel(const int, const char *);
   inline int SetLabelOfLev(const int lev, const char* label)
   { return SetLabel(_n-lev, label); }
 
-  int Alloc(const int n, const bddcost cost = 1);
+  inline int Alloc(const int n, const bddcost cost = 1)
+  { return AllocDim(n, 1, cost); }
+  int AllocDim(const int n, const int dim, const bddcost cost = 1);
   int Import(FILE* fp = stdin);
   int AllocRand(const int, const bddcost, const bddcost);
   void Export(void) const;
@@ -101,13 +134,37 @@ public:
   bddcost Cache0Ref(const unsigned char, const bddword) const;
   int Cache0Ent(const unsigned char, const bddword, const bddcost);
 
+  int CacheVClear(void);
+  ZBDD CacheVRef(const unsigned char, const ZBDD &,
+                 const std::vector<bddcost> &) const;
+  int CacheVEnt(const unsigned char, const ZBDD &,
+                const std::vector<bddcost> &, const ZBDD &);
+
+  int CacheCheckGC(void);
+
+  // Each cache holds at most about limit entries (0: unlimited); a full
+  // cache is cleared rather than enlarged.  In the cost_le cache, every
+  // bound kept for a node counts as an entry as well as the node itself.
+  inline void SetCacheLimit(const bddword limit) { _calimit = limit; }
+  inline bddword CacheLimit(void) const { return _calimit; }
+  void CacheStatClear(void);
+  void CacheStatus(void) const;
+
   ZBDD ZBDD_CostLE(const ZBDD& f, const bddcost bound)
   { bddcost aw, rb; return ZBDD_CostLE(f, bound, aw, rb); }
   ZBDD ZBDD_CostLE(const ZBDD &, const bddcost, bddcost &, bddcost &);
 
   ZBDD ZBDD_CostLE0(const ZBDD &, const bddcost);
-  bddcost MinCost(const ZBDD &);
-  bddcost MaxCost(const ZBDD &);
+  ZBDD ZBDD_CostBetween(const ZBDD &, const bddcost, const bddcost);
+  ZBDD ZBDD_CostLEV(const ZBDD &, const std::vector<bddcost> &);
+  inline bddcost MinCost(const ZBDD& f) { return MinCost(f, 0); }
+  inline bddcost MaxCost(const ZBDD& f) { return MaxCost(f, 0); }
+  bddcost MinCost(const ZBDD &, const int);
+  bddcost MaxCost(const ZBDD &, const int);
+
+  int CostDist(const ZBDD &, CTdist &, const bddcost max = bddcost_null);
+  int CostDistProb(const ZBDD &, const std::vector<double> &, CTpdist &,
+                   const bddcost max = bddcost_null);
 };
 
 #endif // _BDDCT_
@@ -135,6 +135,9 @@ inline ZBDD operator+(const ZBDD& f, const ZBDD& g)
 inline ZBDD operator-(const ZBDD& f, const ZBDD& g)
   { return ZBDD_ID(bddsubtract(f.GetID(), g.GetID())); }
 
+inline ZBDD ZBDD_Node(int v, const ZBDD& f0, const ZBDD& f1)
+  { return ZBDD_ID(bddmakez(v, f0.GetID(), f1.GetID())); }
+
 inline ZBDD operator%(const ZBDD& f, const ZBDD& p)
   { return f - (f/p) * p; }
 
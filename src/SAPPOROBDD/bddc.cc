@@ -168,6 +168,7 @@ static bddp NodeLimit = 0;    /* Final limit size */
 static bddp NodeUsed = 0;     /* Number of used node */
 static bddp Avail = bddnull;  /* Head of available node */
 static bddp NodeSpc = 0;      /* Current Node-Table size */
+static bddp GCCount = 0;      /* Number of GCs that freed nodes */
 
 /* Declaration of Hash-table per Var */
 struct B_VarTable
@@ -397,6 +398,7 @@ int bddgc()
     if(fp->varrfc != 0 && B_RFC_ZERO_NP(fp))
       gc1(fp);
   if(n == NodeUsed) return 1; /* No free node */
+  GCCount++;
 
   /* Cache clear */
   for(cachep=Cache; cachep<Cache+CacheSpc; cachep++)
@@ -551,6 +553,8 @@ int bddgc()
 
 bddp bddused() { return NodeUsed; }
 
+bddp bddgccount() { return GCCount; }
+
 bddp bddsize(bddp f)
 /* Returns 0 for bddnull */
 {
@@ -1350,6 +1354,40 @@ bddp    bddpush(bddp f, bddvar v)
   return getzbddp(v, bddfalse, f);
 }
 
+bddp    bddmakez(bddvar v, bddp f0, bddp f1)
+/* Returns bddnull if not enough memory */
+/* Makes the ZBDD node (v, f0, f1) directly in the unique table. */
+/* Both children must be ZBDDs below the level of v. */
+{
+  struct B_NodeTable *fp;
+  bddvar lev;
+
+  /* Check operands */
+  if(v > VarUsed || v == 0) err("bddmakez: Invalid VarID", v);
+  if(f0 == bddnull || f1 == bddnull) return bddnull;
+  lev = Var[v].lev;
+  if(!B_CST(f0))
+  {
+    fp = B_NP(f0);
+    if(fp>=Node+NodeSpc || !fp->varrfc)
+      err("bddmakez: Invalid bddp", f0);
+    if(!B_Z_NP(fp)) err("bddmakez: applying non-ZBDD node", f0);
+    if(Var[B_VAR_NP(fp)].lev >= lev) err("bddmakez: Invalid level", f0);
+  }
+  if(!B_CST(f1))
+  {
+    fp = B_NP(f1);
+    if(fp>=Node+NodeSpc || !fp->varrfc)
+      err("bddmakez: Invalid bddp", f1);
+    if(!B_Z_NP(fp)) err("bddmakez: applying non-ZBDD node", f1);
+    if(Var[B_VAR_NP(fp)].lev >= lev) err("bddmakez: Invalid level", f1);
+  }
+
+  if(!B_CST(f0)) { fp = B_NP(f0); B_RFC_INC_NP(fp); }
+  if(!B_CST(f1)) { fp = B_NP(f1); B_RFC_INC_NP(fp); }
+  return getzbddp(v, f0, f1);
+}
+
 /* ----------------- Internal functions ------------------ */
 static void var_enlarge()
 {
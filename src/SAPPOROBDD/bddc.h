@@ -84,6 +84,7 @@ extern bddp   bddat1 B_ARG((bddp f, bddvar v));
 extern void   bddfree B_ARG((bddp f));
 extern bddp   bddused B_ARG((void));
 extern int    bddgc B_ARG((void));
+extern bddp   bddgccount B_ARG((void));
 extern bddp   bddsize B_ARG((bddp f));
 extern bddp   bddvsize B_ARG((bddp *p, int lim));
 extern void   bddexport B_ARG((FILE *strm, bddp *p, int lim));
@@ -112,6 +113,7 @@ extern bddp   bddoffset B_ARG((bddp f, bddvar v));
 extern bddp   bddonset B_ARG((bddp f, bddvar v));
 extern bddp   bddonset0 B_ARG((bddp f, bddvar v));
 extern bddp   bddchange B_ARG((bddp f, bddvar v));
+extern bddp   bddmakez B_ARG((bddvar v, bddp f0, bddp f1));
 extern bddp   bddintersec B_ARG((bddp f, bddp g));
 extern bddp   bddunion B_ARG((bddp f, bddp g));
 extern bddp   bddsubtract B_ARG((bddp f, bddp g));
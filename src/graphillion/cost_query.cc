@@ -0,0 +1,140 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+#include "graphillion/cost_query.h"
+
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+#include "graphillion/zdd.h"
+
+namespace graphillion {
+
+using std::map;
+using std::set;
+using std::vector;
+
+cost_query::cost_query(const vector<double>& weights)
+    : weights_(weights), gc_(BDD_GCCount()) {
+}
+
+double cost_query::min(zdd_t f) {
+  this->check_gc();
+  return this->opt(f, false);
+}
+
+double cost_query::max(zdd_t f) {
+  this->check_gc();
+  return this->opt(f, true);
+}
+
+zdd_t cost_query::argmin(zdd_t f, set<elem_t>* s) {
+  this->check_gc();
+  return this->argopt(f, false, s);
+}
+
+zdd_t cost_query::argmax(zdd_t f, set<elem_t>* s) {
+  this->check_gc();
+  return this->argopt(f, true, s);
+}
+
+zdd_t cost_query::min_sets(zdd_t f) {
+  this->check_gc();
+  return this->opt_sets(f, false);
+}
+
+zdd_t cost_query::max_sets(zdd_t f) {
+  this->check_gc();
+  return this->opt_sets(f, true);
+}
+
+void cost_query::clear() {
+  for (int m = 0; m < 2; ++m) {
+    this->values_[m].clear();
+    this->sets_[m].clear();
+  }
+  this->gc_ = BDD_GCCount();
+}
+
+double cost_query::weight(elem_t e) const {
+  if (e >= static_cast<elem_t>(this->weights_.size()))
+    throw std::invalid_argument("no weight given for an element");
+  return this->weights_[e];
+}
+
+// Caches are keyed by node IDs, which may be reused after nodes are freed.
+void cost_query::check_gc() {
+  if (this->gc_ != BDD_GCCount()) this->clear();
+}
+
+double cost_query::opt(zdd_t f, bool max) {
+  if (f == bot())
+    return max ? -std::numeric_limits<double>::infinity()
+               : std::numeric_limits<double>::infinity();
+  else if (f == top())
+    return 0;
+  map<word_t, double>& cache = this->values_[max];
+  map<word_t, double>::iterator i = cache.find(id(f));
+  if (i != cache.end())
+    return i->second;
+  double l = this->opt(lo(f), max);
+  double h = this->opt(hi(f), max) + this->weight(elem(f));
+  return cache[id(f)] = (max ? h > l : h < l) ? h : l;
+}
+
+zdd_t cost_query::argopt(zdd_t f, bool max, set<elem_t>* s) {
+  assert(s != NULL);
+  s->clear();
+  if (f == bot()) return bot();
+  zdd_t g = top();
+  while (!is_term(f)) {
+    double l = this->opt(lo(f), max);
+    double h = this->opt(hi(f), max) + this->weight(elem(f));
+    if (max ? h > l : h < l) {
+      g = g * single(elem(f));
+      s->insert(elem(f));
+      f = hi(f);
+    } else {
+      f = lo(f);
+    }
+  }
+  assert(f == top());
+  return g;
+}
+
+zdd_t cost_query::opt_sets(zdd_t f, bool max) {
+  if (is_term(f)) return f;
+  map<word_t, zdd_t>& cache = this->sets_[max];
+  map<word_t, zdd_t>::iterator i = cache.find(id(f));
+  if (i != cache.end())
+    return i->second;
+  double l = this->opt(lo(f), max);
+  double h = this->opt(hi(f), max) + this->weight(elem(f));
+  zdd_t rl = (max ? l >= h : l <= h) ? this->opt_sets(lo(f), max) : bot();
+  zdd_t rh = (max ? h >= l : h <= l) ? this->opt_sets(hi(f), max) : bot();
+  return cache[id(f)] = zuniq(elem(f), rl, rh);
+}
+
+}  // namespace graphillion
@@ -0,0 +1,81 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+#ifndef GRAPHILLION_COST_QUERY_H_
+#define GRAPHILLION_COST_QUERY_H_
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "graphillion/type.h"
+
+namespace graphillion {
+
+// Minimum/maximum total weight queries on ZDDs for a fixed weight vector.
+// Per-node results are kept for the life of an instance, until a garbage
+// collection, so repeated queries on the same instance share them; the
+// one-shot setset::min_cost() and so on build a throwaway instance, and
+// setset::cost_context keeps one.  Not thread-safe, not even across
+// instances: the traversal and the sets built use the global tables of
+// SAPPOROBDD.
+class cost_query {
+ public:
+  // weights[e] is the weight of element e (weights[0] is not used); a
+  // query on a family with an element beyond the weights throws
+  // std::invalid_argument
+  explicit cost_query(const std::vector<double>& weights);
+
+  const std::vector<double>& weights() const { return this->weights_; }
+
+  // the optimal total weight; +inf (min) or -inf (max) for an empty family
+  double min(zdd_t f);
+  double max(zdd_t f);
+
+  // one optimal set, or bot() for an empty family
+  zdd_t argmin(zdd_t f, std::set<elem_t>* s);
+  zdd_t argmax(zdd_t f, std::set<elem_t>* s);
+
+  // all optimal sets
+  zdd_t min_sets(zdd_t f);
+  zdd_t max_sets(zdd_t f);
+
+  void clear();
+
+ private:
+  double opt(zdd_t f, bool max);
+  zdd_t argopt(zdd_t f, bool max, std::set<elem_t>* s);
+  zdd_t opt_sets(zdd_t f, bool max);
+  double weight(elem_t e) const;
+  void check_gc();
+
+  std::vector<double> weights_;
+  std::map<word_t, double> values_[2];
+  std::map<word_t, zdd_t> sets_[2];
+  word_t gc_;
+};
+
+}  // namespace graphillion
+
+#endif  // GRAPHILLION_COST_QUERY_H_
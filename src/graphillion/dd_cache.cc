@@ -0,0 +1,143 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+#include "graphillion/dd_cache.h"
+
+#ifdef _MSC_VER
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <string>
+
+#include "graphillion/graphset.h"
+
+#ifndef GRAPHILLION_VERSION
+#define GRAPHILLION_VERSION "unknown"
+#endif
+
+namespace graphillion {
+
+using std::string;
+
+static std::mutex cache_mutex;
+static string cache_directory;  // guarded by cache_mutex
+
+static string current_directory() {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  return cache_directory;
+}
+
+// Names the file of key by its 64-bit FNV-1a hash in dir; collisions only
+// cause misses, since the key is stored in the file as its label.
+static string cache_path(const string& dir, const string& key) {
+  unsigned long long h = 14695981039346656037ULL;
+  for (string::const_iterator c = key.begin(); c != key.end(); ++c)
+    h = (h ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+  char name[24];
+  snprintf(name, sizeof(name), "%016llx.dd", h);
+  return dir + "/" + name;
+}
+
+static string cache_label(const string& key) {
+  return "graphillion " GRAPHILLION_VERSION "\n" + key;
+}
+
+// Returns a unique name to write path under, so that other processes
+// never see a partial file.  The process ID and a counter keep the names
+// of concurrent writers apart, in this process and in others.
+static string temporary_path(const string& path) {
+  static std::atomic<unsigned long> counter(0);
+  char suffix[64];
+  snprintf(suffix, sizeof(suffix), ".%ld.%lu.tmp",
+           static_cast<long>(getpid()), counter.fetch_add(1));
+  return path + suffix;
+}
+
+string CacheDirectory(const string& dir) {
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  string prev = cache_directory;
+  cache_directory = dir;
+  return prev;
+}
+
+bool CacheEnabled() {
+  return !current_directory().empty();
+}
+
+bool LoadCachedDd(const string& key, tdzdd::DdStructure<2>* dd) {
+  string dir = current_directory();
+  if (dir.empty()) return false;
+  try {
+    dd->load(cache_path(dir, key), cache_label(key));
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+void SaveCachedDd(const string& key, const tdzdd::DdStructure<2>& dd) {
+  string dir = current_directory();
+  if (dir.empty()) return;
+  string path = cache_path(dir, key);
+  string tmp = temporary_path(path);
+  try {
+    dd.save(tmp, cache_label(key));
+  } catch (const std::exception&) {
+    std::remove(tmp.c_str());
+    return;
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) std::remove(tmp.c_str());
+}
+
+CachedDdWriter::CachedDdWriter(const string& key) : writer_(NULL) {
+  string dir = current_directory();
+  if (key.empty() || dir.empty()) return;
+  path_ = cache_path(dir, key);
+  tmp_ = temporary_path(path_);
+  writer_ = new tdzdd::DdStructure<2>::Writer(tmp_, cache_label(key));
+}
+
+CachedDdWriter::~CachedDdWriter() {
+  if (writer_ == NULL) return;
+  delete writer_;
+  std::remove(tmp_.c_str());
+}
+
+void CachedDdWriter::Commit() {
+  if (writer_ == NULL) return;
+  bool finished = writer_->finished();
+  delete writer_;
+  writer_ = NULL;
+  if (!finished || std::rename(tmp_.c_str(), path_.c_str()) != 0)
+    std::remove(tmp_.c_str());
+}
+
+}  // namespace graphillion
@@ -0,0 +1,83 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+#ifndef GRAPHILLION_DD_CACHE_H_
+#define GRAPHILLION_DD_CACHE_H_
+
+#include <string>
+
+#include "subsetting/DdStructure.hpp"
+
+namespace graphillion {
+
+// Reduced DDs of searches are kept in files named by a hash of a key that
+// describes the search, so that repeated searches across processes skip
+// the construction.  The key has to cover every input of the search.  Each
+// file also records the key and the library version, which are checked on
+// loading, so hash collisions and files of other versions are misses.
+
+// The directory is set by CacheDirectory() in graphset.h.
+
+// Checks if the cache is enabled.
+bool CacheEnabled();
+
+// Loads the DD cached for key into dd.  Returns false if the cache is
+// disabled, or if there is no valid file for key.
+bool LoadCachedDd(const std::string& key, tdzdd::DdStructure<2>* dd);
+
+// Saves dd for key if the cache is enabled.  Failures are ignored, since
+// the cache only saves time.
+void SaveCachedDd(const std::string& key, const tdzdd::DdStructure<2>& dd);
+
+// Saves a DD for key while it is reduced by zddReduceAndEvaluate():
+//
+//   CachedDdWriter cache(key);
+//   dd.zddReduceAndEvaluate(eval, cache.writer());
+//   cache.Commit();
+//
+// The file is published by Commit() only if it has been completed, and
+// removed otherwise.
+class CachedDdWriter {
+ public:
+  // An empty key or a disabled cache saves nothing.
+  explicit CachedDdWriter(const std::string& key);
+  ~CachedDdWriter();
+
+  // Returns the writer to be given to zddReduceAndEvaluate(), or NULL.
+  tdzdd::DdStructure<2>::Writer* writer() { return writer_; }
+
+  void Commit();
+
+ private:
+  CachedDdWriter(const CachedDdWriter&);
+  CachedDdWriter& operator=(const CachedDdWriter&);
+
+  std::string path_;
+  std::string tmp_;
+  tdzdd::DdStructure<2>::Writer* writer_;
+};
+
+}  // namespace graphillion
+
+#endif  // GRAPHILLION_DD_CACHE_H_
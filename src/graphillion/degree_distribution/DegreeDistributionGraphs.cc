@@ -21,35 +21,31 @@ constructDegreeDistributionGraphs(const tdzdd::Graph &g,
 
   tdzdd::DdStructure<2> dd;
   if (search_space != NULL) {
-    tdzdd::SapporoZdd f(*search_space, offset);
-    //dd = tdzdd::DdStructure<2>(f, use_mp);
-    dd = tdzdd::DdStructure<2>(f, false); // not use multi processors because
-                                          // SAPPOROBDDD is not thread safe
-    if (use_mp) {
-      dd.useMultiProcessors(true);
-    }
+    // SAPPOROBDD is not thread safe; it is only read while taking the
+    // snapshot, and the subsetting below runs on the copy.
+    dd = tdzdd::snapshotSapporoZdd(*search_space, offset, use_mp);
   } else {
     dd = tdzdd::DdStructure<2>(g.edgeSize(), use_mp);
   }
 
-  std::vector<tdzdd::IntSubset*> dr;
-
+  // the ranges are owned here so that an aborted search does not leak them
+  std::vector<tdzdd::IntRange> ranges;
   for (size_t i = 0; i < degRanges.size(); ++i) {
     if (degRanges[i] < 0) {
-      dr.push_back(new tdzdd::IntRange(0, g.vertexSize()));
+      ranges.push_back(tdzdd::IntRange(0, g.vertexSize()));
     } else {
-      dr.push_back(new tdzdd::IntRange(degRanges[i], degRanges[i]));
+      ranges.push_back(tdzdd::IntRange(degRanges[i], degRanges[i]));
     }
   }
+  std::vector<tdzdd::IntSubset*> dr;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    dr.push_back(&ranges[i]);
+  }
 
   DegreeDistributionSpec ddspec(g, dr, is_connected);
 
   dd.zddSubset(ddspec);
   dd.zddReduce();
-
-  for (size_t i = 0; i < dr.size(); ++i) {
-    delete dr[i];
-  }
   return dd;
 }
 
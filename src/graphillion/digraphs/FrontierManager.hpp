@@ -81,7 +81,7 @@ class FrontierManager {
         entered_vs.insert(e.v2);
       }
     }
-    assert(static_cast<int>(entered_vs.size()) == n);
+    assert(static_cast<int>(entered_vs.size()) == graph_.vertexSize());
 
     // compute leaving_vss_
     std::set<int> leaved_vs;
@@ -96,7 +96,7 @@ class FrontierManager {
         leaved_vs.insert(e.v2);
       }
     }
-    assert(static_cast<int>(leaved_vs.size()) == n);
+    assert(static_cast<int>(leaved_vs.size()) == graph_.vertexSize());
   }
 
   void construct() {
@@ -54,9 +54,8 @@ setset SearchForbiddenInducedSubgraphs(const std::vector<edge_t> &edges, setset*
 
   int offset =
       graphillion::setset::max_elem() - g.edgeSize();
-  tdzdd::SapporoZdd szdd(ss->zdd_, offset);
   auto new_dd = constructForbiddenInducedSubgraphs(g,
-    tdzdd::DdStructure<2>(szdd));
+    tdzdd::snapshotSapporoZdd(ss->zdd_, offset));
   return setset(new_dd);
 }
 }  // namespace graphillion
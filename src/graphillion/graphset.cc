@@ -24,13 +24,18 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "graphillion/graphset.h"
 
+#include <algorithm>
 #include <climits>
+#include <cmath>
 
 #include <set>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "subsetting/DdStructure.hpp"
 #include "subsetting/DdSpecOp.hpp"
+#include "subsetting/dd/PathCounter.hpp"
 #include "subsetting/eval/ToZBDD.hpp"
 #include "subsetting/spec/DegreeConstraint.hpp"
 #include "subsetting/spec/FrontierBasedSearch.hpp"
@@ -39,6 +44,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "subsetting/spec/SizeConstraint.hpp"
 #include "subsetting/util/Graph.hpp"
 
+#include "graphillion/dd_cache.h"
 #include "graphillion/setset.h"
 #include "graphillion/digraphs/FrontierDegreeSpecified.hpp"
 #include "graphillion/digraphs/FrontierDirectedHamiltonianCycle.hpp"
@@ -79,42 +85,128 @@ int Range::upperBound() const {
   return this->max_;
 }
 
-setset SearchGraphs(
-    const vector<edge_t>& graph,
+int Range::step() const {
+  return this->step_;
+}
+
+// Subsetting by several specs either runs one sweep per spec, each followed
+// by a reduction, or runs a single sweep over the product of the specs.  The
+// product saves the intermediate diagrams, but multiplies the states of the
+// final spec by those of the specs fused into it.  A cheap filter is thus
+// fused only if the bound of its states per node is small.
+static const double kMaxFusedWidth = 64;
+
+static double size_width(int num_edges, const Range& range) {
+  return std::min(range.upperBound(), num_edges) + 1;
+}
+
+static double degree_width(const Graph& g,
+                           const map<vertex_t, Range>& degree_constraints) {
+  int max_degree = 0;
+  for (map<vertex_t, Range>::const_iterator i = degree_constraints.begin();
+       i != degree_constraints.end(); ++i)
+    max_degree = std::max(max_degree, i->second.upperBound());
+  int frontier = std::min(static_cast<int>(degree_constraints.size()),
+                          static_cast<int>(g.maxFrontierSize()));
+  return std::pow(std::min(max_degree, g.edgeSize()) + 1.0, frontier);
+}
+
+// Counts the sets of spec, within search_space if given, level by level
+// without building the DD.
+template<typename S>
+static std::string count_with(const S& spec, const zdd_t* search_space,
+                              int num_edges) {
+  if (search_space == NULL) return countPathsMP(spec);
+  DdStructure<2> dd = snapshotSapporoZdd(*search_space,
+                                         setset::max_elem() - num_edges);
+  return countPathsMP(ZddIntersection<DdStructure<2>, S>(dd, spec));
+}
+
+// The specs are handed to an Op, which subsets a DD, estimates its size, or
+// counts its sets.  Filters that are not fused are applied by sweep().
+struct Subsetter {
+  DdStructure<2>& dd;
+  explicit Subsetter(DdStructure<2>& dd) : dd(dd) {}
+  template<typename S>
+  void operator()(const S& spec) { dd.zddSubset(spec); }
+  template<typename S>
+  void sweep(const S& spec) {
+    dd.zddSubset(spec);
+    dd.zddReduce();
+  }
+};
+
+// Estimates and counts are taken in one pass without a DD, so every filter
+// is fused for them.
+struct OnePass {
+  template<typename S>
+  void sweep(const S&) { assert(false); }
+};
+
+struct Estimator : OnePass {
+  size_t sample_size;
+  uint64_t seed;
+  SizeEstimate result;
+  Estimator(size_t sample_size, uint64_t seed)
+      : sample_size(sample_size), seed(seed) {}
+  template<typename S>
+  void operator()(const S& spec) {
+    S s(spec);
+    result = SizeEstimator<S>(s).estimate(sample_size, seed);
+  }
+};
+
+struct Counter : OnePass {
+  const zdd_t* search_space;
+  int num_edges;
+  std::string result;
+  Counter(const zdd_t* search_space, int num_edges)
+      : search_space(search_space), num_edges(num_edges) {}
+  template<typename S>
+  void operator()(const S& spec) {
+    result = count_with(spec, search_space, num_edges);
+  }
+};
+
+template<typename Op, typename S>
+static void subset_with(Op& op, const S& spec) {
+  op(spec);
+}
+
+template<typename Op, typename S1, typename S2, typename... SS>
+static void subset_with(Op& op, const S1& s1, const S2& s2, const SS&... ss) {
+  op(ZddIntersection<S1, S2, SS...>(s1, s2, ss...));
+}
+
+template<typename Op, typename... SS>
+static void subset_with_degree(Op& op, const DegreeConstraint* dc,
+                               const SS&... ss) {
+  if (dc != NULL)
+    subset_with(op, *dc, ss...);
+  else
+    subset_with(op, ss...);
+}
+
+template<typename Op, typename... SS>
+static void subset_with_size(Op& op, const SizeConstraint* sc,
+                             const DegreeConstraint* dc, const SS&... ss) {
+  if (sc != NULL)
+    subset_with_degree(op, dc, *sc, ss...);
+  else
+    subset_with_degree(op, dc, ss...);
+}
+
+// Hands the specs of SearchGraphs() to op.  The filters not fused into the
+// frontier-based search are swept by op beforehand, unless fuse_all is set.
+template<typename Op>
+static void graph_specs(
+    Op& op, bool fuse_all, Graph& g,
     const vector<vector<vertex_t> >* vertex_groups,
     const map<vertex_t, Range>* degree_constraints,
     const Range* num_edges,
     int num_comps,
     bool no_loop,
-    const setset* search_space,
     const vector<linear_constraint_t>* linear_constraints) {
-  //assert(static_cast<size_t>(setset::num_elems()) == graph.size());
-
-  Graph g;
-  for (vector<edge_t>::const_iterator e = graph.begin(); e != graph.end(); ++e)
-    g.addEdge(e->first, e->second);
-  g.update();
-  assert(static_cast<size_t>(g.edgeSize()) == graph.size());
-
-#ifdef _OPENMP
-  bool use_mp = (omp_get_num_procs() >= 2);
-#else
-  bool use_mp = false;
-#endif
-
-  DdStructure<2> dd;
-  if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    //dd = DdStructure<2>(f, use_mp);
-    dd = DdStructure<2>(f, false); // not use multi processors because
-                                   // SAPPOROBDDD is not thread safe
-    if (use_mp) {
-      dd.useMultiProcessors(true);
-    }
-  } else {
-    dd = DdStructure<2>(g.edgeSize(), use_mp);
-  }
-
   if (vertex_groups != NULL) {
     int color = 0;
     for (vector<vector<vertex_t> >::const_iterator i = vertex_groups->begin();
@@ -124,18 +216,33 @@ setset SearchGraphs(
     g.update();
   }
 
+  // Cheap filters are fused into the frontier-based search while the
+  // product of their state bounds stays small; the others run first, each
+  // reducing the DD that the next sweep visits.
+  double width = 1;
+  SizeConstraint sc(g.edgeSize(), num_edges);
+  bool fuse_sc = false;
+  if (num_edges != NULL) {
+    fuse_sc = fuse_all
+        || width * size_width(g.edgeSize(), *num_edges) <= kMaxFusedWidth;
+    if (fuse_sc) width *= size_width(g.edgeSize(), *num_edges);
+  }
+
   DegreeConstraint dc(g);
+  bool fuse_dc = false;
   if (degree_constraints != NULL) {
     for (map<vertex_t, Range>::const_iterator i = degree_constraints->begin();
          i != degree_constraints->end(); ++i)
       dc.setConstraint(i->first, &i->second);
-    dd.zddSubset(dc);
+    fuse_dc = fuse_all
+        || width * degree_width(g, *degree_constraints) <= kMaxFusedWidth;
+    if (!fuse_dc) op.sweep(dc);
   }
 
-  if (num_edges != NULL) {
-    SizeConstraint sc(g.edgeSize(), num_edges);
-    dd.zddSubset(sc);
-  }
+  if (num_edges != NULL && !fuse_sc) op.sweep(sc);
+
+  const SizeConstraint* fused_sc = fuse_sc ? &sc : NULL;
+  const DegreeConstraint* fused_dc = fuse_dc ? &dc : NULL;
 
   FrontierBasedSearch fbs(g, num_comps, no_loop);
 
@@ -153,19 +260,175 @@ setset SearchGraphs(
       lc.addConstraint(expr, i->second.first, i->second.second);
     }
     lc.update();
-    ZddIntersection<LinearConstraints<double>,FrontierBasedSearch> zi(lc, fbs);
-
-    dd.zddSubset(zi);
+    subset_with_size(op, fused_sc, fused_dc, lc, fbs);
   }
   else {
-    dd.zddSubset(fbs);
+    subset_with_size(op, fused_sc, fused_dc, fbs);
   }
+}
 
-  dd.useMultiProcessors(false);
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+// Describes the inputs of SearchGraphs() for the DD cache.  Strings are
+// prefixed with their lengths, so that different inputs never collide.
+static void write_key(std::ostream& os, const std::string& s) {
+  os << s.size() << ':' << s;
+}
+
+static void write_key(std::ostream& os, const Range& r) {
+  os << r.lowerBound() << ',' << r.upperBound() << ',' << r.step() << ';';
+}
+
+static std::string graphs_cache_key(
+    const vector<edge_t>& graph,
+    const vector<vector<vertex_t> >* vertex_groups,
+    const map<vertex_t, Range>* degree_constraints,
+    const Range* num_edges,
+    int num_comps,
+    bool no_loop,
+    const vector<linear_constraint_t>* linear_constraints) {
+  std::ostringstream key;
+  key.precision(17);
+  key << "graphs " << graph.size() << ':';
+  for (vector<edge_t>::const_iterator e = graph.begin(); e != graph.end(); ++e)
+    write_key(key, e->first), write_key(key, e->second);
+  if (vertex_groups != NULL) {
+    key << " groups " << vertex_groups->size() << ':';
+    for (vector<vector<vertex_t> >::const_iterator i = vertex_groups->begin();
+         i != vertex_groups->end(); ++i) {
+      key << i->size() << ':';
+      for (vector<vertex_t>::const_iterator v = i->begin(); v != i->end(); ++v)
+        write_key(key, *v);
+    }
+  }
+  if (degree_constraints != NULL) {
+    key << " degrees " << degree_constraints->size() << ':';
+    for (map<vertex_t, Range>::const_iterator i = degree_constraints->begin();
+         i != degree_constraints->end(); ++i)
+      write_key(key, i->first), write_key(key, i->second);
+  }
+  if (num_edges != NULL) {
+    key << " edges ";
+    write_key(key, *num_edges);
+  }
+  key << " comps " << num_comps << " noloop " << no_loop;
+  if (linear_constraints != NULL) {
+    key << " linear " << linear_constraints->size() << ':';
+    for (vector<linear_constraint_t>::const_iterator c =
+         linear_constraints->begin(); c != linear_constraints->end(); ++c) {
+      key << c->first.size() << ':';
+      for (vector<weighted_edge_t>::const_iterator w = c->first.begin();
+           w != c->first.end(); ++w) {
+        write_key(key, w->first.first), write_key(key, w->first.second);
+        key << w->second << ';';
+      }
+      key << c->second.first << ',' << c->second.second << ';';
+    }
+  }
+  return key.str();
+}
+
+setset SearchGraphs(
+    const vector<edge_t>& graph,
+    const vector<vector<vertex_t> >* vertex_groups,
+    const map<vertex_t, Range>* degree_constraints,
+    const Range* num_edges,
+    int num_comps,
+    bool no_loop,
+    const setset* search_space,
+    const vector<linear_constraint_t>* linear_constraints) {
+  //assert(static_cast<size_t>(setset::num_elems()) == graph.size());
+
+  Graph g;
+  for (vector<edge_t>::const_iterator e = graph.begin(); e != graph.end(); ++e)
+    g.addEdge(e->first, e->second);
+  g.update();
+  assert(static_cast<size_t>(g.edgeSize()) == graph.size());
+
+#ifdef _OPENMP
+  bool use_mp = (omp_get_num_procs() >= 2);
+#else
+  bool use_mp = false;
+#endif
+
+  // searches within a search space are not cached
+  std::string key;
+  if (search_space == NULL && CacheEnabled()) {
+    key = graphs_cache_key(graph, vertex_groups, degree_constraints,
+                           num_edges, num_comps, no_loop, linear_constraints);
+    DdStructure<2> cached;
+    if (LoadCachedDd(key, &cached)) {
+      cached.useMultiProcessors(use_mp);
+      return setset(cached.evaluate(
+          ToZBDD(setset::max_elem() - g.edgeSize())));
+    }
+  }
+
+  DdStructure<2> dd;
+  if (search_space != NULL) {
+    // SAPPOROBDD is not thread safe; it is only read while taking the
+    // snapshot, and the subsetting below runs on the copy.
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize(), use_mp);
+  } else {
+    dd = DdStructure<2>(g.edgeSize(), use_mp);
+  }
+
+  Subsetter op(dd);
+  graph_specs(op, false, g, vertex_groups, degree_constraints, num_edges,
+              num_comps, no_loop, linear_constraints);
+
+  CachedDdWriter cache(key);
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()),
+                                    cache.writer());
+  cache.Commit();
   return setset(f);
 }
 
+SizeEstimate EstimateGraphs(
+    const vector<edge_t>& graph,
+    const vector<vector<vertex_t> >* vertex_groups,
+    const map<vertex_t, Range>* degree_constraints,
+    const Range* num_edges,
+    int num_comps,
+    bool no_loop,
+    const vector<linear_constraint_t>* linear_constraints,
+    size_t sample_size,
+    uint64_t seed) {
+  Graph g;
+  for (vector<edge_t>::const_iterator e = graph.begin(); e != graph.end(); ++e)
+    g.addEdge(e->first, e->second);
+  g.update();
+  assert(static_cast<size_t>(g.edgeSize()) == graph.size());
+
+  Estimator op(sample_size, seed);
+  graph_specs(op, true, g, vertex_groups,
+              degree_constraints, num_edges, num_comps, no_loop,
+              linear_constraints);
+  return op.result;
+}
+
+std::string CountGraphs(
+    const vector<edge_t>& graph,
+    const vector<vector<vertex_t> >* vertex_groups,
+    const map<vertex_t, Range>* degree_constraints,
+    const Range* num_edges,
+    int num_comps,
+    bool no_loop,
+    const setset* search_space,
+    const vector<linear_constraint_t>* linear_constraints) {
+  Graph g;
+  for (vector<edge_t>::const_iterator e = graph.begin(); e != graph.end(); ++e)
+    g.addEdge(e->first, e->second);
+  g.update();
+  assert(static_cast<size_t>(g.edgeSize()) == graph.size());
+
+  Counter op(search_space != NULL ? &search_space->zdd_ : NULL,
+             g.edgeSize());
+  graph_specs(op, true, g, vertex_groups,
+              degree_constraints, num_edges, num_comps, no_loop,
+              linear_constraints);
+  return op.result;
+}
+
 setset SearchDirectedCycles(const std::vector<edge_t>& digraph,
                             const setset* search_space) {
   //assert(static_cast<size_t>(setset::num_elems()) == digraph.size());
@@ -179,17 +442,15 @@ setset SearchDirectedCycles(const std::vector<edge_t>& digraph,
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
 
   FrontierDirectedSingleCycleSpec spec(g);
   dd.zddSubset(spec);
-  dd.zddReduce();
-
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
@@ -206,17 +467,15 @@ setset SearchDirectedHamiltonianCycles(const std::vector<edge_t>& digraph,
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
 
   FrontierDirectedSingleHamiltonianCycleSpec spec(g);
   dd.zddSubset(spec);
-  dd.zddReduce();
-
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
@@ -234,8 +493,8 @@ setset SearchDirectedSTPath(const std::vector<edge_t>& digraph,
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
@@ -243,9 +502,7 @@ setset SearchDirectedSTPath(const std::vector<edge_t>& digraph,
   FrontierDirectedSTPathSpec spec(g, is_hamiltonian, g.getVertex(s),
                                   g.getVertex(t));
   dd.zddSubset(spec);
-  dd.zddReduce();
-
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
@@ -268,17 +525,15 @@ setset SearchDirectedForests(const std::vector<edge_t>& digraph,
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
 
   FrontierRootedForestSpec spec(g, roots_set, is_spanning);
   dd.zddSubset(spec);
-  dd.zddReduce();
-
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
@@ -295,17 +550,15 @@ setset SearchRootedTrees(const std::vector<edge_t>& digraph, vertex_t root,
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
 
   FrontierRootedTreeSpec spec(g, g.getVertex(root), is_spanning);
   dd.zddSubset(spec);
-  dd.zddReduce();
-
-  zdd_t f = dd.evaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
@@ -325,8 +578,8 @@ setset SearchDirectedGraphs(
 
   DdStructure<2> dd;
   if (search_space != NULL) {
-    SapporoZdd f(search_space->zdd_, setset::max_elem() - g.edgeSize());
-    dd = DdStructure<2>(f);
+    dd = snapshotSapporoZdd(search_space->zdd_,
+                            setset::max_elem() - g.edgeSize());
   } else {
     dd = DdStructure<2>(g.edgeSize());
   }
@@ -355,8 +608,105 @@ setset SearchDirectedGraphs(
   return setset(f);
 }
 
+static void build_digraph(const vector<edge_t>& digraph, Digraph* g) {
+  for (vector<edge_t>::const_iterator e = digraph.begin(); e != digraph.end();
+       ++e)
+    g->addEdge(e->first, e->second);
+  g->update();
+  assert(static_cast<size_t>(g->edgeSize()) == digraph.size());
+}
+
+std::string CountDirectedCycles(const std::vector<edge_t>& digraph,
+                                const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+  return count_with(FrontierDirectedSingleCycleSpec(g),
+                    search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
+std::string CountDirectedHamiltonianCycles(const std::vector<edge_t>& digraph,
+                                           const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+  return count_with(FrontierDirectedSingleHamiltonianCycleSpec(g),
+                    search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
+std::string CountDirectedSTPath(const std::vector<edge_t>& digraph,
+                                bool is_hamiltonian, vertex_t s, vertex_t t,
+                                const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+  return count_with(FrontierDirectedSTPathSpec(g, is_hamiltonian,
+                                               g.getVertex(s), g.getVertex(t)),
+                    search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
+std::string CountDirectedForests(const std::vector<edge_t>& digraph,
+                                 const std::vector<vertex_t>& roots,
+                                 bool is_spanning,
+                                 const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+  std::set<Digraph::VertexNumber> roots_set;
+  for (const auto& root : roots) {
+    roots_set.insert(g.getVertex(root));
+  }
+  return count_with(FrontierRootedForestSpec(g, roots_set, is_spanning),
+                    search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
+std::string CountRootedTrees(const std::vector<edge_t>& digraph,
+                             vertex_t root, bool is_spanning,
+                             const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+  return count_with(FrontierRootedTreeSpec(g, g.getVertex(root), is_spanning),
+                    search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
+std::string CountDirectedGraphs(
+    const std::vector<edge_t>& digraph,
+    const std::map<vertex_t, Range>* in_degree_constraints,
+    const std::map<vertex_t, Range>* out_degree_constraints,
+    const setset* search_space) {
+  Digraph g;
+  build_digraph(digraph, &g);
+
+  // both constraints are checked by one spec; it accepts any graph if
+  // neither is given
+  FrontierDegreeSpecifiedSpec dc(g);
+  if (in_degree_constraints != NULL) {
+    for (auto i = in_degree_constraints->begin();
+         i != in_degree_constraints->end(); ++i) {
+      dc.setIndegConstraint(g.getVertex(i->first), i->second);
+    }
+  }
+  if (out_degree_constraints != NULL) {
+    for (auto i = out_degree_constraints->begin();
+         i != out_degree_constraints->end(); ++i) {
+      dc.setOutdegConstraint(g.getVertex(i->first), i->second);
+    }
+  }
+  return count_with(dc, search_space != NULL ? &search_space->zdd_ : NULL,
+                    g.edgeSize());
+}
+
 bool ShowMessages(bool flag) {
   return MessageHandler::showMessages(flag);
 }
 
+size_t SpillBudget(size_t bytes) {
+  return DdBuilderBase::spillBudget(bytes);
+}
+
+bool PackStates(bool flag) {
+  return DdBuilderBase::packStates(flag);
+}
+
 }  // namespace graphillion
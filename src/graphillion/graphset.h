@@ -25,6 +25,9 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef GRAPHILLION_GRAPHSET_H_
 #define GRAPHILLION_GRAPHSET_H_
 
+#include "subsetting/dd/SizeEstimator.hpp"
+#include "subsetting/util/BuildControl.hpp"
+#include "subsetting/util/BuildMetrics.hpp"
 #include "subsetting/util/IntSubset.hpp"
 
 #include "graphillion/setset.h"
@@ -39,6 +42,7 @@ class Range : public tdzdd::IntSubset {
   bool contains(int x) const;
   int lowerBound() const;
   int upperBound() const;
+  int step() const;
 
  private:
   int min_;
@@ -46,6 +50,11 @@ class Range : public tdzdd::IntSubset {
   int step_;
 };
 
+// The Search* functions are limited and monitored by the
+// tdzdd::BuildControl activated with tdzdd::BuildControl::Scope on the
+// calling thread, if any; tdzdd::BuildAborted is thrown when it stops the
+// search.  Their DD operations are recorded by the tdzdd::BuildMetrics
+// activated with tdzdd::BuildMetrics::Scope, if any.
 setset SearchGraphs(
     const std::vector<edge_t>& graph,
     const std::vector<std::vector<vertex_t> >* vertex_groups = NULL,
@@ -56,6 +65,32 @@ setset SearchGraphs(
     const setset* search_space = NULL,
     const std::vector<linear_constraint_t>* linear_constraints = NULL);
 
+// Estimates the size of the DD built by SearchGraphs() over all the graphs
+// by sampling at most sample_size nodes per level; see tdzdd::SizeEstimator.
+tdzdd::SizeEstimate EstimateGraphs(
+    const std::vector<edge_t>& graph,
+    const std::vector<std::vector<vertex_t> >* vertex_groups = NULL,
+    const std::map<vertex_t, Range>* degree_constraints = NULL,
+    const Range* num_edges = NULL,
+    int num_comps = -1,
+    bool no_loop = false,
+    const std::vector<linear_constraint_t>* linear_constraints = NULL,
+    size_t sample_size = 1000,
+    uint64_t seed = 1);
+
+// Counts the graphs that SearchGraphs() would return without building the
+// DD; the levels are counted one by one with multiple threads and freed
+// after use.  The count is returned in decimal.
+std::string CountGraphs(
+    const std::vector<edge_t>& graph,
+    const std::vector<std::vector<vertex_t> >* vertex_groups = NULL,
+    const std::map<vertex_t, Range>* degree_constraints = NULL,
+    const Range* num_edges = NULL,
+    int num_comps = -1,
+    bool no_loop = false,
+    const setset* search_space = NULL,
+    const std::vector<linear_constraint_t>* linear_constraints = NULL);
+
 setset SearchDirectedCycles(const std::vector<edge_t>& digraph,
                             const setset* search_space);
 
@@ -79,8 +114,42 @@ setset SearchDirectedGraphs(
     const std::map<vertex_t, Range>* out_degree_constraints,
     const setset* search_space);
 
+// Count-only variants of the directed searches above; see CountGraphs().
+std::string CountDirectedCycles(const std::vector<edge_t>& digraph,
+                                const setset* search_space);
+
+std::string CountDirectedHamiltonianCycles(const std::vector<edge_t>& digraph,
+                                           const setset* search_space);
+
+std::string CountDirectedSTPath(const std::vector<edge_t>& digraph,
+                                bool is_hamiltonian, vertex_t s, vertex_t t,
+                                const setset* search_space);
+
+std::string CountDirectedForests(const std::vector<edge_t>& digraph,
+                                 const std::vector<vertex_t>& roots,
+                                 bool is_spanning, const setset* search_space);
+
+std::string CountRootedTrees(const std::vector<edge_t>& digraph,
+                             vertex_t root, bool is_spanning,
+                             const setset* search_space);
+
+std::string CountDirectedGraphs(
+    const std::vector<edge_t>& digraph,
+    const std::map<vertex_t, Range>* in_degree_constraints,
+    const std::map<vertex_t, Range>* out_degree_constraints,
+    const setset* search_space);
+
 bool ShowMessages(bool flag = true);
 
+size_t SpillBudget(size_t bytes);
+
+bool PackStates(bool flag);
+
+// Sets the directory of the cache of the DDs built by SearchGraphs() and
+// SearchPartitions(), which must exist; an empty string disables the cache
+// (initial setting).  Returns the previous directory.
+std::string CacheDirectory(const std::string& dir);
+
 }  // namespace graphillion
 
 #endif  // GRAPHILLION_GRAPHSET_H_
@@ -2,6 +2,7 @@
 #include "ConnectedInducedSubgraphSpec.h"
 
 #include "graphillion/graphset.h"
+#include "subsetting/dd/PathCounter.hpp"
 #include "subsetting/eval/ToZBDD.hpp"
 
 tdzdd::DdStructure<2> constructInducedGraphs(const tdzdd::Graph &g) {
@@ -33,5 +34,16 @@ setset SearchInducedGraphs(const std::vector<edge_t> &edges) {
   return setset(f);
 }
 
+std::string CountInducedGraphs(const std::vector<edge_t> &edges) {
+  tdzdd::Graph g;
+  for (const auto &e : edges) {
+    g.addEdge(e.first, e.second);
+  }
+  g.update();
+
+  ConnectedInducedSubgraphSpec scspec(g);
+  return tdzdd::countPathsMP(scspec);
+}
+
 }  // namespace graphillion
 
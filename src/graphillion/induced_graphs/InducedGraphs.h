@@ -15,6 +15,10 @@ tdzdd::DdStructure<2> constructInducedGraphs(const tdzdd::Graph &g);
 
 namespace graphillion {
 setset SearchInducedGraphs(const std::vector<edge_t> &edges);
+
+// Counts the connected induced graphs without building the DD; see
+// CountGraphs().
+std::string CountInducedGraphs(const std::vector<edge_t> &edges);
 }  // namespace graphillion
 
 #endif  // GRAPHILLION_INDUCED_GRAPHS_H_
@@ -20,10 +20,9 @@ setset SearchWeightedInducedGraphs(
   ComponentWeightInducedSpec cwispec(g, convert_weight_list<uint32_t>(g, weight_list),
                                      lower, upper);
   dd.zddSubset(cwispec);
-  dd.zddReduce();
-  dd.useMultiProcessors(false);
 
-  auto f = dd.evaluate(tdzdd::ToZBDD(setset::max_elem() - g.edgeSize()));
+  auto f = dd.zddReduceAndEvaluate(
+      tdzdd::ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 }  // namespace graphillion
@@ -45,10 +45,9 @@ setset SearchOddEdgeSubgraphs(const std::vector<edge_t>& edges) {
 
   OddEdgeSubgraphSpec spec(g);
   auto dd = tdzdd::DdStructure<2>(spec, use_mp);
-  dd.zddReduce();
 
-  dd.useMultiProcessors(false);
-  zdd_t f = dd.evaluate(tdzdd::ToZBDD(setset::max_elem() - g.edgeSize()));
+  zdd_t f = dd.zddReduceAndEvaluate(
+      tdzdd::ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 }  // namespace graphillion
@@ -0,0 +1,364 @@
+/*
+ * EdgeOrdering: Ordering edges to keep the frontier of the
+ * frontier-based search small
+ */
+
+#include "EdgeOrdering.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+using graphillion::FrontierCost;
+using std::pair;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+const int kMaxBeamWidth = 64;
+const int kTabuTenure = 7;
+const int kMoveWindow = 16;
+// Edge steps spent by a search, so that its result does not depend on the
+// speed of the machine; half of them go to the wider beams.
+const long long kWorkBudget = 100000000;
+
+class FrontierOrderer {
+ public:
+  FrontierOrderer(int num_vertices, const vector<pair<int, int> >& edges,
+                  bool minimize_sum)
+      : n_(num_vertices), edges_(edges), incident_(num_vertices),
+        minimize_sum_(minimize_sum), touched_(num_vertices),
+        remaining_(num_vertices), work_(0) {
+    for (int e = 0; e < static_cast<int>(edges.size()); ++e) {
+      assert(0 <= edges[e].first && edges[e].first < n_);
+      assert(0 <= edges[e].second && edges[e].second < n_);
+      incident_[edges[e].first].push_back(e);
+      if (edges[e].second != edges[e].first)
+        incident_[edges[e].second].push_back(e);
+    }
+    std::mt19937_64 rng(num_vertices);
+    for (int v = 0; v < n_; ++v) zobrist_.push_back(rng());
+  }
+
+  FrontierCost Evaluate(const vector<int>& order) {
+    std::fill(touched_.begin(), touched_.end(), 0);
+    for (int v = 0; v < n_; ++v)
+      remaining_[v] = incident_[v].size();
+    FrontierCost cost = {0, 0};
+    int frontier = 0;
+    work_ += order.size();
+    for (vector<int>::const_iterator e = order.begin(); e != order.end();
+         ++e) {
+      int u = edges_[*e].first;
+      int v = edges_[*e].second;
+      if (!touched_[u]) touched_[u] = 1, ++frontier;
+      if (!touched_[v]) touched_[v] = 1, ++frontier;
+      cost.max = std::max(cost.max, frontier);
+      cost.sum += frontier;
+      if (--remaining_[u] == 0) --frontier;
+      if (v != u && --remaining_[v] == 0) --frontier;
+    }
+    return cost;
+  }
+
+  bool Better(const FrontierCost& a, const FrontierCost& b) const {
+    if (minimize_sum_ && a.sum != b.sum) return a.sum < b.sum;
+    if (a.max != b.max) return a.max < b.max;
+    return a.sum < b.sum;
+  }
+
+  vector<int> Run(int source, double time_limit) {
+    Clock::time_point start = Clock::now();
+    Clock::duration budget = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(std::max(time_limit, 0.0)));
+
+    vector<int> best;
+    Beam(1, source, Clock::time_point::max(), &best);
+    FrontierCost best_cost = Evaluate(best);
+    vector<int> given(edges_.size());
+    for (int e = 0; e < static_cast<int>(given.size()); ++e) given[e] = e;
+    FrontierCost given_cost = Evaluate(given);
+    if (Better(given_cost, best_cost)) {
+      best.swap(given);
+      best_cost = given_cost;
+    }
+
+    // wider beams while half of the budget remains
+    deadline_ = start + budget / 2;
+    for (int width = 2; width <= kMaxBeamWidth; width *= 2) {
+      vector<int> order;
+      if (work_ >= kWorkBudget / 2 || Clock::now() >= deadline_
+          || !Beam(width, source, deadline_, &order))
+        break;
+      FrontierCost cost = Evaluate(order);
+      if (Better(cost, best_cost)) {
+        best.swap(order);
+        best_cost = cost;
+      }
+    }
+
+    deadline_ = start + budget;
+    Improve(&best, &best_cost);
+    return best;
+  }
+
+ private:
+  struct State {
+    vector<char> placed;
+    vector<int> remaining;  // unprocessed edges of each vertex
+    vector<int> active;     // placed vertices, possibly with no edges left
+    int frontier;
+    FrontierCost cost;
+    vector<int> order;
+    unsigned long long hash;
+  };
+
+  struct Child {
+    int parent;
+    int vertex;
+    FrontierCost cost;
+    int frontier;
+  };
+
+  // Edges from u to placed vertices, those finishing a vertex first.
+  void PlacedEdges(const State& s, int u, vector<int>* edges) const {
+    edges->clear();
+    for (vector<int>::const_iterator e = incident_[u].begin();
+         e != incident_[u].end(); ++e) {
+      int v = Other(*e, u);
+      if (v == u || s.placed[v]) edges->push_back(*e);
+    }
+    std::sort(edges->begin(), edges->end(), RemainingLess(*this, s, u));
+  }
+
+  struct RemainingLess {
+    const FrontierOrderer& o;
+    const State& s;
+    int u;
+    RemainingLess(const FrontierOrderer& o, const State& s, int u)
+        : o(o), s(s), u(u) {}
+    bool operator()(int a, int b) const {
+      int ra = s.remaining[o.Other(a, u)];
+      int rb = s.remaining[o.Other(b, u)];
+      return ra != rb ? ra < rb : a < b;
+    }
+  };
+
+  int Other(int e, int u) const {
+    return edges_[e].first == u ? edges_[e].second : edges_[e].first;
+  }
+
+  // Places u in s, or only computes the result if apply is false.
+  Child Place(State& s, int u, const vector<int>& edges, bool apply) {
+    Child c = {-1, u, s.cost, s.frontier};
+    int rest_u = incident_[u].size();
+    work_ += edges.size() + 1;
+    bool on = false;
+    for (vector<int>::const_iterator e = edges.begin(); e != edges.end();
+         ++e) {
+      int v = Other(*e, u);
+      if (!on) on = true, ++c.frontier;
+      if (v != u && s.remaining[v] == static_cast<int>(incident_[v].size()))
+        ++c.frontier;
+      c.cost.max = std::max(c.cost.max, c.frontier);
+      c.cost.sum += c.frontier;
+      if (--rest_u == 0) --c.frontier;
+      if (v != u && --s.remaining[v] == 0) --c.frontier;
+    }
+    if (apply) {
+      s.placed[u] = 1;
+      s.remaining[u] = rest_u;
+      if (rest_u > 0) s.active.push_back(u);
+      s.frontier = c.frontier;
+      s.cost = c.cost;
+      s.order.insert(s.order.end(), edges.begin(), edges.end());
+      s.hash ^= zobrist_[u];
+    } else {
+      for (vector<int>::const_iterator e = edges.begin(); e != edges.end();
+           ++e) {
+        int v = Other(*e, u);
+        if (v != u) ++s.remaining[v];
+      }
+    }
+    return c;
+  }
+
+  // The first vertex of a new component: the source, or the one with the
+  // fewest edges.
+  int StartVertex(const State& s, int source) const {
+    if (0 <= source && source < n_ && !s.placed[source]
+        && !incident_[source].empty())
+      return source;
+    int start = -1;
+    for (int v = 0; v < n_; ++v) {
+      if (s.placed[v] || incident_[v].empty()) continue;
+      if (start < 0 || incident_[v].size() < incident_[start].size())
+        start = v;
+    }
+    return start;
+  }
+
+  // Beam search over vertex orders; returns false if half of the work
+  // budget is spent or the deadline passes.
+  bool Beam(int width, int source, Clock::time_point deadline,
+            vector<int>* order) {
+    vector<State> beam(1);
+    beam[0].placed.assign(n_, 0);
+    beam[0].remaining.assign(n_, 0);
+    beam[0].frontier = 0;
+    beam[0].cost.max = 0;
+    beam[0].cost.sum = 0;
+    beam[0].hash = 0;
+    int steps = 0;
+    for (int v = 0; v < n_; ++v) {
+      beam[0].remaining[v] = incident_[v].size();
+      if (!incident_[v].empty()) ++steps;
+    }
+
+    vector<int> edges;
+    vector<int> mark(n_, -1);
+    for (int step = 0; step < steps; ++step) {
+      if (width > 1
+          && (work_ >= kWorkBudget / 2 || Clock::now() >= deadline))
+        return false;
+
+      vector<Child> children;
+      for (int k = 0; k < static_cast<int>(beam.size()); ++k) {
+        State& s = beam[k];
+        vector<int> candidates;
+        size_t a = 0;
+        for (size_t b = 0; b < s.active.size(); ++b) {
+          int v = s.active[b];
+          if (s.remaining[v] == 0) continue;
+          s.active[a++] = v;
+          for (vector<int>::const_iterator e = incident_[v].begin();
+               e != incident_[v].end(); ++e) {
+            int w = Other(*e, v);
+            if (!s.placed[w] && mark[w] != step * kMaxBeamWidth + k) {
+              mark[w] = step * kMaxBeamWidth + k;
+              candidates.push_back(w);
+            }
+          }
+        }
+        s.active.resize(a);
+        if (candidates.empty()) candidates.push_back(StartVertex(s, source));
+        for (vector<int>::const_iterator u = candidates.begin();
+             u != candidates.end(); ++u) {
+          PlacedEdges(s, *u, &edges);
+          Child c = Place(s, *u, edges, false);
+          c.parent = k;
+          children.push_back(c);
+        }
+      }
+
+      std::stable_sort(children.begin(), children.end(), ChildLess(*this));
+      vector<State> next;
+      std::unordered_set<unsigned long long> seen;
+      for (vector<Child>::const_iterator c = children.begin();
+           c != children.end() && static_cast<int>(next.size()) < width;
+           ++c) {
+        const State& parent = beam[c->parent];
+        if (!seen.insert(parent.hash ^ zobrist_[c->vertex]).second) continue;
+        next.push_back(parent);
+        PlacedEdges(next.back(), c->vertex, &edges);
+        Place(next.back(), c->vertex, edges, true);
+      }
+      beam.swap(next);
+    }
+
+    *order = beam[0].order;
+    return true;
+  }
+
+  struct ChildLess {
+    const FrontierOrderer& o;
+    explicit ChildLess(const FrontierOrderer& o) : o(o) {}
+    bool operator()(const Child& a, const Child& b) const {
+      if (o.minimize_sum_ ? a.cost.sum != b.cost.sum
+                          : a.cost.max != b.cost.max)
+        return o.Better(a.cost, b.cost);
+      if (a.frontier != b.frontier) return a.frontier < b.frontier;
+      return o.Better(a.cost, b.cost);
+    }
+  };
+
+  // Tabu search moving one edge at a time within a window; moves that do
+  // not worsen the order are taken, and a moved edge stays put for a while.
+  // It stops when it settles or the work budget is spent, or at the latest
+  // when the deadline passes.
+  void Improve(vector<int>* best, FrontierCost* best_cost) {
+    int m = best->size();
+    if (m < 3) return;
+    std::mt19937 rng(m);
+    vector<int> order = *best;
+    FrontierCost cost = *best_cost;
+    vector<long> tabu(m, -1);
+    int window = std::min(m - 1, kMoveWindow);
+    long last = 0;
+    for (long it = 0; it - last < 20L * m; ++it) {
+      if (work_ >= kWorkBudget) break;
+      if ((it & 63) == 0 && Clock::now() >= deadline_) break;
+      int i = rng() % m;
+      int e = order[i];
+      if (tabu[e] > it) continue;
+      int j = i + static_cast<int>(rng() % (2 * window + 1)) - window;
+      if (j < 0 || j >= m || j == i) continue;
+      Move(&order, i, j);
+      FrontierCost c = Evaluate(order);
+      if (Better(cost, c)) {
+        Move(&order, j, i);
+        continue;
+      }
+      cost = c;
+      tabu[e] = it + kTabuTenure;
+      if (Better(c, *best_cost)) {
+        *best = order;
+        *best_cost = c;
+        last = it;
+      }
+    }
+  }
+
+  static void Move(vector<int>* order, int i, int j) {
+    if (i < j)
+      std::rotate(order->begin() + i, order->begin() + i + 1,
+                  order->begin() + j + 1);
+    else
+      std::rotate(order->begin() + j, order->begin() + i,
+                  order->begin() + i + 1);
+  }
+
+  int n_;
+  const vector<pair<int, int> >& edges_;
+  vector<vector<int> > incident_;
+  bool minimize_sum_;
+  vector<unsigned long long> zobrist_;
+  vector<char> touched_;
+  vector<int> remaining_;
+  long long work_;  // edge steps spent so far
+  Clock::time_point deadline_;
+};
+
+}  // namespace
+
+namespace graphillion {
+
+FrontierCost EvaluateEdgeOrder(
+    int num_vertices, const std::vector<std::pair<int, int> >& edges,
+    const std::vector<int>& order) {
+  return FrontierOrderer(num_vertices, edges, false).Evaluate(order);
+}
+
+std::vector<int> OrderEdgesByFrontier(
+    int num_vertices, const std::vector<std::pair<int, int> >& edges,
+    int source, bool minimize_sum, double time_limit) {
+  if (edges.empty()) return std::vector<int>();
+  return FrontierOrderer(num_vertices, edges, minimize_sum)
+      .Run(source, time_limit);
+}
+
+}  // namespace graphillion
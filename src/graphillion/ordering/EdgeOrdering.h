@@ -0,0 +1,40 @@
+/*
+ * EdgeOrdering: Ordering edges to keep the frontier of the
+ * frontier-based search small
+ */
+
+#ifndef GRAPHILLION_EDGE_ORDERING_H_
+#define GRAPHILLION_EDGE_ORDERING_H_
+
+#include <utility>
+#include <vector>
+
+namespace graphillion {
+
+// The frontier after processing an edge consists of the vertices that have
+// both processed and unprocessed edges, including the endpoints of the edge.
+// Its size bounds the number of states at the edge's level.
+struct FrontierCost {
+  int max;   // the largest frontier
+  long sum;  // the total of the frontiers
+};
+
+FrontierCost EvaluateEdgeOrder(
+    int num_vertices, const std::vector<std::pair<int, int> >& edges,
+    const std::vector<int>& order);
+
+// Returns a permutation of edge indices for vertices numbered from 0 to
+// num_vertices - 1.  A beam search over vertex orders (a path decomposition
+// heuristic) with widening beams gives the initial order, or the given order
+// if it is better, which is then improved by a tabu search moving single
+// edges.  The maximum frontier is minimized first unless minimize_sum is
+// true.  The search stops when it settles or after a fixed amount of work,
+// so the order is reproducible; time_limit seconds only bound it on slow
+// machines.  source is the first vertex if not negative.
+std::vector<int> OrderEdgesByFrontier(
+    int num_vertices, const std::vector<std::pair<int, int> >& edges,
+    int source = -1, bool minimize_sum = false, double time_limit = 1.0);
+
+}  // namespace graphillion
+
+#endif  // GRAPHILLION_EDGE_ORDERING_H_
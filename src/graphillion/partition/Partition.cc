@@ -1,7 +1,11 @@
 #include "Partition.h"
 
+#include <sstream>
+
 #include "GraphRangePartitionSpec.h"
+#include "graphillion/dd_cache.h"
 #include "graphillion/graphset.h"
+#include "subsetting/dd/PathCounter.hpp"
 #include "subsetting/eval/ToZBDD.hpp"
 
 tdzdd::DdStructure<2> constructPartitionDd(const tdzdd::Graph &g,
@@ -24,10 +28,53 @@ setset SearchPartitions(const std::vector<edge_t> &edges, int16_t comp_lb,
   }
   g.update();
 
-  auto dd = constructPartitionDd(g, comp_lb, comp_ub);
+  std::string key;
+  tdzdd::DdStructure<2> dd;
+  if (CacheEnabled()) {
+    std::ostringstream os;
+    os << "partitions " << edges.size() << ':';
+    for (const auto &e : edges) {
+      os << e.first.size() << ':' << e.first << e.second.size() << ':'
+         << e.second;
+    }
+    os << ' ' << comp_lb << ',' << comp_ub;
+    key = os.str();
+  }
+  if (key.empty() || !LoadCachedDd(key, &dd)) {
+    dd = constructPartitionDd(g, comp_lb, comp_ub);
+    if (!key.empty()) SaveCachedDd(key, dd);
+  }
   dd.useMultiProcessors(false);
   zdd_t f = dd.evaluate(tdzdd::ToZBDD(setset::max_elem() - g.edgeSize()));
   return setset(f);
 }
 
+tdzdd::SizeEstimate EstimatePartitions(const std::vector<edge_t> &edges,
+                                       int16_t comp_lb, int16_t comp_ub,
+                                       size_t sample_size, uint64_t seed) {
+  tdzdd::Graph g;
+  for (const auto &e : edges) {
+    g.addEdge(e.first, e.second);
+  }
+  g.update();
+
+  constexpr bool is_noloop = false;
+  GraphPartitionSpec gpspec(g, comp_lb, comp_ub, is_noloop, true, false);
+  return tdzdd::SizeEstimator<GraphPartitionSpec>(gpspec).estimate(
+      sample_size, seed);
+}
+
+std::string CountPartitions(const std::vector<edge_t> &edges, int16_t comp_lb,
+                            int16_t comp_ub) {
+  tdzdd::Graph g;
+  for (const auto &e : edges) {
+    g.addEdge(e.first, e.second);
+  }
+  g.update();
+
+  constexpr bool is_noloop = false;
+  GraphPartitionSpec gpspec(g, comp_lb, comp_ub, is_noloop, true, false);
+  return tdzdd::countPathsMP(gpspec);
+}
+
 }  // namespace graphillion
@@ -6,6 +6,7 @@
 #include "graphillion/setset.h"
 #include "graphillion/type.h"
 #include "subsetting/DdStructure.hpp"
+#include "subsetting/dd/SizeEstimator.hpp"
 #include "subsetting/util/Graph.hpp"
 
 /**
@@ -25,6 +26,15 @@ namespace graphillion {
 setset SearchPartitions(const std::vector<edge_t> &edges, int16_t comp_lb,
                         int16_t comp_ub);
 
+tdzdd::SizeEstimate EstimatePartitions(const std::vector<edge_t> &edges,
+                                       int16_t comp_lb, int16_t comp_ub,
+                                       size_t sample_size = 1000,
+                                       uint64_t seed = 1);
+
+// Counts the partitions without building the DD; see CountGraphs().
+std::string CountPartitions(const std::vector<edge_t> &edges, int16_t comp_lb,
+                            int16_t comp_ub);
+
 }  // namespace graphillion
 
 #endif  // GRAPHILLION_PARTITION_H_
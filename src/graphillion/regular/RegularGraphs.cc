@@ -289,13 +289,9 @@ constructRegularGraphs(const tdzdd::Graph &g,
 
   tdzdd::DdStructure<2> dd;
   if (search_space != NULL) {
-    tdzdd::SapporoZdd f(*search_space, offset);
-    //dd = tdzdd::DdStructure<2>(f, use_mp);
-    dd = tdzdd::DdStructure<2>(f, false); // not use multi processors because
-                                          // SAPPOROBDDD is not thread safe
-    if (use_mp) {
-      dd.useMultiProcessors(true);
-    }
+    // SAPPOROBDD is not thread safe; it is only read while taking the
+    // snapshot, and the subsetting below runs on the copy.
+    dd = tdzdd::snapshotSapporoZdd(*search_space, offset, use_mp);
   } else {
     dd = tdzdd::DdStructure<2>(g.edgeSize(), use_mp);
   }
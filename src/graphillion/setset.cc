@@ -24,13 +24,16 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "graphillion/setset.h"
 
+#include <climits>
 #include <cstdlib>
 
 #include <algorithm>
+#include <stdexcept>
 
 #include "subsetting/dd/PathCounter.hpp"
 #include "subsetting/spec/SapporoZdd.hpp"
 
+#include "graphillion/cost_query.h"
 #include "graphillion/zdd.h"
 
 #include "subsetting/spec/SapporoZdd.hpp"
@@ -388,12 +391,26 @@ setset setset::smaller(size_t set_size) const {
 }
 
 setset setset::larger(size_t set_size) const {
-  return setset(this->zdd_ - this->zdd_.PermitSym(set_size));
+  return this->size_between(set_size + 1, INT_MAX);
 }
 
 setset setset::set_size(size_t set_size) const {
-  zdd_t z = this->zdd_.PermitSym(set_size) - this->zdd_.PermitSym(set_size - 1);
-  return setset(z);
+  return this->size_between(set_size, set_size);
+}
+
+setset setset::size_between(size_t lower, size_t upper) const {
+  if (lower > INT_MAX) return setset();
+  if (upper > INT_MAX) upper = INT_MAX;
+  return setset(graphillion::size_between(this->zdd_, lower, upper));
+}
+
+map<size_t, string> setset::size_dist() const {
+  // every element costs one, so the cost of a set is its size
+  BDDCT bddct;
+  bddct.Alloc(BDD_VarUsed());
+  map<bddcost, string> dist;
+  bddct.CostDist(this->zdd_, dist);
+  return map<size_t, string>(dist.begin(), dist.end());
 }
 
 setset setset::join(const setset& ss) const {
@@ -434,19 +451,164 @@ setset setset::non_supersets(elem_t e) const {
   return setset(this->zdd_ % setset(s).zdd_);
 }
 
-setset setset::cost_le(const std::vector<bddcost>& costs, const bddcost cost_bound) const {
-  assert(static_cast<graphillion::elem_t>(costs.size()) == num_elems());
-  BDDCT bddct;
-  //bddct.Alloc(costs.size());
-  bddct.Alloc(BDD_VarUsed()); // We should set n to be the number of used vars.
-  for (size_t i = 0; i < costs.size(); ++i) {
-    bddvar var = i + 1;
-    bddct.SetCostOfLev(BDD_LevOfVar(var), costs[i]);
+// Fills a BDDCT with the given costs, clearing its caches.
+static void set_cost_table(const vector<vector<bddcost> >& costs,
+                           BDDCT* bddct) {
+  // We should set n to be the number of used vars.
+  bddct->AllocDim(BDD_VarUsed(), costs.size());
+  for (size_t d = 0; d < costs.size(); ++d) {
+    for (size_t i = 0; i < costs[d].size(); ++i) {
+      bddvar var = i + 1;
+      bddct->SetCostOfLev(BDD_LevOfVar(var), d, costs[d][i]);
+    }
+  }
+}
+
+// Costs come from Python for the elements of one universe, which may be
+// fewer than num_elems(); costs for unknown elements are rejected rather
+// than written out of range.
+static void check_costs(const vector<bddcost>& costs) {
+  if (static_cast<elem_t>(costs.size()) > setset::num_elems())
+    throw std::invalid_argument("costs given for unknown elements");
+}
+
+// The weights of cost_query are indexed by elements, from 1.
+static vector<double> cost_weights(const vector<bddcost>& costs) {
+  vector<double> weights(1, 0);
+  weights.insert(weights.end(), costs.begin(), costs.end());
+  return weights;
+}
+
+setset::cost_context::cost_context(const vector<bddcost>& costs)
+    : costs_(costs), num_vars_(-1), query_(cost_weights(costs)) {
+  check_costs(costs);
+}
+
+// The cost table is indexed by levels, which move when new elements are
+// created; it is rebuilt, dropping the caches, if that has happened.
+BDDCT& setset::cost_context::table() {
+  if (this->num_vars_ != BDD_VarUsed()) {
+    set_cost_table(vector<vector<bddcost> >(1, this->costs_), &this->bddct_);
+    this->num_vars_ = BDD_VarUsed();
   }
-  zdd_t valid_cost_zdd = bddct.ZBDD_CostLE(this->zdd_, cost_bound);
+  return this->bddct_;
+}
+
+setset setset::cost_context::le(const setset& ss, bddcost cost_bound) {
+  return setset(this->table().ZBDD_CostLE(ss.zdd_, cost_bound));
+}
+
+setset setset::cost_context::between(const setset& ss, bddcost lower,
+                                     bddcost upper) {
+  return setset(this->table().ZBDD_CostBetween(ss.zdd_, lower, upper));
+}
+
+map<bddcost, string> setset::cost_context::dist(const setset& ss,
+                                                bddcost max_cost) {
+  map<bddcost, string> dist;
+  this->table().CostDist(ss.zdd_, dist, max_cost);
+  return dist;
+}
+
+double setset::cost_context::min_cost(const setset& ss) {
+  return this->query_.min(ss.zdd_);
+}
+
+double setset::cost_context::max_cost(const setset& ss) {
+  return this->query_.max(ss.zdd_);
+}
+
+set<elem_t> setset::cost_context::argmin(const setset& ss) {
+  set<elem_t> s;
+  this->query_.argmin(ss.zdd_, &s);
+  return s;
+}
+
+set<elem_t> setset::cost_context::argmax(const setset& ss) {
+  set<elem_t> s;
+  this->query_.argmax(ss.zdd_, &s);
+  return s;
+}
+
+setset setset::cost_context::min_cost_sets(const setset& ss) {
+  return setset(this->query_.min_sets(ss.zdd_));
+}
+
+setset setset::cost_context::max_cost_sets(const setset& ss) {
+  return setset(this->query_.max_sets(ss.zdd_));
+}
+
+setset setset::cost_le(const vector<bddcost>& costs, const bddcost cost_bound) const {
+  return cost_context(costs).le(*this, cost_bound);
+}
+
+setset setset::cost_le(const vector<vector<bddcost> >& costs,
+                       const vector<bddcost>& cost_bounds) const {
+  if (costs.empty() || costs.size() != cost_bounds.size())
+    throw std::invalid_argument("costs and cost bounds differ in dimension");
+  for (size_t d = 0; d < costs.size(); ++d)
+    check_costs(costs[d]);
+  BDDCT bddct;
+  set_cost_table(costs, &bddct);
+  zdd_t valid_cost_zdd = bddct.ZBDD_CostLEV(this->zdd_, cost_bounds);
   return setset(valid_cost_zdd);
 }
 
+setset setset::cost_between(const vector<bddcost>& costs,
+                            const bddcost lower, const bddcost upper) const {
+  return cost_context(costs).between(*this, lower, upper);
+}
+
+map<bddcost, string> setset::cost_dist(const vector<bddcost>& costs,
+                                       const bddcost max_cost) const {
+  return cost_context(costs).dist(*this, max_cost);
+}
+
+map<bddcost, double> setset::cost_dist(const vector<bddcost>& costs,
+                                       const vector<double>& probabilities,
+                                       const bddcost max_cost) const {
+  check_costs(costs);
+  if (static_cast<elem_t>(probabilities.size()) > num_elems() + 1)
+    throw std::invalid_argument("probabilities given for unknown elements");
+  BDDCT bddct;
+  set_cost_table(vector<vector<bddcost> >(1, costs), &bddct);
+  // BDDCT indexes elements by level, like SetCostOfLev().
+  vector<double> p(bddct.Size(), 0);
+  for (size_t e = 1; e < probabilities.size(); ++e)
+    p[bddct.Size() - BDD_LevOfVar(e)] = probabilities[e];
+  map<bddcost, double> dist;
+  bddct.CostDistProb(this->zdd_, p, dist, max_cost);
+  return dist;
+}
+
+double setset::min_cost(const vector<double>& weights) const {
+  return cost_query(weights).min(this->zdd_);
+}
+
+double setset::max_cost(const vector<double>& weights) const {
+  return cost_query(weights).max(this->zdd_);
+}
+
+set<elem_t> setset::argmin(const vector<double>& weights) const {
+  set<elem_t> s;
+  cost_query(weights).argmin(this->zdd_, &s);
+  return s;
+}
+
+set<elem_t> setset::argmax(const vector<double>& weights) const {
+  set<elem_t> s;
+  cost_query(weights).argmax(this->zdd_, &s);
+  return s;
+}
+
+setset setset::min_cost_sets(const vector<double>& weights) const {
+  return setset(cost_query(weights).min_sets(this->zdd_));
+}
+
+setset setset::max_cost_sets(const vector<double>& weights) const {
+  return setset(cost_query(weights).max_sets(this->zdd_));
+}
+
 setset setset::remove_some_element() const {
   return setset(graphillion::remove_some_element(this->zdd_));
 }
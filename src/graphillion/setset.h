@@ -36,6 +36,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "graphillion/type.h"
 
 #include "SAPPOROBDD/BDDCT.h"
+#include "graphillion/cost_query.h"
 #include "subsetting/DdStructure.hpp"
 #include "subsetting/util/Graph.hpp"
 #include "graphillion/variable_converter/variable_converter.h"
@@ -103,6 +104,42 @@ class setset {
     std::vector<double> weights_;
   };
 
+  // Cost queries sharing one cost vector.  Per-node results are kept in the
+  // context between its queries, so sweeps over bounds on the same or
+  // overlapping families reuse them; they are dropped after a garbage
+  // collection, and those of le/between/dist also when new elements are
+  // created.  A context is not thread-safe, and neither is the ZDD package
+  // it reads.
+  class cost_context {
+   public:
+    // costs[i] is the cost of element i + 1, as in cost_le()
+    explicit cost_context(const std::vector<bddcost>& costs);
+
+    setset le(const setset& ss, bddcost cost_bound);
+    setset between(const setset& ss, bddcost lower, bddcost upper);
+    std::map<bddcost, std::string> dist(const setset& ss,
+                                        bddcost max_cost = bddcost_null);
+
+    // the costs taken as weights, as in min_cost() and so on
+    double min_cost(const setset& ss);
+    double max_cost(const setset& ss);
+    std::set<elem_t> argmin(const setset& ss);
+    std::set<elem_t> argmax(const setset& ss);
+    setset min_cost_sets(const setset& ss);
+    setset max_cost_sets(const setset& ss);
+
+   private:
+    cost_context(const cost_context&);
+    void operator=(const cost_context&);
+
+    BDDCT& table();
+
+    std::vector<bddcost> costs_;
+    BDDCT bddct_;
+    int num_vars_;
+    cost_query query_;
+  };
+
   setset();
   setset(const setset& ss) : zdd_(ss.zdd_) {}
   explicit setset(const std::vector<std::set<elem_t> >& v);
@@ -164,6 +201,8 @@ class setset {
   setset smaller(size_t set_size) const;
   setset larger(size_t set_size) const;
   setset set_size(size_t set_size) const;
+  setset size_between(size_t lower, size_t upper) const;
+  std::map<size_t, std::string> size_dist() const;
 
   setset join(const setset& ss) const;
   setset meet(const setset& ss) const;
@@ -174,6 +213,23 @@ class setset {
   setset non_supersets(const setset& ss) const;
   setset non_supersets(elem_t e) const;
   setset cost_le(const std::vector<bddcost>& costs, const bddcost cost_bound) const;
+  setset cost_le(const std::vector<std::vector<bddcost> >& costs,
+                 const std::vector<bddcost>& cost_bounds) const;
+  setset cost_between(const std::vector<bddcost>& costs, const bddcost lower,
+                      const bddcost upper) const;
+  std::map<bddcost, std::string> cost_dist(
+      const std::vector<bddcost>& costs,
+      const bddcost max_cost = bddcost_null) const;
+  std::map<bddcost, double> cost_dist(
+      const std::vector<bddcost>& costs,
+      const std::vector<double>& probabilities,
+      const bddcost max_cost = bddcost_null) const;
+  double min_cost(const std::vector<double>& weights) const;
+  double max_cost(const std::vector<double>& weights) const;
+  std::set<elem_t> argmin(const std::vector<double>& weights) const;
+  std::set<elem_t> argmax(const std::vector<double>& weights) const;
+  setset min_cost_sets(const std::vector<double>& weights) const;
+  setset max_cost_sets(const std::vector<double>& weights) const;
   setset remove_some_element() const;
   setset add_some_element(int n, int lower) const;
   setset remove_add_some_elements(int n, int lower) const;
@@ -279,6 +335,35 @@ class setset {
     const std::map<vertex_t, Range>* out_degree_constraints,
     const setset* search_space);
 
+  friend std::string CountGraphs(
+      const std::vector<edge_t>& graph,
+      const std::vector<std::vector<vertex_t> >* vertex_groups,
+      const std::map<vertex_t, Range>* degree_constraints,
+      const Range* num_edges,
+      int num_comps,
+      bool no_loop,
+      const setset* search_space,
+      const std::vector<linear_constraint_t>* linear_constraints);
+  friend std::string CountDirectedCycles(const std::vector<edge_t>& digraph,
+                                         const setset* search_space);
+  friend std::string CountDirectedHamiltonianCycles(
+      const std::vector<edge_t>& digraph, const setset* search_space);
+  friend std::string CountDirectedSTPath(const std::vector<edge_t>& digraph,
+                                         bool is_hamiltonian, vertex_t s,
+                                         vertex_t t,
+                                         const setset* search_space);
+  friend std::string CountDirectedForests(const std::vector<edge_t>& digraph,
+                                          const std::vector<vertex_t>& roots,
+                                          bool is_spanning,
+                                          const setset* search_space);
+  friend std::string CountRootedTrees(const std::vector<edge_t>& digraph,
+                                      vertex_t root, bool is_spanning,
+                                      const setset* search_space);
+  friend std::string CountDirectedGraphs(
+      const std::vector<edge_t>& digraph,
+      const std::map<vertex_t, Range>* in_degree_constraints,
+      const std::map<vertex_t, Range>* out_degree_constraints,
+      const setset* search_space);
 };
 
 }  // namespace graphillion
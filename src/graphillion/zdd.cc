@@ -182,6 +182,34 @@ zdd_t hitting(zdd_t f, elem_t num_elems_a) {
   return g;
 }
 
+// Sets of size in [lower, upper]; since both bounds shrink together along
+// a path, a node and the remaining lower bound identify a subproblem.
+static zdd_t size_between(zdd_t f, int lower, int upper,
+                          map<pair<word_t, int>, zdd_t>& cache) {
+  if (upper < 0 || f == bot())
+    return bot();
+  else if (f == top())
+    return lower <= 0 ? top() : bot();
+  int max_size = max_elem_ - elem(f) + 1;  // bound on sizes of sets in f
+  if (lower > max_size)
+    return bot();
+  else if (lower <= 0 && upper >= max_size)
+    return f;
+  pair<word_t, int> k = std::make_pair(id(f), lower);
+  map<pair<word_t, int>, zdd_t>::iterator i = cache.find(k);
+  if (i != cache.end())
+    return i->second;
+  zdd_t rl = size_between(lo(f), lower, upper, cache);
+  zdd_t rh = size_between(hi(f), lower - 1, upper - 1, cache);
+  return cache[k] = zuniq(elem(f), rl, rh);
+}
+
+zdd_t size_between(zdd_t f, int lower, int upper) {
+  if (lower > upper) return bot();
+  map<pair<word_t, int>, zdd_t> cache;
+  return size_between(f, lower, upper, cache);
+}
+
 zdd_t join(zdd_t f, zdd_t g) {
   return f * g;
 }
@@ -69,6 +69,7 @@ zdd_t complement(zdd_t f, elem_t num_elems_a);
 zdd_t minimal(zdd_t f);
 zdd_t maximal(zdd_t f);
 zdd_t hitting(zdd_t f, elem_t num_elems_a);
+zdd_t size_between(zdd_t f, int lower, int upper);
 zdd_t join(zdd_t f, zdd_t g);
 zdd_t meet(zdd_t f, zdd_t g);
 zdd_t non_subsets(zdd_t f, zdd_t g);
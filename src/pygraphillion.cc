@@ -35,9 +35,11 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <algorithm>
 #include <map>
+#include <new>
 #include <set>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <limits>
 
@@ -51,6 +53,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "graphillion/odd_edges_subgraphs/OddEdgeSubgraphs.h"
 #include "graphillion/degree_distribution/DegreeDistributionGraphs.h"
+#include "graphillion/ordering/EdgeOrdering.h"
 
 using graphillion::setset;
 using graphillion::Range;
@@ -87,14 +90,16 @@ using std::vector;
     }                                                            \
     try {                                                        \
       _ret->ss = new setset(expr);                               \
+    } catch (const std::invalid_argument& e) {                   \
+      Py_DECREF(_ret);                                           \
+      PyErr_SetString(PyExc_ValueError, e.what());               \
+      return NULL;                                               \
     } catch (const std::exception& e) {                          \
       Py_DECREF(_ret);                                           \
-      Py_TYPE(_ret)->tp_free(reinterpret_cast<PyObject*>(_ret)); \
       PyErr_SetString(PyExc_RuntimeError, e.what());             \
       return NULL;                                               \
     } catch (...) {                                              \
       Py_DECREF(_ret);                                           \
-      Py_TYPE(_ret)->tp_free(reinterpret_cast<PyObject*>(_ret)); \
       PyErr_SetString(PyExc_RuntimeError, "Unknown error "       \
         "occured while creating a new setset");                  \
       return NULL;                                               \
@@ -113,6 +118,98 @@ using std::vector;
 #define RETURN_NEW_SETSET2(other, _other, expr)  \
     RETURN_NEW_OBJECT2(&PySetset_Type, other, _other, expr)
 
+static tdzdd::BuildControl build_control;
+static PyObject* build_progress = NULL;
+static tdzdd::BuildMetrics build_metrics;
+static bool record_metrics = false;
+
+static bool report_build_progress(int level, size_t nodes, size_t bytes,
+                                  double elapsed, void*) {
+  // a pending signal such as SIGINT cancels the search
+  if (PyErr_CheckSignals() < 0) return false;
+  if (build_progress == NULL) return true;
+  PyObject* ret = PyObject_CallFunction(build_progress, "iKKd", level,
+                                        static_cast<unsigned long long>(nodes),
+                                        static_cast<unsigned long long>(bytes),
+                                        elapsed);
+  if (ret == NULL) return false;
+  int go = ret == Py_None ? 1 : PyObject_IsTrue(ret);
+  Py_DECREF(ret);
+  return go > 0;
+}
+
+static PyObject* raise_build_aborted(const tdzdd::BuildAborted& e) {
+  if (PyErr_Occurred()) return NULL;  // raised by the progress callback
+  switch (e.reason()) {
+    case tdzdd::BuildAborted::BUDGET:
+      PyErr_SetString(PyExc_MemoryError, e.what());
+      break;
+    case tdzdd::BuildAborted::DEADLINE:
+      PyErr_SetString(PyExc_TimeoutError, e.what());
+      break;
+    default:
+      PyErr_SetString(PyExc_RuntimeError, e.what());
+      break;
+  }
+  return NULL;
+}
+
+// Raises the Python exception for a failure other than an abort.
+static PyObject* raise_search_error() {
+  try {
+    throw;
+  } catch (const std::bad_alloc& e) {
+    PyErr_SetString(PyExc_MemoryError, e.what());
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+  } catch (const std::exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+  }
+  return NULL;
+}
+
+// Runs a search under its own copy of the build control set by
+// _build_control, recording metrics if enabled by _build_metrics; an
+// aborted search raises the exception of its reason, and other failures
+// are not reported as aborts.
+#define RUN_SEARCH(...)                                  \
+  do {                                                   \
+    try {                                                \
+      tdzdd::BuildControl _control(build_control);       \
+      tdzdd::BuildControl::Scope _scope(_control);       \
+      tdzdd::BuildMetrics::Scope _mscope(                \
+          record_metrics ? &build_metrics : NULL);       \
+      __VA_ARGS__;                                       \
+    } catch (const tdzdd::BuildAborted& e) {             \
+      return raise_build_aborted(e);                     \
+    } catch (const std::exception&) {                    \
+      return raise_search_error();                       \
+    }                                                    \
+  } while (0);
+
+// Runs a size estimate without the GIL; it takes no build control, and a
+// failure such as std::bad_alloc raises a Python exception.
+#define RUN_ESTIMATE(...)                                \
+  do {                                                   \
+    PyObject* _error = NULL;                             \
+    string _message;                                     \
+    Py_BEGIN_ALLOW_THREADS;                              \
+    try {                                                \
+      __VA_ARGS__;                                       \
+    } catch (const std::bad_alloc& e) {                  \
+      _error = PyExc_MemoryError;                        \
+      _message = e.what();                               \
+    } catch (const std::exception& e) {                  \
+      _error = PyExc_RuntimeError;                       \
+      _message = e.what();                               \
+    }                                                    \
+    Py_END_ALLOW_THREADS;                                \
+    if (_error != NULL) {                                \
+      PyErr_SetString(_error, _message.c_str());         \
+      return NULL;                                       \
+    }                                                    \
+  } while (0);
+
 #define RETURN_SELF_SETSET(self, other, _other, expr)                  \
   do {                                                                 \
     PySetsetObject* _other = reinterpret_cast<PySetsetObject*>(other); \
@@ -683,37 +780,41 @@ static PyObject* setset_rand_iter(PySetsetObject* self) {
   return reinterpret_cast<PyObject*>(ssi);
 }
 
-static PyObject* setset_optimize(PySetsetObject* self, PyObject* weights,
-                                 bool is_maximizing) {
+// Returns 0 on success, otherwise -1 with a Python error set.
+static int setset_parse_weights(PyObject* weights, vector<double>* w) {
   PyObject* i = PyObject_GetIter(weights);
-  if (i == NULL) return NULL;
+  if (i == NULL) return -1;
   PyObject* eo = NULL;
-  vector<double> w;
   while ((eo = PyIter_Next(i))) {
     if (PyFloat_Check(eo)) {
-      w.push_back(PyFloat_AsDouble(eo));
+      w->push_back(PyFloat_AsDouble(eo));
     }
     else if (PyLong_Check(eo)) {
       long value = PyLong_AsLong(eo);
       if (PyErr_Occurred()) {
-        return NULL;
+        Py_DECREF(eo);
+        Py_DECREF(i);
+        return -1;
       }
-      w.push_back(static_cast<double>(value));
+      w->push_back(static_cast<double>(value));
     }
     else {
       Py_DECREF(eo);
       Py_DECREF(i);
       PyErr_SetString(PyExc_TypeError, "not a number");
-      return NULL;
+      return -1;
     }
     Py_DECREF(eo);
   }
-  // error occurs in PyIter_Next
-  if (PyErr_Occurred()) {
-    Py_DECREF(i);
-    return NULL;
-  }
   Py_DECREF(i);
+  // error occurs in PyIter_Next
+  return PyErr_Occurred() ? -1 : 0;
+}
+
+static PyObject* setset_optimize(PySetsetObject* self, PyObject* weights,
+                                 bool is_maximizing) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
   PySetsetIterObject* ssi = PyObject_New(PySetsetIterObject, &PySetsetIter_Type);
   if (ssi == NULL) {
     PyErr_NoMemory();
@@ -748,6 +849,78 @@ static PyObject* setset_min_iter(PySetsetObject* self, PyObject* weights) {
   return setset_optimize(self, weights, false);
 }
 
+static PyObject* setset_min_cost(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  double cost;
+  try {
+    cost = self->ss->min_cost(w);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return PyFloat_FromDouble(cost);
+}
+
+static PyObject* setset_max_cost(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  double cost;
+  try {
+    cost = self->ss->max_cost(w);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return PyFloat_FromDouble(cost);
+}
+
+static PyObject* setset_argmin(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  if (self->ss->empty()) {
+    PyErr_SetString(PyExc_KeyError, "'argmin' from an empty set");
+    return NULL;
+  }
+  set<int> s;
+  try {
+    s = self->ss->argmin(w);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return setset_build_set(s);
+}
+
+static PyObject* setset_argmax(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  if (self->ss->empty()) {
+    PyErr_SetString(PyExc_KeyError, "'argmax' from an empty set");
+    return NULL;
+  }
+  set<int> s;
+  try {
+    s = self->ss->argmax(w);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return setset_build_set(s);
+}
+
+static PyObject* setset_min_cost_sets(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->min_cost_sets(w));
+}
+
+static PyObject* setset_max_cost_sets(PySetsetObject* self, PyObject* weights) {
+  vector<double> w;
+  if (setset_parse_weights(weights, &w) != 0) return NULL;
+  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->max_cost_sets(w));
+}
+
 // If an item in o is equal to value, return 1, otherwise return 0. On error, return -1.
 static int setset_contains(PySetsetObject* self, PyObject* obj) {
   if (PyAnySet_Check(obj)) {
@@ -967,6 +1140,35 @@ static PyObject* setset_set_size(PySetsetObject* self, PyObject* io) {
   RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->set_size(set_size));
 }
 
+static PyObject* setset_size_between(PySetsetObject* self, PyObject* args) {
+  int lower, upper;
+  if (!PyArg_ParseTuple(args, "ii", &lower, &upper)) return NULL;
+  if (lower < 0 || upper < 0) {
+    PyErr_SetString(PyExc_ValueError, "not unsigned int");
+    return NULL;
+  }
+  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->size_between(lower, upper));
+}
+
+static PyObject* setset_size_dist(PySetsetObject* self) {
+  map<size_t, string> d = self->ss->size_dist();
+  PyObject* dist = PyDict_New();
+  if (dist == NULL) return NULL;
+  for (map<size_t, string>::const_iterator i = d.begin(); i != d.end(); ++i) {
+    PyObject* k = PyLong_FromSize_t(i->first);
+    PyObject* n = PyLong_FromString(i->second.c_str(), NULL, 10);
+    if (k == NULL || n == NULL || PyDict_SetItem(dist, k, n) != 0) {
+      Py_XDECREF(k);
+      Py_XDECREF(n);
+      Py_DECREF(dist);
+      return NULL;
+    }
+    Py_DECREF(k);
+    Py_DECREF(n);
+  }
+  return dist;
+}
+
 static PyObject* setset_join(PySetsetObject* self, PyObject* other) {
   CHECK_SETSET_OR_ERROR(other);
   RETURN_NEW_OBJECT2(Py_TYPE(self), other, _other, self->ss->join(*_other->ss));
@@ -1275,13 +1477,70 @@ static PyObject* setset_richcompare(PySetsetObject* self, PyObject* obj, int op)
   return Py_NotImplemented;
 }
 
+// Converts a Python int to bddcost, raising OverflowError if it does not
+// fit; bddcost_null is reserved by BDDCT and is rejected as well.
+static int setset_parse_cost(PyObject* cost_obj, bddcost* cost) {
+  long value = PyLong_AsLong(cost_obj);
+  if (value == -1 && PyErr_Occurred()) return -1;
+  if (value < std::numeric_limits<bddcost>::min() || value >= bddcost_null) {
+    PyErr_SetString(PyExc_OverflowError, "cost out of range");
+    return -1;
+  }
+  *cost = static_cast<bddcost>(value);
+  return 0;
+}
+
+static int setset_parse_costs(PyObject* costs_obj, vector<bddcost>* costs) {
+  PyObject* cost_iter = PyObject_GetIter(costs_obj);
+  if (cost_iter == NULL) return -1;
+  PyObject* cost;
+  while ((cost = PyIter_Next(cost_iter))) {
+    if (PyLong_Check(cost)) {
+      bddcost value;
+      int err = setset_parse_cost(cost, &value);
+      Py_DECREF(cost);
+      if (err != 0) {
+        Py_DECREF(cost_iter);
+        return -1;
+      }
+      costs->push_back(value);
+    } else {
+      Py_DECREF(cost);
+      Py_DECREF(cost_iter);
+      PyErr_SetString(PyExc_TypeError, "not a number");
+      return -1;
+    }
+  }
+  Py_DECREF(cost_iter);
+  return 0;
+}
+
+// Returns a new dict of the counts, given in decimal, by cost.
+static PyObject* setset_build_cost_dist(const map<bddcost, string>& d) {
+  PyObject* dist = PyDict_New();
+  if (dist == NULL) return NULL;
+  for (map<bddcost, string>::const_iterator i = d.begin(); i != d.end(); ++i) {
+    PyObject* c = PyLong_FromLong(i->first);
+    PyObject* n = PyLong_FromString(i->second.c_str(), NULL, 10);
+    if (c == NULL || n == NULL || PyDict_SetItem(dist, c, n) != 0) {
+      Py_XDECREF(c);
+      Py_XDECREF(n);
+      Py_DECREF(dist);
+      return NULL;
+    }
+    Py_DECREF(c);
+    Py_DECREF(n);
+  }
+  return dist;
+}
+
 static PyObject* setset_cost_le(PySetsetObject* self, PyObject* args, PyObject* kwds) {
   static char s1[] = "costs";
   static char s2[] = "cost_bound";
   static char* kwlist[3] = {s1, s2, NULL};
   PyObject* costs_obj = NULL;
-  bddcost cost_bound = 0;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oi", kwlist, &costs_obj, &cost_bound))
+  PyObject* cost_bound_obj = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &costs_obj, &cost_bound_obj))
     return NULL;
   if (costs_obj == NULL || costs_obj == Py_None) {
     PyErr_SetString(PyExc_ValueError, "no costs");
@@ -1292,29 +1551,139 @@ static PyObject* setset_cost_le(PySetsetObject* self, PyObject* args, PyObject*
   //  return NULL;
   //}
 
-  PyObject* cost_iter = PyObject_GetIter(costs_obj);
-  if (cost_iter == NULL) return NULL;
+  if (PyLong_Check(cost_bound_obj)) {
+    bddcost cost_bound;
+    if (setset_parse_cost(cost_bound_obj, &cost_bound) != 0) return NULL;
+    vector<bddcost> costs;
+    if (setset_parse_costs(costs_obj, &costs) != 0) return NULL;
+    RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->cost_le(costs, cost_bound));
+  }
+
+  // multi-dimensional costs: a list of cost lists and a list of bounds
+  vector<bddcost> cost_bounds;
+  if (setset_parse_costs(cost_bound_obj, &cost_bounds) != 0) return NULL;
+  PyObject* dim_iter = PyObject_GetIter(costs_obj);
+  if (dim_iter == NULL) return NULL;
+  vector<vector<bddcost> > costs;
+  PyObject* dim_obj;
+  while ((dim_obj = PyIter_Next(dim_iter))) {
+    costs.push_back(vector<bddcost>());
+    int err = setset_parse_costs(dim_obj, &costs.back());
+    Py_DECREF(dim_obj);
+    if (err != 0) {
+      Py_DECREF(dim_iter);
+      return NULL;
+    }
+  }
+  Py_DECREF(dim_iter);
+  if (costs.empty() || costs.size() != cost_bounds.size()) {
+    PyErr_SetString(PyExc_ValueError, "costs and cost bounds differ in dimension");
+    return NULL;
+  }
+  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->cost_le(costs, cost_bounds));
+}
+
+static PyObject* setset_cost_between(PySetsetObject* self, PyObject* args, PyObject* kwds) {
+  static char s1[] = "costs";
+  static char s2[] = "lower";
+  static char s3[] = "upper";
+  static char* kwlist[4] = {s1, s2, s3, NULL};
+  PyObject* costs_obj = NULL;
+  bddcost lower = 0;
+  bddcost upper = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oii", kwlist, &costs_obj, &lower, &upper))
+    return NULL;
+  if (costs_obj == NULL || costs_obj == Py_None) {
+    PyErr_SetString(PyExc_ValueError, "no costs");
+    return NULL;
+  }
   vector<bddcost> costs;
-  PyObject* cost;
-  while ((cost = PyIter_Next(cost_iter))) {
-    if (PyLong_Check(cost)) {
-      long value = PyLong_AsLong(cost);
-      Py_DECREF(cost);
+  if (setset_parse_costs(costs_obj, &costs) != 0) return NULL;
+  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->cost_between(costs, lower, upper));
+}
+
+static PyObject* setset_cost_dist(PySetsetObject* self, PyObject* args, PyObject* kwds) {
+  static char s1[] = "costs";
+  static char s2[] = "probabilities";
+  static char s3[] = "max_cost";
+  static char* kwlist[4] = {s1, s2, s3, NULL};
+  PyObject* costs_obj = NULL;
+  PyObject* probabilities_obj = NULL;
+  PyObject* max_cost_obj = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO", kwlist, &costs_obj,
+                                   &probabilities_obj, &max_cost_obj))
+    return NULL;
+  if (costs_obj == NULL || costs_obj == Py_None) {
+    PyErr_SetString(PyExc_ValueError, "no costs");
+    return NULL;
+  }
+  vector<bddcost> costs;
+  if (setset_parse_costs(costs_obj, &costs) != 0) return NULL;
+  bddcost max_cost = bddcost_null;
+  if (max_cost_obj != NULL && max_cost_obj != Py_None) {
+    CHECK_OR_ERROR(max_cost_obj, PyLong_Check, "int", NULL);
+    if (setset_parse_cost(max_cost_obj, &max_cost) != 0) return NULL;
+  }
+
+  if (probabilities_obj == NULL || probabilities_obj == Py_None) {
+    map<bddcost, string> d;
+    try {
+      d = self->ss->cost_dist(costs, max_cost);
+    } catch (const std::invalid_argument& e) {
+      PyErr_SetString(PyExc_ValueError, e.what());
+      return NULL;
+    }
+    return setset_build_cost_dist(d);
+  }
+
+  PyObject* dist = PyDict_New();
+  if (dist == NULL) return NULL;
+  PyObject* i = PyObject_GetIter(probabilities_obj);
+  if (i == NULL) {
+    Py_DECREF(dist);
+    return NULL;
+  }
+  PyObject* eo;
+  vector<double> p;
+  while ((eo = PyIter_Next(i))) {
+    if (PyFloat_Check(eo) || PyLong_Check(eo)) {
+      p.push_back(PyFloat_AsDouble(eo));
+      Py_DECREF(eo);
       if (PyErr_Occurred()) {
-        Py_DECREF(cost_iter);
+        Py_DECREF(i);
+        Py_DECREF(dist);
         return NULL;
       }
-      costs.push_back(static_cast<int>(value));
     } else {
-      Py_DECREF(cost);
-      Py_DECREF(cost_iter);
       PyErr_SetString(PyExc_TypeError, "not a number");
+      Py_DECREF(eo);
+      Py_DECREF(i);
+      Py_DECREF(dist);
       return NULL;
     }
   }
-  Py_DECREF(cost_iter);
-
-  RETURN_NEW_OBJECT(Py_TYPE(self), self->ss->cost_le(costs, cost_bound));
+  Py_DECREF(i);
+  map<bddcost, double> d;
+  try {
+    d = self->ss->cost_dist(costs, p, max_cost);
+  } catch (const std::invalid_argument& e) {
+    Py_DECREF(dist);
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  for (map<bddcost, double>::const_iterator j = d.begin(); j != d.end(); ++j) {
+    PyObject* c = PyLong_FromLong(j->first);
+    PyObject* q = PyFloat_FromDouble(j->second);
+    if (c == NULL || q == NULL || PyDict_SetItem(dist, c, q) != 0) {
+      Py_XDECREF(c);
+      Py_XDECREF(q);
+      Py_DECREF(dist);
+      return NULL;
+    }
+    Py_DECREF(c);
+    Py_DECREF(q);
+  }
+  return dist;
 }
 
 static PyObject* setset_remove_some_element(PySetsetObject* self) {
@@ -1464,6 +1833,12 @@ static PyMethodDef setset_methods[] = {
   {"rand_iter", reinterpret_cast<PyCFunction>(setset_rand_iter), METH_NOARGS, ""},
   {"max_iter", reinterpret_cast<PyCFunction>(setset_max_iter), METH_O, ""},
   {"min_iter", reinterpret_cast<PyCFunction>(setset_min_iter), METH_O, ""},
+  {"min_cost", reinterpret_cast<PyCFunction>(setset_min_cost), METH_O, ""},
+  {"max_cost", reinterpret_cast<PyCFunction>(setset_max_cost), METH_O, ""},
+  {"argmin", reinterpret_cast<PyCFunction>(setset_argmin), METH_O, ""},
+  {"argmax", reinterpret_cast<PyCFunction>(setset_argmax), METH_O, ""},
+  {"min_cost_sets", reinterpret_cast<PyCFunction>(setset_min_cost_sets), METH_O, ""},
+  {"max_cost_sets", reinterpret_cast<PyCFunction>(setset_max_cost_sets), METH_O, ""},
   {"add", reinterpret_cast<PyCFunction>(setset_add), METH_O, ""},
   {"remove", reinterpret_cast<PyCFunction>(setset_remove), METH_O, ""},
   {"discard", reinterpret_cast<PyCFunction>(setset_discard), METH_O, ""},
@@ -1475,6 +1850,8 @@ static PyMethodDef setset_methods[] = {
   {"smaller", reinterpret_cast<PyCFunction>(setset_smaller), METH_O, ""},
   {"larger", reinterpret_cast<PyCFunction>(setset_larger), METH_O, ""},
   {"set_size", reinterpret_cast<PyCFunction>(setset_set_size), METH_O, ""},
+  {"size_between", reinterpret_cast<PyCFunction>(setset_size_between), METH_VARARGS, ""},
+  {"size_dist", reinterpret_cast<PyCFunction>(setset_size_dist), METH_NOARGS, ""},
   {"flip", reinterpret_cast<PyCFunction>(setset_flip), METH_VARARGS, ""},
   {"flip_all", reinterpret_cast<PyCFunction>(setset_flip_all), METH_VARARGS, ""},
   {"join", reinterpret_cast<PyCFunction>(setset_join), METH_O, ""},
@@ -1490,6 +1867,8 @@ static PyMethodDef setset_methods[] = {
   {"_enum", reinterpret_cast<PyCFunction>(setset_enum), METH_O, ""},
   {"_enums", reinterpret_cast<PyCFunction>(setset_enums), METH_NOARGS, ""},
   {"cost_le", reinterpret_cast<PyCFunction>(setset_cost_le), METH_VARARGS | METH_KEYWORDS, ""},
+  {"cost_between", reinterpret_cast<PyCFunction>(setset_cost_between), METH_VARARGS | METH_KEYWORDS, ""},
+  {"cost_dist", reinterpret_cast<PyCFunction>(setset_cost_dist), METH_VARARGS | METH_KEYWORDS, ""},
   {"remove_some_element", reinterpret_cast<PyCFunction>(setset_remove_some_element), METH_NOARGS, ""},
   {"add_some_element", reinterpret_cast<PyCFunction>(setset_add_some_element), METH_VARARGS, ""},
   {"remove_add_some_elements", reinterpret_cast<PyCFunction>(setset_remove_add_some_elements), METH_VARARGS, ""},
@@ -1608,6 +1987,248 @@ PyTypeObject PySetset_Type = {
   0, /* tp_finalize */
 };
 
+// setset::cost_context
+
+typedef struct {
+  PyObject_HEAD
+  setset::cost_context* ctx;
+} PyCostContextObject;
+
+static PyObject* costcontext_new(PyTypeObject* type, PyObject* /*args*/, PyObject* /*kwds*/) {
+  PyCostContextObject* self;
+  self = reinterpret_cast<PyCostContextObject*>(type->tp_alloc(type, 0));
+  if (self == NULL) {
+    PyErr_SetString(PyExc_MemoryError, "Failed to allocate memory for PyCostContextObject");
+    return NULL;
+  }
+  return reinterpret_cast<PyObject*>(self);
+}
+
+static int costcontext_init(PyCostContextObject* self, PyObject* args, PyObject* kwds) {
+  static char s1[] = "costs";
+  static char* kwlist[2] = {s1, NULL};
+  PyObject* costs_obj = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &costs_obj))
+    return -1;
+  vector<bddcost> costs;
+  if (setset_parse_costs(costs_obj, &costs) != 0) return -1;
+  try {
+    delete self->ctx;
+    self->ctx = NULL;
+    self->ctx = new setset::cost_context(costs);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return -1;
+  } catch (const std::exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return -1;
+  }
+  return 0;
+}
+
+static void costcontext_dealloc(PyCostContextObject* self) {
+  delete self->ctx;
+  Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+#define CHECK_COST_CONTEXT_OR_ERROR(self)                          \
+  do {                                                             \
+    if ((self)->ctx == NULL) {                                     \
+      PyErr_SetString(PyExc_ValueError, "no costs");               \
+      return NULL;                                                 \
+    }                                                              \
+  } while (0)
+
+static PyObject* costcontext_le(PyCostContextObject* self, PyObject* args) {
+  PyObject* obj = NULL;
+  PyObject* cost_bound_obj = NULL;
+  if (!PyArg_ParseTuple(args, "OO", &obj, &cost_bound_obj)) return NULL;
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  CHECK_OR_ERROR(cost_bound_obj, PyLong_Check, "int", NULL);
+  bddcost cost_bound;
+  if (setset_parse_cost(cost_bound_obj, &cost_bound) != 0) return NULL;
+  RETURN_NEW_OBJECT2(Py_TYPE(obj), obj, _obj,
+                     self->ctx->le(*_obj->ss, cost_bound));
+}
+
+static PyObject* costcontext_between(PyCostContextObject* self, PyObject* args) {
+  PyObject* obj = NULL;
+  bddcost lower = 0;
+  bddcost upper = 0;
+  if (!PyArg_ParseTuple(args, "Oii", &obj, &lower, &upper)) return NULL;
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  RETURN_NEW_OBJECT2(Py_TYPE(obj), obj, _obj,
+                     self->ctx->between(*_obj->ss, lower, upper));
+}
+
+static PyObject* costcontext_dist(PyCostContextObject* self, PyObject* args) {
+  PyObject* obj = NULL;
+  PyObject* max_cost_obj = NULL;
+  if (!PyArg_ParseTuple(args, "O|O", &obj, &max_cost_obj)) return NULL;
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  bddcost max_cost = bddcost_null;
+  if (max_cost_obj != NULL && max_cost_obj != Py_None) {
+    CHECK_OR_ERROR(max_cost_obj, PyLong_Check, "int", NULL);
+    if (setset_parse_cost(max_cost_obj, &max_cost) != 0) return NULL;
+  }
+  PySetsetObject* _obj = reinterpret_cast<PySetsetObject*>(obj);
+  map<bddcost, string> d;
+  try {
+    d = self->ctx->dist(*_obj->ss, max_cost);
+  } catch (const std::exception& e) {
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return NULL;
+  }
+  return setset_build_cost_dist(d);
+}
+
+static PyObject* costcontext_min_cost(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  PySetsetObject* _obj = reinterpret_cast<PySetsetObject*>(obj);
+  double cost;
+  try {
+    cost = self->ctx->min_cost(*_obj->ss);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return PyFloat_FromDouble(cost);
+}
+
+static PyObject* costcontext_max_cost(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  PySetsetObject* _obj = reinterpret_cast<PySetsetObject*>(obj);
+  double cost;
+  try {
+    cost = self->ctx->max_cost(*_obj->ss);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return PyFloat_FromDouble(cost);
+}
+
+static PyObject* costcontext_argmin(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  PySetsetObject* _obj = reinterpret_cast<PySetsetObject*>(obj);
+  if (_obj->ss->empty()) {
+    PyErr_SetString(PyExc_KeyError, "'argmin' from an empty set");
+    return NULL;
+  }
+  set<int> s;
+  try {
+    s = self->ctx->argmin(*_obj->ss);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return setset_build_set(s);
+}
+
+static PyObject* costcontext_argmax(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  PySetsetObject* _obj = reinterpret_cast<PySetsetObject*>(obj);
+  if (_obj->ss->empty()) {
+    PyErr_SetString(PyExc_KeyError, "'argmax' from an empty set");
+    return NULL;
+  }
+  set<int> s;
+  try {
+    s = self->ctx->argmax(*_obj->ss);
+  } catch (const std::invalid_argument& e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+    return NULL;
+  }
+  return setset_build_set(s);
+}
+
+static PyObject* costcontext_min_cost_sets(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  RETURN_NEW_OBJECT2(Py_TYPE(obj), obj, _obj, self->ctx->min_cost_sets(*_obj->ss));
+}
+
+static PyObject* costcontext_max_cost_sets(PyCostContextObject* self, PyObject* obj) {
+  CHECK_COST_CONTEXT_OR_ERROR(self);
+  CHECK_SETSET_OR_ERROR(obj);
+  RETURN_NEW_OBJECT2(Py_TYPE(obj), obj, _obj, self->ctx->max_cost_sets(*_obj->ss));
+}
+
+static PyMethodDef costcontext_methods[] = {
+  {"le", reinterpret_cast<PyCFunction>(costcontext_le), METH_VARARGS, ""},
+  {"between", reinterpret_cast<PyCFunction>(costcontext_between), METH_VARARGS, ""},
+  {"dist", reinterpret_cast<PyCFunction>(costcontext_dist), METH_VARARGS, ""},
+  {"min_cost", reinterpret_cast<PyCFunction>(costcontext_min_cost), METH_O, ""},
+  {"max_cost", reinterpret_cast<PyCFunction>(costcontext_max_cost), METH_O, ""},
+  {"argmin", reinterpret_cast<PyCFunction>(costcontext_argmin), METH_O, ""},
+  {"argmax", reinterpret_cast<PyCFunction>(costcontext_argmax), METH_O, ""},
+  {"min_cost_sets", reinterpret_cast<PyCFunction>(costcontext_min_cost_sets), METH_O, ""},
+  {"max_cost_sets", reinterpret_cast<PyCFunction>(costcontext_max_cost_sets), METH_O, ""},
+  {NULL,           NULL}           /* sentinel */
+};
+
+PyDoc_STRVAR(costcontext_doc,
+"Cost queries sharing one cost vector and the per-node results\n\
+computed for it; not thread-safe.");
+
+static PyTypeObject PyCostContext_Type = {
+  PyVarObject_HEAD_INIT(NULL, 0)
+  "_graphillion.cost_context",                /* tp_name */
+  sizeof(PyCostContextObject),                /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  /* methods */
+  reinterpret_cast<destructor>(costcontext_dealloc), /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare or *tp_reserved */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+  costcontext_doc,                            /* tp_doc */
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  costcontext_methods,                        /* tp_methods */
+  0,                                          /* tp_members */
+  0,                                          /* tp_getset */
+  0,                                          /* tp_base */
+  0,                                          /* tp_dict */
+  0,                                          /* tp_descr_get */
+  0,                                          /* tp_descr_set */
+  0,                                          /* tp_dictoffset */
+  reinterpret_cast<initproc>(costcontext_init), /* tp_init */
+  PyType_GenericAlloc,                        /* tp_alloc */
+  costcontext_new,                            /* tp_new */
+  0, /* tp_free */
+  0, /* tp_is_gc */
+  0, /* *tp_bases */
+  0, /* *tp_mro */
+  0, /* *tp_cache */
+  0, /* *tp_subclasses */
+  0, /* *tp_weaklist */
+  0, /* tp_version_tag */
+  0, /* tp_finalize */
+};
+
 static PyObject* setset_elem_limit(PyObject*) {
   return PyLong_FromLong(setset::elem_limit());
 }
@@ -1714,6 +2335,25 @@ static bool get_double_from_sequence(PyObject* obj, int index, double* value) {
   return true;
 }
 
+// The widths are listed from the top level, i.e., in the order of edges.
+static PyObject* size_estimate_to_dict(const tdzdd::SizeEstimate& e) {
+  PyObject* width = PyList_New(e.width.empty() ? 0 : e.width.size() - 1);
+  if (width == NULL) return NULL;
+  for (size_t i = 1; i < e.width.size(); ++i)
+    PyList_SET_ITEM(width, e.width.size() - 1 - i,
+                    PyFloat_FromDouble(e.width[i]));
+  PyObject* dict = Py_BuildValue("{s:N,s:d,s:d,s:n}", "width", width,
+                                 "nodes", e.nodes, "bytes", e.bytes,
+                                 "sampled_nodes",
+                                 static_cast<Py_ssize_t>(e.sampledNodes));
+  return dict;
+}
+
+// The counts of the Count* functions are given in decimal.
+static PyObject* count_to_long(const std::string& count) {
+  return PyLong_FromString(count.c_str(), NULL, 10);
+}
+
 static PyObject* graphset_graphs(PyObject*, PyObject* args, PyObject* kwds) {
   static char s1[] = "graph";
   static char s2[] = "vertex_groups";
@@ -1723,7 +2363,11 @@ static PyObject* graphset_graphs(PyObject*, PyObject* args, PyObject* kwds) {
   static char s6[] = "no_loop";
   static char s7[] = "search_space";
   static char s8[] = "linear_constraints";
-  static char* kwlist[9] = {s1, s2, s3, s4, s5, s6, s7, s8, NULL};
+  static char s9[] = "estimate";
+  static char s10[] = "seed";
+  static char s11[] = "count";
+  static char* kwlist[12] = {s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11,
+                             NULL};
   PyObject* graph_obj = NULL;
   PyObject* vertex_groups_obj = NULL;
   PyObject* degree_constraints_obj = NULL;
@@ -1731,10 +2375,15 @@ static PyObject* graphset_graphs(PyObject*, PyObject* args, PyObject* kwds) {
   int num_comps = -1, no_loop = 0;
   PyObject* search_space_obj = NULL;
   PyObject* linear_constraints_obj = NULL;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOiiOO", kwlist, &graph_obj,
-                                   &vertex_groups_obj, &degree_constraints_obj,
-                                   &num_edges_obj, &num_comps, &no_loop,
-                                   &search_space_obj, &linear_constraints_obj))
+  Py_ssize_t estimate = 0;
+  unsigned long long seed = 1;
+  int count = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOiiOOnKi", kwlist,
+                                   &graph_obj, &vertex_groups_obj,
+                                   &degree_constraints_obj, &num_edges_obj,
+                                   &num_comps, &no_loop, &search_space_obj,
+                                   &linear_constraints_obj, &estimate, &seed,
+                                   &count))
     return NULL;
 
   vector<pair<string, string> > graph;
@@ -1960,9 +2609,29 @@ static PyObject* graphset_graphs(PyObject*, PyObject* args, PyObject* kwds) {
     }
   }
 
-  setset ss = SearchGraphs(graph, vertex_groups, degree_constraints, num_edges,
-                           num_comps, no_loop, search_space,
-                           linear_constraints);
+  if (estimate > 0) {
+    tdzdd::SizeEstimate e;
+    RUN_ESTIMATE(e = graphillion::EstimateGraphs(graph, vertex_groups,
+                                                 degree_constraints, num_edges,
+                                                 num_comps, no_loop,
+                                                 linear_constraints, estimate,
+                                                 seed));
+    return size_estimate_to_dict(e);
+  }
+
+  if (count) {
+    string c;
+    RUN_SEARCH(c = graphillion::CountGraphs(graph, vertex_groups,
+                                            degree_constraints, num_edges,
+                                            num_comps, no_loop, search_space,
+                                            linear_constraints));
+    return count_to_long(c);
+  }
+
+  setset ss;
+  RUN_SEARCH(ss = SearchGraphs(graph, vertex_groups, degree_constraints,
+                               num_edges, num_comps, no_loop, search_space,
+                               linear_constraints));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -1973,6 +2642,134 @@ static PyObject* graphset_show_messages(PySetsetObject* self, PyObject* obj) {
   else Py_RETURN_FALSE;
 }
 
+static PyObject* graphset_spill_budget(PyObject*, PyObject* obj) {
+  if (!PyLong_Check(obj)) {
+    PyErr_SetString(PyExc_TypeError, "not an integer");
+    return NULL;
+  }
+  size_t bytes = PyLong_AsSize_t(obj);
+  if (PyErr_Occurred()) return NULL;
+  return PyLong_FromSize_t(graphillion::SpillBudget(bytes));
+}
+
+static PyObject* graphset_pack_states(PyObject*, PyObject* obj) {
+  int ret = graphillion::PackStates(PyObject_IsTrue(obj));
+  if (ret) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+static PyObject* graphset_cache_dir(PyObject*, PyObject* obj) {
+  if (!PyUnicode_Check(obj)) {
+    PyErr_SetString(PyExc_TypeError, "not a string");
+    return NULL;
+  }
+  const char* dir = PyUnicode_AsUTF8(obj);
+  if (dir == NULL) return NULL;
+  std::string prev = graphillion::CacheDirectory(dir);
+  return PyUnicode_FromString(prev.c_str());
+}
+
+static PyObject* graphset_build_control(PyObject*, PyObject* args,
+                                        PyObject* kwds) {
+  static char s1[] = "max_nodes";
+  static char s2[] = "max_bytes";
+  static char s3[] = "time_limit";
+  static char s4[] = "progress";
+  static char* kwlist[5] = {s1, s2, s3, s4, NULL};
+  unsigned long long max_nodes = 0, max_bytes = 0;
+  double time_limit = 0;
+  PyObject* progress = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|KKdO", kwlist, &max_nodes,
+                                   &max_bytes, &time_limit, &progress))
+    return NULL;
+  if (progress != Py_None && !PyCallable_Check(progress)) {
+    PyErr_SetString(PyExc_TypeError, "progress must be callable");
+    return NULL;
+  }
+
+  PyObject* old = Py_BuildValue(
+      "{s:K,s:K,s:d,s:O}", s1,
+      static_cast<unsigned long long>(build_control.maxNodes()), s2,
+      static_cast<unsigned long long>(build_control.maxBytes()), s3,
+      build_control.timeLimit(), s4,
+      build_progress != NULL ? build_progress : Py_None);
+  if (old == NULL) return NULL;
+
+  build_control.setMaxNodes(max_nodes);
+  build_control.setMaxBytes(max_bytes);
+  build_control.setTimeLimit(time_limit);
+  Py_XDECREF(build_progress);
+  build_progress = NULL;
+  if (progress != Py_None) {
+    Py_INCREF(progress);
+    build_progress = progress;
+  }
+  return old;
+}
+
+static PyObject* graphset_build_metrics(PyObject*, PyObject* obj) {
+  stringstream sstr;
+  build_metrics.dumpJson(sstr);
+  build_metrics.clear();
+  record_metrics = PyObject_IsTrue(obj);
+  return PyUnicode_FromString(sstr.str().c_str());
+}
+
+static PyObject* graphset_frontier_edge_order(PyObject*, PyObject* args,
+                                              PyObject* kwds) {
+  static char s1[] = "num_vertices";
+  static char s2[] = "edges";
+  static char s3[] = "source";
+  static char s4[] = "minimize_sum";
+  static char s5[] = "time_limit";
+  static char* kwlist[6] = {s1, s2, s3, s4, s5, NULL};
+  int num_vertices = 0;
+  PyObject* edges_obj = NULL;
+  int source = -1;
+  PyObject* minimize_sum_obj = Py_False;
+  double time_limit = 1.0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "iO|iOd", kwlist,
+                                   &num_vertices, &edges_obj, &source,
+                                   &minimize_sum_obj, &time_limit))
+    return NULL;
+  if (num_vertices < 0) {
+    PyErr_SetString(PyExc_ValueError, "num_vertices must be non-negative");
+    return NULL;
+  }
+
+  PyObject* seq = PySequence_Fast(edges_obj, "edges must be a sequence");
+  if (seq == NULL) return NULL;
+  vector<pair<int, int> > edges;
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); ++i) {
+    int u, v;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, i), "ii", &u, &v)) {
+      Py_DECREF(seq);
+      return NULL;
+    }
+    if (u < 0 || u >= num_vertices || v < 0 || v >= num_vertices) {
+      Py_DECREF(seq);
+      PyErr_SetString(PyExc_ValueError, "vertex out of range");
+      return NULL;
+    }
+    edges.push_back(std::make_pair(u, v));
+  }
+  Py_DECREF(seq);
+
+  int minimize_sum = PyObject_IsTrue(minimize_sum_obj);
+  if (minimize_sum < 0) return NULL;
+  vector<int> order;
+  Py_BEGIN_ALLOW_THREADS;
+  order = graphillion::OrderEdgesByFrontier(num_vertices, edges, source,
+                                            minimize_sum, time_limit);
+  Py_END_ALLOW_THREADS;
+
+  PyObject* list = PyList_New(order.size());
+  if (list == NULL) return NULL;
+  for (size_t i = 0; i < order.size(); ++i)
+    PyList_SET_ITEM(list, i, PyLong_FromLong(order[i]));
+  return list;
+}
+
 static PyObject* graphset_omp_get_max_threads(PyObject*) {
 #ifdef _OPENMP
   return PyLong_FromLong(omp_get_max_threads());
@@ -2081,9 +2878,10 @@ static PyObject* regular_graphs(PyObject*, PyObject* args, PyObject* kwds){
     search_space = reinterpret_cast<PySetsetObject*>(graphset_obj)->ss;
   }
 
-  auto ss = graphillion::SearchRegularGraphs(graph,
-              degree_lower, degree_upper,
-              is_connected, search_space);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchRegularGraphs(graph,
+                   degree_lower, degree_upper,
+                   is_connected, search_space));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2101,7 +2899,8 @@ static PyObject* odd_edges_subgraphs(PyObject*, PyObject* args, PyObject* kwds)
     return NULL;
   }
 
-  auto ss = graphillion::SearchOddEdgeSubgraphs(graph);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchOddEdgeSubgraphs(graph));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2175,8 +2974,9 @@ static PyObject* degree_distribution_graphs(PyObject*, PyObject* args, PyObject*
     search_space = reinterpret_cast<PySetsetObject*>(graphset_obj)->ss;
   }
 
-  auto ss = graphillion::SearchDegreeDistributionGraphs(graph, deg_ranges,
-    is_connected != Py_False, search_space);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDegreeDistributionGraphs(graph,
+    deg_ranges, is_connected != Py_False, search_space));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2184,11 +2984,17 @@ static PyObject* graph_partitions(PyObject*, PyObject* args, PyObject* kwds){
   static char s1[] = "graph";
   static char s2[] = "num_comp_lb";
   static char s3[] = "num_comp_ub";
-  static char* kwlist[4] = {s1, s2, s3, NULL};
+  static char s4[] = "estimate";
+  static char s5[] = "seed";
+  static char s6[] = "count";
+  static char* kwlist[7] = {s1, s2, s3, s4, s5, s6, NULL};
   PyObject* graph_obj = NULL;
   int num_comp_lb = 1;
   int num_comp_ub = std::numeric_limits<int16_t>::max();
-  if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|ii", kwlist, &graph_obj, &num_comp_lb, &num_comp_ub)){
+  Py_ssize_t estimate = 0;
+  unsigned long long seed = 1;
+  int count = 0;
+  if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|iinKi", kwlist, &graph_obj, &num_comp_lb, &num_comp_ub, &estimate, &seed, &count)){
     return NULL;
   }
   if (num_comp_lb < 1){
@@ -2210,7 +3016,24 @@ static PyObject* graph_partitions(PyObject*, PyObject* args, PyObject* kwds){
     return NULL;
   }
 
-  auto ss = graphillion::SearchPartitions(graph, num_comp_lb, num_comp_ub);
+  if (estimate > 0) {
+    tdzdd::SizeEstimate e;
+    RUN_ESTIMATE(e = graphillion::EstimatePartitions(graph, num_comp_lb,
+                                                     num_comp_ub, estimate,
+                                                     seed));
+    return size_estimate_to_dict(e);
+  }
+
+  if (count) {
+    string c;
+    RUN_SEARCH(c = graphillion::CountPartitions(graph, num_comp_lb,
+                                                num_comp_ub));
+    return count_to_long(c);
+  }
+
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchPartitions(graph, num_comp_lb,
+                                                 num_comp_ub));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2293,17 +3116,22 @@ static PyObject* balanced_partitions(PyObject*, PyObject* args, PyObject* kwds)
     }
   }
 
-  auto ss = graphillion::SearchBalancedPartitions(graph, weight_list, ratio, lower,
-                                             upper, num_comps);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchBalancedPartitions(graph, weight_list,
+                                                         ratio, lower, upper,
+                                                         num_comps));
   RETURN_NEW_SETSET(ss);
 }
 
 static PyObject* induced_graphs(PyObject*, PyObject* args, PyObject* kwds){
   static char s1[] = "graph";
-  static char* kwlist[2] = {s1, NULL};
+  static char s2[] = "count";
+  static char* kwlist[3] = {s1, s2, NULL};
 
   PyObject* graph_obj = NULL;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &graph_obj)) {
+  int count = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &graph_obj,
+                                   &count)) {
     return NULL;
   }
 
@@ -2313,7 +3141,14 @@ static PyObject* induced_graphs(PyObject*, PyObject* args, PyObject* kwds){
     return NULL;
   }
 
-  auto ss = graphillion::SearchInducedGraphs(graph);
+  if (count) {
+    string c;
+    RUN_SEARCH(c = graphillion::CountInducedGraphs(graph));
+    return count_to_long(c);
+  }
+
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchInducedGraphs(graph));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2379,8 +3214,9 @@ static PyObject* weighted_induced_graphs(PyObject*, PyObject* args,
     }
   }
 
-  auto ss = graphillion::SearchWeightedInducedGraphs(graph, weight_list, lower,
-                                                     upper);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchWeightedInducedGraphs(graph, weight_list,
+                                                            lower, upper));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2411,8 +3247,9 @@ static PyObject* forbidden_induced_subgraphs(PyObject*, PyObject* args, PyObject
     return NULL;
   }
 
-  auto ss = graphillion::SearchForbiddenInducedSubgraphs(graph,
-    reinterpret_cast<PySetsetObject*>(graphset_obj)->ss);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchForbiddenInducedSubgraphs(graph,
+    reinterpret_cast<PySetsetObject*>(graphset_obj)->ss));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2431,7 +3268,8 @@ static PyObject* chordal_graphs(PyObject*, PyObject* args, PyObject* kwds){
     return NULL;
   }
 
-  auto ss = graphillion::SearchChordals(graph);
+  setset ss;
+  RUN_SEARCH(ss = graphillion::SearchChordals(graph));
   RETURN_NEW_SETSET(ss);
 }
 
@@ -2516,7 +3354,9 @@ static PyObject* reliability(PyObject*, PyObject* args, PyObject* kwds) {
     Py_DECREF(i);
   }
 
-  auto prob = graphillion::reliability(graph, probabilities, terminals);
+  double prob;
+  RUN_SEARCH(prob = graphillion::reliability(graph, probabilities,
+                                              terminals));
   return PyFloat_FromDouble(prob);
 }
 
@@ -2672,11 +3512,13 @@ static PyObject* graphset_directed_cycles(PyObject*, PyObject* args,
                                           PyObject* kwds) {
   static char s1[] = "graph";
   static char s2[] = "search_space";
-  static char* kwlist[3] = {s1, s2, NULL};
+  static char s3[] = "count";
+  static char* kwlist[4] = {s1, s2, s3, NULL};
   PyObject* graph_obj = NULL;
   PyObject* search_space_obj = NULL;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &graph_obj,
-                                   &search_space_obj))
+  int count = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oi", kwlist, &graph_obj,
+                                   &search_space_obj, &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2693,8 +3535,14 @@ static PyObject* graphset_directed_cycles(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss =
-      graphillion::SearchDirectedCycles(graph, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountDirectedCycles(graph, search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDirectedCycles(graph, search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2703,11 +3551,13 @@ static PyObject* graphset_directed_hamiltonian_cycles(PyObject*, PyObject* args,
                                                       PyObject* kwds) {
   static char s1[] = "graph";
   static char s2[] = "search_space";
-  static char* kwlist[3] = {s1, s2, NULL};
+  static char s3[] = "count";
+  static char* kwlist[4] = {s1, s2, s3, NULL};
   PyObject* graph_obj = NULL;
   PyObject* search_space_obj = NULL;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &graph_obj,
-                                   &search_space_obj))
+  int count = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|Oi", kwlist, &graph_obj,
+                                   &search_space_obj, &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2724,8 +3574,16 @@ static PyObject* graphset_directed_hamiltonian_cycles(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss =
-      graphillion::SearchDirectedHamiltonianCycles(graph, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountDirectedHamiltonianCycles(
+        graph, search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDirectedHamiltonianCycles(graph,
+                                                                search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2737,15 +3595,17 @@ static PyObject* graphset_directed_st_path(PyObject*, PyObject* args,
   static char s3[] = "t";
   static char s4[] = "is_hamiltonian";
   static char s5[] = "search_space";
-  static char* kwlist[] = {s1, s2, s3, s4, s5, NULL};
+  static char s6[] = "count";
+  static char* kwlist[] = {s1, s2, s3, s4, s5, s6, NULL};
   PyObject* graph_obj = NULL;
   int is_hamiltonian = false;
   PyObject* s_obj = NULL;
   PyObject* t_obj = NULL;
   PyObject* search_space_obj = NULL;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OSSp|O", kwlist, &graph_obj,
+  int count = 0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OSSp|Oi", kwlist, &graph_obj,
                                    &s_obj, &t_obj, &is_hamiltonian,
-                                   &search_space_obj))
+                                   &search_space_obj, &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2783,8 +3643,16 @@ static PyObject* graphset_directed_st_path(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss = graphillion::SearchDirectedSTPath(
-      graph, is_hamiltonian, s, t, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountDirectedSTPath(
+        graph, is_hamiltonian, s, t, search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDirectedSTPath(
+      graph, is_hamiltonian, s, t, search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2795,13 +3663,16 @@ static PyObject* graphset_rooted_forests(PyObject*, PyObject* args,
   static char s2[] = "roots";
   static char s3[] = "is_spanning";
   static char s4[] = "search_space";
-  static char* kwlist[] = {s1, s2, s3, s4, NULL};
+  static char s5[] = "count";
+  static char* kwlist[] = {s1, s2, s3, s4, s5, NULL};
   PyObject* graph_obj = NULL;
   PyObject* roots_obj = NULL;
   PyObject* search_space_obj = NULL;
+  int count = 0;
   int is_spanning;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OpO", kwlist, &graph_obj,
-                                   &roots_obj, &is_spanning, &search_space_obj))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OpOi", kwlist, &graph_obj,
+                                   &roots_obj, &is_spanning, &search_space_obj,
+                                   &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2825,8 +3696,16 @@ static PyObject* graphset_rooted_forests(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss = graphillion::SearchDirectedForests(
-      graph, roots, is_spanning, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountDirectedForests(
+        graph, roots, is_spanning, search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDirectedForests(
+      graph, roots, is_spanning, search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2837,13 +3716,16 @@ static PyObject* graphset_rooted_trees(PyObject*, PyObject* args,
   static char s2[] = "root";
   static char s3[] = "is_spanning";
   static char s4[] = "search_space";
-  static char* kwlist[] = {s1, s2, s3, s4, NULL};
+  static char s5[] = "count";
+  static char* kwlist[] = {s1, s2, s3, s4, s5, NULL};
   PyObject* graph_obj = NULL;
   PyObject* search_space_obj = NULL;
+  int count = 0;
   PyObject* root_obj = NULL;
   int is_spanning = false;
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OSp|O", kwlist, &graph_obj,
-                                   &root_obj, &is_spanning, &search_space_obj))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OSp|Oi", kwlist, &graph_obj,
+                                   &root_obj, &is_spanning, &search_space_obj,
+                                   &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2871,8 +3753,16 @@ static PyObject* graphset_rooted_trees(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss =
-      graphillion::SearchRootedTrees(graph, root, is_spanning, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountRootedTrees(graph, root, is_spanning,
+                                                 search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchRootedTrees(graph, root, is_spanning,
+                                                  search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2883,14 +3773,16 @@ static PyObject* graphset_directed_graphs(PyObject*, PyObject* args,
   static char s2[] = "in_degree_constraints";
   static char s3[] = "out_degree_constraints";
   static char s4[] = "search_space";
-  static char* kwlist[] = {s1, s2, s3, s4, NULL};
+  static char s5[] = "count";
+  static char* kwlist[] = {s1, s2, s3, s4, s5, NULL};
   PyObject* graph_obj = NULL;
   PyObject* in_degree_constraints_obj = NULL;
   PyObject* out_degree_constraints_obj = NULL;
   PyObject* search_space_obj = NULL;
+  int count = 0;
   if (!PyArg_ParseTupleAndKeywords(
-          args, kwds, "O|OOO", kwlist, &graph_obj, &in_degree_constraints_obj,
-          &out_degree_constraints_obj, &search_space_obj))
+          args, kwds, "O|OOOi", kwlist, &graph_obj, &in_degree_constraints_obj,
+          &out_degree_constraints_obj, &search_space_obj, &count))
     return NULL;
 
   std::vector<std::pair<std::string, std::string> > graph;
@@ -2929,8 +3821,16 @@ static PyObject* graphset_directed_graphs(PyObject*, PyObject* args,
     search_space = reinterpret_cast<PySetsetObject*>(search_space_obj)->ss;
   }
 
-  graphillion::setset ss = graphillion::SearchDirectedGraphs(
-      graph, in_degree_constraints, out_degree_constrains, search_space);
+  if (count) {
+    std::string c;
+    RUN_SEARCH(c = graphillion::CountDirectedGraphs(
+        graph, in_degree_constraints, out_degree_constrains, search_space));
+    return count_to_long(c);
+  }
+
+  graphillion::setset ss;
+  RUN_SEARCH(ss = graphillion::SearchDirectedGraphs(
+      graph, in_degree_constraints, out_degree_constrains, search_space));
 
   RETURN_NEW_SETSET(ss);
 }
@@ -2942,6 +3842,12 @@ static PyMethodDef module_methods[] = {
   //{"_num_elems", setset_num_elems, METH_VARARGS, ""},
   {"_graphs", reinterpret_cast<PyCFunction>(graphset_graphs), METH_VARARGS | METH_KEYWORDS, ""},
   {"_show_messages", reinterpret_cast<PyCFunction>(graphset_show_messages), METH_O, ""},
+  {"_spill_budget", reinterpret_cast<PyCFunction>(graphset_spill_budget), METH_O, ""},
+  {"_pack_states", reinterpret_cast<PyCFunction>(graphset_pack_states), METH_O, ""},
+  {"_cache_dir", reinterpret_cast<PyCFunction>(graphset_cache_dir), METH_O, ""},
+  {"_build_control", reinterpret_cast<PyCFunction>(graphset_build_control), METH_VARARGS | METH_KEYWORDS, ""},
+  {"_build_metrics", reinterpret_cast<PyCFunction>(graphset_build_metrics), METH_O, ""},
+  {"_frontier_edge_order", reinterpret_cast<PyCFunction>(graphset_frontier_edge_order), METH_VARARGS | METH_KEYWORDS, ""},
   {"_omp_get_max_threads", reinterpret_cast<PyCFunction>(graphset_omp_get_max_threads), METH_NOARGS, ""},
   {"_omp_get_num_threads", reinterpret_cast<PyCFunction>(graphset_omp_get_num_threads), METH_NOARGS, ""},
   {"_omp_set_num_threads", reinterpret_cast<PyCFunction>(graphset_omp_set_num_threads), METH_O, ""},
@@ -2996,12 +3902,17 @@ PyMODINIT_FUNC PyInit__graphillion(void) {
   PyObject* m;
   if (PyType_Ready(&PySetset_Type) < 0) return NULL;
   if (PyType_Ready(&PySetsetIter_Type) < 0) return NULL;
+  if (PyType_Ready(&PyCostContext_Type) < 0) return NULL;
   m = PyModule_Create(&moduledef);
   if (m == NULL) return NULL;
+  build_control.setCallback(report_build_progress);
   Py_INCREF(&PySetset_Type);
   Py_INCREF(&PySetsetIter_Type);
+  Py_INCREF(&PyCostContext_Type);
   PyModule_AddObject(m, "setset", reinterpret_cast<PyObject*>(&PySetset_Type));
   PyModule_AddObject(m, "setset_iterator",
                      reinterpret_cast<PyObject*>(&PySetsetIter_Type));
+  PyModule_AddObject(m, "cost_context",
+                     reinterpret_cast<PyObject*>(&PyCostContext_Type));
   return m;
 }
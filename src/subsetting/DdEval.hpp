@@ -94,6 +94,15 @@ public:
  * - R getValue(T const& work)
  * - void destructLevel(int i)
  *
+ * When DdStructure uses multiple processors, each thread evaluates the
+ * nodes on its own copy of the evaluator, which is made before
+ * initialize() is called.  An evaluator whose values are multiword
+ * numbers or polynomials can therefore allocate them from member
+ * allocators such as MemoryPools without locking: every copy is
+ * initialized, the values written by one copy are only read by the
+ * others, and destructLevel(i) is called on every copy when level @a i
+ * is no longer referred to.
+ *
  * @tparam E the class implementing this class.
  * @tparam T data type of work area for each node.
  * @tparam R data type of return value.
@@ -111,6 +120,9 @@ public:
 
     /**
      * Declares thread-safety.
+     * An evaluator that touches a shared resource, such as the node table
+     * of a BDD package, must return false; one that keeps its allocators
+     * in its own members is thread-safe.
      * @return true if this class is thread-safe.
      */
     bool isThreadSafe() const {
@@ -27,11 +27,13 @@
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 
 #include "dd/DdBuilder.hpp"
 #include "dd/DepthFirstSearcher.hpp"
 #include "util/demangle.hpp"
 #include "util/MessageHandler.hpp"
+#include "util/StateHash.hpp"
 
 namespace tdzdd {
 
@@ -69,6 +71,13 @@ class DdSpecBase {
 public:
     static int const ARITY = AR;
 
+    /**
+     * Whether the states can be moved byte by byte, as they are when
+     * waiting levels are spilled or packed.  Specs whose states are
+     * trivially copyable override it.
+     */
+    static bool const TRIVIAL_STATES = false;
+
     S& entity() {
         return *static_cast<S*>(this);
     }
@@ -194,6 +203,8 @@ protected:
 template<typename S, int AR>
 class StatelessDdSpec: public DdSpecBase<S,AR> {
 public:
+    static bool const TRIVIAL_STATES = true;
+
     int datasize() const {
         return 0;
     }
@@ -257,6 +268,7 @@ template<typename S, typename T, int AR>
 class DdSpec: public DdSpecBase<S,AR> {
 public:
     typedef T State;
+    static bool const TRIVIAL_STATES = std::is_trivially_copyable<T>::value;
 
 private:
     static State& state(void* p) {
@@ -373,6 +385,7 @@ template<typename S, typename T, int AR>
 class PodArrayDdSpec: public DdSpecBase<S,AR> {
 public:
     typedef T State;
+    static bool const TRIVIAL_STATES = std::is_trivially_copyable<T>::value;
 
 private:
     typedef size_t Word;
@@ -447,14 +460,7 @@ public:
     }
 
     size_t hashCode(State const* s) const {
-        Word const* pa = reinterpret_cast<Word const*>(s);
-        Word const* pz = pa + dataWords;
-        size_t h = 0;
-        while (pa != pz) {
-            h += *pa++;
-            h *= 314159257;
-        }
-        return h;
+        return StateHash::hash(reinterpret_cast<Word const*>(s), dataWords);
     }
 
     size_t hashCodeAtLevel(State const* s, int level) const {
@@ -466,13 +472,8 @@ public:
     }
 
     bool equalTo(State const* s1, State const* s2) const {
-        Word const* pa = reinterpret_cast<Word const*>(s1);
-        Word const* qa = reinterpret_cast<Word const*>(s2);
-        Word const* pz = pa + dataWords;
-        while (pa != pz) {
-            if (*pa++ != *qa++) return false;
-        }
-        return true;
+        return StateHash::equal(reinterpret_cast<Word const*>(s1),
+                reinterpret_cast<Word const*>(s2), dataWords);
     }
 
     bool equalToAtLevel(State const* s1, State const* s2, int level) const {
@@ -527,6 +528,8 @@ class HybridDdSpec: public DdSpecBase<S,AR> {
 public:
     typedef TS S_State;
     typedef TA A_State;
+    static bool const TRIVIAL_STATES = std::is_trivially_copyable<TS>::value
+            && std::is_trivially_copyable<TA>::value;
 
 private:
     typedef size_t Word;
@@ -630,13 +633,8 @@ public:
     size_t hash_code(void const* p, int level) const {
         size_t h = this->entity().hashCodeAtLevel(s_state(p), level);
         h *= 271828171;
-        Word const* pa = static_cast<Word const*>(p);
-        Word const* pz = pa + dataWords;
-        pa += S_WORDS;
-        while (pa != pz) {
-            h += *pa++;
-            h *= 314159257;
-        }
+        h += StateHash::hash(static_cast<Word const*>(p) + S_WORDS,
+                dataWords - S_WORDS);
         return h;
     }
 
@@ -651,15 +649,8 @@ public:
     bool equal_to(void const* p, void const* q, int level) const {
         if (!this->entity().equalToAtLevel(s_state(p), s_state(q), level))
             return false;
-        Word const* pa = static_cast<Word const*>(p);
-        Word const* qa = static_cast<Word const*>(q);
-        Word const* pz = pa + dataWords;
-        pa += S_WORDS;
-        qa += S_WORDS;
-        while (pa != pz) {
-            if (*pa++ != *qa++) return false;
-        }
-        return true;
+        return StateHash::equal(static_cast<Word const*>(p) + S_WORDS,
+                static_cast<Word const*>(q) + S_WORDS, dataWords - S_WORDS);
     }
 
     void printState(std::ostream& os,
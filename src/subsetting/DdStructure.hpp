@@ -27,9 +27,12 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstdio>
+#include <cstring>
 #include <ostream>
 #include <set>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "DdEval.hpp"
@@ -41,10 +44,14 @@
 #include "eval/Cardinality.hpp"
 #include "op/Lookahead.hpp"
 #include "op/Unreduction.hpp"
+#include "util/BuildControl.hpp"
+#include "util/BuildMetrics.hpp"
 #include "util/demangle.hpp"
+#include "util/MappedFile.hpp"
 #include "util/MessageHandler.hpp"
 #include "util/MyHashTable.hpp"
 #include "util/MyVector.hpp"
+#include "util/ThreadArena.hpp"
 
 namespace tdzdd {
 
@@ -58,7 +65,27 @@ class DdStructure: public DdSpec<DdStructure<ARITY>,NodeId,ARITY> {
     NodeId root_;                    ///< Root node ID.
     bool useMP;                      ///< Flag to use MP algorithms.
 
+    /// Header of the file written by save(), followed by the label padded
+    /// to 8 bytes, the rows from the terminals upward, and the row sizes.
+    struct FileHeader {
+        char magic[8];
+        uint32_t arity;
+        uint32_t numRows;
+        uint64_t root;
+        uint64_t labelSize;
+    };
+
+    static char const* fileMagic() {
+        return "TDZDDNT2";
+    }
+
+    static size_t labelPadding(size_t labelSize) {
+        return -labelSize & 7;
+    }
+
 public:
+    class Writer;
+
     /**
      * Default constructor.
      */
@@ -104,8 +131,11 @@ public:
     template<typename SPEC>
     DdStructure(DdSpecBase<SPEC,ARITY> const& spec, bool useMP = false) :
             useMP(useMP) {
+        ThreadArena::TrimScope trim;
 #ifdef _OPENMP
-        if (useMP) constructMP_(spec.entity());
+        // only the sequential builders can spill or pack waiting nodes
+        if (useMP && !DdBuilderBase::movesStates<SPEC>())
+            constructMP_(spec.entity());
         else
 #endif
         construct_(spec.entity());
@@ -116,6 +146,7 @@ private:
     void construct_(SPEC const& spec) {
         MessageHandler mh;
         mh.begin(typenameof(spec));
+        BuildMetrics::Recorder rec(typenameof(spec));
         DdBuilder<SPEC> zc(spec, diagram);
         int n = zc.initialize(root_);
 
@@ -123,6 +154,8 @@ private:
             mh.setSteps(n);
             for (int i = n; i > 0; --i) {
                 zc.construct(i);
+                rec.level(zc.levelMetrics());
+                control_(i, *diagram, zc.pendingBytes());
                 mh.step();
             }
         }
@@ -131,12 +164,14 @@ private:
         }
 
         mh.end(size());
+        rec.end(size());
     }
 
     template<typename SPEC>
     void constructMP_(SPEC const& spec) {
         MessageHandler mh;
         mh.begin(typenameof(spec));
+        BuildMetrics::Recorder rec(typenameof(spec));
         DdBuilderMP<SPEC> zc(spec, diagram);
         int n = zc.initialize(root_);
 
@@ -147,6 +182,8 @@ private:
             mh.setSteps(n);
             for (int i = n; i > 0; --i) {
                 zc.construct(i);
+                rec.level(LevelMetrics(i, (*diagram)[i].size()));
+                control_(i, *diagram);
                 mh.step();
             }
         }
@@ -155,6 +192,24 @@ private:
         }
 
         mh.end(size());
+        rec.end(size());
+    }
+
+    /**
+     * Reports progress to the active build control, if any.
+     * @param i the level just processed.
+     * @param table the node table being built.
+     * @param pending the bytes of spec nodes waiting in the builder.
+     * The blocks cached by the ThreadArena are charged as well.
+     * @throw BuildAborted the control stopped the construction.
+     */
+    static void control_(int i, NodeTableEntity<ARITY> const& table,
+            size_t pending = 0) {
+        BuildControl* control = BuildControl::active();
+        if (control == 0) return;
+        size_t nodes = table.totalSize();
+        control->check(i, nodes, nodes * sizeof(Node<ARITY>) + pending
+                + ThreadArena::cachedBytes());
     }
 
 public:
@@ -164,8 +219,11 @@ public:
      */
     template<typename SPEC>
     void zddSubset(DdSpecBase<SPEC,ARITY> const& spec) {
+        ThreadArena::TrimScope trim;
 #ifdef _OPENMP
-        if (useMP) zddSubsetMP_(spec.entity());
+        // only the sequential builders can spill or pack waiting nodes
+        if (useMP && !DdBuilderBase::movesStates<SPEC>())
+            zddSubsetMP_(spec.entity());
         else
 #endif
         zddSubset_(spec.entity());
@@ -176,6 +234,7 @@ private:
     void zddSubset_(SPEC const& spec) {
         MessageHandler mh;
         mh.begin(typenameof(spec));
+        BuildMetrics::Recorder rec(typenameof(spec));
         NodeTableHandler<ARITY> tmpTable;
         ZddSubsetter<SPEC> zs(diagram, spec, tmpTable);
         int n = zs.initialize(root_);
@@ -185,6 +244,8 @@ private:
             for (int i = n; i > 0; --i) {
                 zs.subset(i);
                 diagram.derefLevel(i);
+                rec.level(zs.levelMetrics());
+                control_(i, *tmpTable, zs.pendingBytes());
                 mh.step();
             }
         }
@@ -194,12 +255,14 @@ private:
 
         diagram = tmpTable;
         mh.end(size());
+        rec.end(size());
     }
 
     template<typename SPEC>
     void zddSubsetMP_(SPEC const& spec) {
         MessageHandler mh;
         mh.begin(typenameof(spec));
+        BuildMetrics::Recorder rec(typenameof(spec));
         NodeTableHandler<ARITY> tmpTable;
         ZddSubsetterMP<SPEC> zs(diagram, spec, tmpTable);
         int n = zs.initialize(root_);
@@ -212,6 +275,8 @@ private:
             for (int i = n; i > 0; --i) {
                 zs.subset(i);
                 diagram.derefLevel(i);
+                rec.level(LevelMetrics(i, (*tmpTable)[i].size()));
+                control_(i, *tmpTable);
                 mh.step();
             }
         }
@@ -221,6 +286,7 @@ private:
 
         diagram = tmpTable;
         mh.end(size());
+        rec.end(size());
     }
 
 public:
@@ -390,6 +456,7 @@ public:
     void reduce() {
         MessageHandler mh;
         mh.begin("reduction");
+        BuildMetrics::Recorder rec("reduction");
         int n = root_.row();
 
 #ifdef _OPENMP
@@ -401,11 +468,16 @@ public:
 
         mh.setSteps(n);
         for (int i = 1; i <= n; ++i) {
+            size_t m = zr.inputTable()[i].size();
             zr.reduce(i, useMP);
+            size_t mm = (*diagram)[i].size();
+            rec.level(LevelMetrics(i, mm, m - mm));
+            control_(i, *diagram);
             mh.step();
         }
 
         mh.end(size());
+        rec.end(size());
     }
 
 public:
@@ -440,12 +512,108 @@ public:
 
     /**
      * Counts the number of sets in the family of sets represented by this ZDD.
+     * The sets are counted in 128-bit integers, and only the nodes whose
+     * counts do not fit are counted in arbitrary-precision integers.
      * @return the number of itemsets.
      */
     std::string zddCardinality() const {
+#ifdef __SIZEOF_INT128__
+        return evaluate(ZddCardinality128<ARITY>());
+#else
         return evaluate(ZddCardinality<std::string,ARITY>());
+#endif
+    }
+
+private:
+    /**
+     * Evaluates the nodes at one level.
+     * @param node the nodes at the level.
+     * @param i the level.
+     * @param work the values of the lower levels.
+     * @param eval the evaluator.
+     * @param evals the evaluators for each thread.
+     * @param useMP use an algorithm for multiple processors.
+     */
+    template<typename S, typename T>
+    static void evaluateLevel_(MyVector<Node<ARITY> > const& node, int i,
+                               DataTable<T>& work, S& eval,
+                               MyVector<S>& evals, bool useMP) {
+        size_t const m = node.size();
+        work[i].resize(m);
+
+#ifdef _OPENMP
+        if (useMP)
+#pragma omp parallel
+        {
+            int k = omp_get_thread_num();
+
+#pragma omp for schedule(static)
+            for (intmax_t j = 0; j < intmax_t(m); ++j) {
+                DdValues<T,ARITY> values;
+                for (int b = 0; b < ARITY; ++b) {
+                    NodeId f = node[j].branch[b];
+                    values.setReference(b, work[f.row()][f.col()]);
+                    values.setLevel(b, f.row());
+                }
+                evals[k].evalNode(work[i][j], i, values);
+            }
+        }
+        else
+#endif
+        for (size_t j = 0; j < m; ++j) {
+            DdValues<T,ARITY> values;
+            for (int b = 0; b < ARITY; ++b) {
+                NodeId f = node[j].branch[b];
+                values.setReference(b, work[f.row()][f.col()]);
+                values.setLevel(b, f.row());
+            }
+            eval.evalNode(work[i][j], i, values);
+        }
     }
 
+    /**
+     * Releases the values of the given levels.
+     * With multiple processors, the values are reset by the threads that
+     * have computed them in evaluateLevel_(), so that values owning
+     * memory, such as polynomials, are freed in parallel into the
+     * allocators they came from.
+     * @param levels the levels.
+     * @param work the values.
+     * @param eval the evaluator.
+     * @param evals the evaluators for each thread.
+     * @param useMP use an algorithm for multiple processors.
+     */
+    template<typename S, typename T>
+    static void releaseLevels_(MyVector<int> const& levels,
+                               DataTable<T>& work, S& eval,
+                               MyVector<S>& evals, bool useMP) {
+#ifdef _OPENMP
+        if (useMP)
+#pragma omp parallel
+        {
+            int k = omp_get_thread_num();
+            for (int const* t = levels.begin(); t != levels.end(); ++t) {
+                MyVector<T>& values = work[*t];
+                intmax_t const m = values.size();
+
+                // the same partition as that of evaluateLevel_()
+#pragma omp for schedule(static)
+                for (intmax_t j = 0; j < m; ++j) {
+                    values[j] = T();
+                }
+            }
+            for (int const* t = levels.begin(); t != levels.end(); ++t) {
+                evals[k].destructLevel(*t);
+            }
+        }
+#endif
+        for (int const* t = levels.begin(); t != levels.end(); ++t) {
+            work[*t].clear();
+            eval.destructLevel(*t);
+        }
+    }
+
+public:
     /**
      * Evaluates the DD from the bottom to the top.
      * @param evaluator the driver class that implements DdEval interface.
@@ -456,10 +624,13 @@ public:
         S eval(evaluator.entity()); // copied
 #ifdef _OPENMP
         bool useMP = this->useMP && eval.isThreadSafe();
+#else
+        bool useMP = false;
 #endif
         bool msg = eval.showMessages();
         int n = root_.row();
 
+        BuildMetrics::Recorder rec(typenameof(eval));
         MessageHandler mh;
         if (msg) {
             mh.begin(typenameof(eval));
@@ -469,10 +640,11 @@ public:
             mh.setSteps(n);
         }
 
+        int threads = 0;
 #ifdef _OPENMP
-        int threads = useMP ? omp_get_max_threads() : 0;
-        MyVector<S> evals(threads, eval);
+        if (useMP) threads = omp_get_max_threads();
 #endif
+        MyVector<S> evals(threads, eval);
         eval.initialize(n);
 #ifdef _OPENMP
         if (useMP)
@@ -494,59 +666,104 @@ public:
         }
 
         for (int i = 1; i <= n; ++i) {
-            MyVector<Node<ARITY> > const& node = (*diagram)[i];
-            size_t const m = node.size();
-            work[i].resize(m);
+            evaluateLevel_((*diagram)[i], i, work, eval, evals, useMP);
+            releaseLevels_(diagram->lowerLevels(i), work, eval, evals,
+                           useMP);
+            rec.level(LevelMetrics(i, (*diagram)[i].size()));
+            control_(i, *diagram);
+            if (msg) mh.step();
+        }
 
+        R retval = eval.getValue(work[root_.row()][root_.col()]);
+        if (msg) mh.end();
+        rec.end(size());
+        return retval;
+    }
+
+    /**
+     * ZDD reduction and evaluation in one sweep from the bottom to the top.
+     * Each level is evaluated as soon as it is reduced, and the nodes and
+     * values of the levels that are no longer referred are released at
+     * once.  The result is the same as that of zddReduce() followed by
+     * evaluate(), but the whole reduced DD is never held in memory.
+     * This DD structure is left empty.
+     * @param evaluator the driver class that implements DdEval interface.
+     * @param writer the writer to which the reduced DD is saved, if any;
+     *        each level is written as soon as it is reduced.
+     * @return value at the root.
+     */
+    template<typename S, typename T, typename R>
+    R zddReduceAndEvaluate(DdEval<S,T,R> const& evaluator,
+                           Writer* writer = 0) {
+        S eval(evaluator.entity()); // copied
 #ifdef _OPENMP
-            if (useMP)
-#pragma omp parallel
-            {
-                int k = omp_get_thread_num();
+        bool useMPEval = useMP && eval.isThreadSafe();
+#else
+        bool useMPEval = false;
+#endif
+        int n = root_.row();
 
-#pragma omp for schedule(static)
-                for (intmax_t j = 0; j < intmax_t(m); ++j) {
-                    DdValues<T,ARITY> values;
-                    for (int b = 0; b < ARITY; ++b) {
-                        NodeId f = node[j].branch[b];
-                        values.setReference(b, work[f.row()][f.col()]);
-                        values.setLevel(b, f.row());
-                    }
-                    evals[k].evalNode(work[i][j], i, values);
-                }
-            }
-            else
+        MessageHandler mh;
+        mh.begin("reduction");
+#ifdef _OPENMP
+        if (useMP) mh << " " << omp_get_max_threads() << "x";
 #endif
-            for (size_t j = 0; j < m; ++j) {
-                DdValues<T,ARITY> values;
-                for (int b = 0; b < ARITY; ++b) {
-                    NodeId f = node[j].branch[b];
-                    values.setReference(b, work[f.row()][f.col()]);
-                    values.setLevel(b, f.row());
-                }
-                eval.evalNode(work[i][j], i, values);
-            }
+        mh << " + " << typenameof(eval);
+        mh.setSteps(n);
+        BuildMetrics::Recorder rec("reduction + " + typenameof(eval));
 
-            MyVector<int> const& levels = diagram->lowerLevels(i);
-            for (int const* t = levels.begin(); t != levels.end(); ++t) {
-                work[*t].clear();
-                eval.destructLevel(*t);
-            }
+        int threads = 0;
 #ifdef _OPENMP
-            if (useMP)
+        if (useMPEval) threads = omp_get_max_threads();
+#endif
+        MyVector<S> evals(threads, eval);
+        eval.initialize(n);
+#ifdef _OPENMP
+        if (useMPEval)
 #pragma omp parallel
-            {
-                int k = omp_get_thread_num();
+        {
+            int k = omp_get_thread_num();
+            evals[k].initialize(n);
+        }
+#endif
+
+        DdReducer<ARITY,false,true> zr(diagram, useMP);
+        zr.setRoot(root_);
+        NodeTableEntity<ARITY>& output = zr.reducedTable();
+
+        DataTable<T> work(n + 1);
+        work[0].resize(2);
+        for (size_t j = 0; j < 2; ++j) {
+            eval.evalTerminal(work[0][j], j);
+        }
+        if (writer) writer->write(output[0]);
+
+        size_t reduced = 0;
+        for (int i = 1; i <= n; ++i) {
+            MyVector<int> const& levels = zr.lowerLevels(i);
+            size_t m = zr.inputTable()[i].size();
+            zr.reduce(i, useMP);
+            if (writer) writer->write(output[i]);
+            size_t mm = output[i].size();
+            rec.level(LevelMetrics(i, mm, m - mm));
+            reduced += mm;
+            evaluateLevel_(output[i], i, work, eval, evals, useMPEval);
+            if (i < n) {
+                releaseLevels_(levels, work, eval, evals, useMPEval);
                 for (int const* t = levels.begin(); t != levels.end(); ++t) {
-                    evals[k].destructLevel(*t);
+                    output[*t].clear();
                 }
             }
-#endif
-            if (msg) mh.step();
+            control_(i, output);
+            mh.step();
         }
 
         R retval = eval.getValue(work[root_.row()][root_.col()]);
-        if (msg) mh.end();
+        if (writer) writer->finish(root_);
+        diagram = NodeTableHandler<ARITY>();
+        root_ = NodeId(0);
+        mh.end();
+        rec.end(reduced);
         return retval;
     }
 
@@ -652,6 +869,195 @@ public:
         }
     };
 
+    /**
+     * Enumerator of the instances of a binary ZDD in batches.
+     * The items of many instances are written into one flat buffer with
+     * the offsets of the instances, so that no memory is allocated per
+     * instance.  The instances come in the same order as those of
+     * const_iterator; the items of each instance are in descending order.
+     * The enumeration can be saved in a Cursor and resumed later by
+     * another enumerator of the same DD.
+     */
+    class Enumerator {
+        struct Selection {
+            NodeId node;
+            bool val;
+
+            Selection() :
+                    val(false) {
+            }
+
+            Selection(NodeId node, bool val) :
+                    node(node), val(val) {
+            }
+        };
+
+    public:
+        /// States of an enumeration.
+        enum Status {
+            READY, ///< No instance has been emitted.
+            RUNNING, ///< Some instances have been emitted.
+            FINISHED ///< All instances have been emitted.
+        };
+
+        /**
+         * Saved position of an enumeration.
+         */
+        struct Cursor {
+            Status status; ///< the state.
+            std::vector<int> items; ///< the items of the last instance.
+
+            Cursor() :
+                    status(READY) {
+            }
+        };
+
+    private:
+        DdStructure const& dd;
+        Status status;
+        int cursor;
+        std::vector<Selection> path;
+
+    public:
+        /**
+         * Constructor.
+         * @param dd the ZDD, which must not be changed while enumerated.
+         */
+        explicit Enumerator(DdStructure const& dd) :
+                dd(dd), status(READY), cursor(-1) {
+        }
+
+        /**
+         * Checks if all instances have been emitted.
+         * @return true if finished.
+         */
+        bool finished() const {
+            return status == FINISHED;
+        }
+
+        /**
+         * Emits the next instances.
+         * The buffers are cleared first.  The items of the k-th instance
+         * are @p items[@p offsets[k]] to @p items[@p offsets[k+1] - 1].
+         * @param items the buffer of the items.
+         * @param offsets the buffer of the offsets, which gets one more
+         *        entry than the number of instances.
+         * @param max the maximum number of instances.
+         * @return the number of instances emitted, which is 0 only when
+         *         the enumeration has finished.
+         */
+        size_t next(std::vector<int>& items, std::vector<size_t>& offsets,
+                    size_t max) {
+            items.clear();
+            offsets.clear();
+            offsets.push_back(0);
+
+            size_t k = 0;
+            while (k < max && status != FINISHED) {
+                if (!find(status == READY ? dd.root_ : NodeId(0, 0))) {
+                    status = FINISHED;
+                    break;
+                }
+                status = RUNNING;
+
+                for (size_t i = 0; i < path.size(); ++i) {
+                    if (path[i].val) items.push_back(path[i].node.row());
+                }
+                offsets.push_back(items.size());
+                ++k;
+            }
+            return k;
+        }
+
+        /**
+         * Saves the position of the enumeration.
+         * @return the cursor.
+         */
+        Cursor save() const {
+            Cursor c;
+            c.status = status;
+            if (status == RUNNING) {
+                for (size_t i = 0; i < path.size(); ++i) {
+                    if (path[i].val) c.items.push_back(path[i].node.row());
+                }
+            }
+            return c;
+        }
+
+        /**
+         * Resumes an enumeration from a saved position.
+         * @param c the cursor saved by an enumerator of the same DD.
+         */
+        void restore(Cursor const& c) {
+            status = c.status;
+            cursor = -1;
+            path.clear();
+            if (status != RUNNING) return;
+
+            NodeId f = dd.root_;
+            size_t k = 0;
+            while (f > 1) {
+                Node<ARITY> const& s = (*dd.diagram)[f.row()][f.col()];
+                if (k < c.items.size() && c.items[k] == f.row()) {
+                    path.push_back(Selection(f, true));
+                    f = s.branch[1];
+                    ++k;
+                }
+                else {
+                    cursor = path.size();
+                    path.push_back(Selection(f, false));
+                    f = s.branch[0];
+                }
+            }
+            if (f != 1 || k != c.items.size()) throw std::runtime_error(
+                    "The cursor is not an instance of this DD");
+        }
+
+    private:
+        /**
+         * Finds the next path to the 1-terminal.
+         * @param f the node to go down from, or the 0-terminal to go up
+         *        from the current path.
+         * @return false if no path is found.
+         */
+        bool find(NodeId f) {
+            for (;;) {
+                while (f > 1) { /* down */
+                    Node<ARITY> const& s = (*dd.diagram)[f.row()][f.col()];
+
+                    if (s.branch[0] != 0) {
+                        cursor = path.size();
+                        path.push_back(Selection(f, false));
+                        f = s.branch[0];
+                    }
+                    else {
+                        path.push_back(Selection(f, true));
+                        f = s.branch[1];
+                    }
+                }
+
+                if (f == 1) return true; /* found */
+
+                for (; cursor >= 0; --cursor) { /* up */
+                    Selection& sel = path[cursor];
+                    Node<ARITY> const& ss =
+                            (*dd.diagram)[sel.node.row()][sel.node.col()];
+                    if (sel.val == false && ss.branch[1] != 0) {
+                        sel.val = true;
+                        path.resize(cursor + 1);
+                        f = ss.branch[1];
+                        break;
+                    }
+                }
+
+                if (cursor < 0) {
+                    path.clear();
+                    return false;
+                }
+            }
+        }
+    };
+
     /**
      * Returns an iterator to the first instance,
      * which is viewed as a collection of item numbers.
@@ -696,6 +1102,182 @@ public:
         return f.hash();
     }
 
+    /**
+     * Writer of the binary format of save().
+     * Rows are appended from the terminal row upward, so that a DD can be
+     * written level by level while it is reduced.  Write errors do not
+     * throw; they are reported by finish().
+     */
+    class Writer {
+        std::FILE* fp;
+        std::string label;
+        MyVector<uint64_t> sizes;
+        bool ok;
+
+        Writer(Writer const&);
+        Writer& operator=(Writer const&);
+
+        bool writeHeader(NodeId root) {
+            FileHeader h;
+            std::memcpy(h.magic, fileMagic(), sizeof(h.magic));
+            h.arity = ARITY;
+            h.numRows = sizes.size();
+            h.root = root.code();
+            h.labelSize = label.size();
+            return std::fwrite(&h, sizeof(h), 1, fp) == 1;
+        }
+
+    public:
+        /**
+         * Opens a file.
+         * @param path the file name.
+         * @param label the label to be checked by load().
+         */
+        Writer(std::string const& path, std::string const& label) :
+                fp(std::fopen(path.c_str(), "wb")), label(label), ok(fp != 0) {
+            if (!ok) return;
+            static char const padding[8] = {};
+            ok = writeHeader(NodeId(0))
+                    && std::fwrite(label.data(), 1, label.size(), fp)
+                            == label.size()
+                    && std::fwrite(padding, 1, labelPadding(label.size()), fp)
+                            == labelPadding(label.size());
+        }
+
+        ~Writer() {
+            if (fp != 0) std::fclose(fp);
+        }
+
+        /**
+         * Appends the next row.
+         * @param row the nodes of the row.
+         */
+        void write(MyVector<Node<ARITY> > const& row) {
+            size_t const m = row.size();
+            sizes.push_back(m);
+            if (ok && m > 0) {
+                ok = std::fwrite(row.data(), sizeof(Node<ARITY>), m, fp) == m;
+            }
+        }
+
+        /**
+         * Completes the file.
+         * @param root the root node.
+         * @return true if the whole file has been written.
+         */
+        bool finish(NodeId root) {
+            if (fp == 0) return false;
+            if (ok) {
+                ok = std::fwrite(sizes.data(), sizeof(uint64_t), sizes.size(),
+                                 fp) == sizes.size()
+                        && std::fseek(fp, 0, SEEK_SET) == 0
+                        && writeHeader(root);
+            }
+            if (std::fclose(fp) != 0) ok = false;
+            fp = 0;
+            return ok;
+        }
+
+        /**
+         * Checks if finish() has completed the file.
+         * @return true if the file is complete.
+         */
+        bool finished() const {
+            return fp == 0 && ok;
+        }
+    };
+
+    /**
+     * Writes this DD into a file in a binary format.
+     * The node codes are written as they are, so that the file can be
+     * read back only on machines of the same byte order.
+     * @param path the file name.
+     * @param label the label to be checked by load().
+     */
+    void save(std::string const& path,
+              std::string const& label = std::string()) const {
+        Writer w(path, label);
+        int const n = diagram->numRows();
+        for (int i = 0; i < n; ++i) {
+            w.write((*diagram)[i]);
+        }
+        if (!w.finish(root_)) throw std::runtime_error("Can't write " + path);
+    }
+
+    /**
+     * Reads a DD written by save().
+     * The file is mapped into memory and copied into the node table.
+     * @param path the file name.
+     * @param label the label given to save().
+     */
+    void load(std::string const& path,
+              std::string const& label = std::string()) {
+        MappedFile file(path);
+        char const* p = file.data();
+        size_t const size = file.size();
+        std::string const error = "Broken DD file: " + path;
+
+        FileHeader h;
+        if (size < sizeof(h)) throw std::runtime_error(error);
+        std::memcpy(&h, p, sizeof(h));
+        if (std::memcmp(h.magic, fileMagic(), sizeof(h.magic)) != 0
+                || h.arity != ARITY || h.numRows < 1
+                || h.numRows > NODE_ROW_MAX + 1) throw std::runtime_error(
+                error);
+        if (h.labelSize != label.size()
+                || size - sizeof(h) < label.size()
+                || label.compare(0, label.size(), p + sizeof(h),
+                                 label.size()) != 0) throw std::runtime_error(
+                "Label mismatch: " + path);
+
+        // the header, the label, the rows, and the sizes must fill the
+        // file exactly
+        int const n = h.numRows;
+        size_t rest = size - sizeof(h);
+        if (rest < label.size() + labelPadding(label.size())
+                || (rest -= label.size() + labelPadding(label.size()))
+                        / sizeof(uint64_t) < size_t(n))
+            throw std::runtime_error(error);
+        rest -= n * sizeof(uint64_t);
+        MyVector<uint64_t> sizes(n);
+        std::memcpy(sizes.data(), p + size - n * sizeof(uint64_t),
+                    n * sizeof(uint64_t));
+        if (sizes[0] != 2 || rest % sizeof(Node<ARITY>) != 0)
+            throw std::runtime_error(error);
+        rest /= sizeof(Node<ARITY>);
+        for (int i = 0; i < n; ++i) {
+            if (sizes[i] > rest) throw std::runtime_error(error);
+            rest -= sizes[i];
+        }
+        if (rest != 0) throw std::runtime_error(error);
+
+        NodeTableHandler<ARITY> d(n);
+        NodeTableEntity<ARITY>& table = d.privateEntity();
+        p += sizeof(h) + label.size() + labelPadding(label.size())
+                + 2 * sizeof(Node<ARITY>);
+        for (int i = 1; i < n; ++i) {
+            size_t const m = sizes[i];
+            table.initRow(i, m);
+            if (m > 0) std::memcpy(table[i].data(), p,
+                                   m * sizeof(Node<ARITY>));
+            p += m * sizeof(Node<ARITY>);
+
+            for (size_t j = 0; j < m; ++j) {
+                for (int b = 0; b < ARITY; ++b) {
+                    NodeId f = table[i][j].branch[b];
+                    if (f.row() >= i || f.col() >= sizes[f.row()])
+                        throw std::runtime_error(error);
+                }
+            }
+        }
+
+        NodeId root(h.root);
+        if (root.row() >= n || root.col() >= sizes[root.row()])
+            throw std::runtime_error(error);
+        diagram = d;
+        root_ = root;
+    }
+
     /**
      * Dumps the node table in Sapporo ZDD format.
      * Works only for binary DDs.
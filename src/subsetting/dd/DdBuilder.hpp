@@ -26,8 +26,10 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <ostream>
 #include <stdexcept>
+#include <type_traits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -37,17 +39,87 @@
 #include "Node.hpp"
 #include "NodeTable.hpp"
 #include "../DdSpec.hpp"
+#include "../util/BuildMetrics.hpp"
+#include "../util/FingerprintTable.hpp"
 #include "../util/MemoryPool.hpp"
 #include "../util/MessageHandler.hpp"
 #include "../util/MyHashTable.hpp"
 #include "../util/MyList.hpp"
 #include "../util/MyVector.hpp"
+#include "../util/PackedStore.hpp"
+#include "../util/SpillFile.hpp"
 
 namespace tdzdd {
 
 class DdBuilderBase {
+    static size_t& spillBudget_() {
+        static size_t budget = 0;
+        return budget;
+    }
+
+    static bool& packStates_() {
+        static bool flag = false;
+        return flag;
+    }
+
+public:
+    /**
+     * Gets the memory budget for the spec nodes waiting at lower levels.
+     * @return the budget in bytes; 0 means unlimited.
+     */
+    static size_t spillBudget() {
+        return spillBudget_();
+    }
+
+    /**
+     * Sets the memory budget for the spec nodes waiting at lower levels.
+     * When the budget is exceeded, the sequential builders move whole
+     * levels to temporary files, lowest first, and read them back when
+     * the levels are built.
+     * @param bytes the budget in bytes; 0 means unlimited.
+     * @return the old budget.
+     */
+    static size_t spillBudget(size_t bytes) {
+        size_t old = spillBudget_();
+        spillBudget_() = bytes;
+        return old;
+    }
+
+    /**
+     * Checks if the spec nodes waiting at lower levels are packed.
+     * @return true if they are packed.
+     */
+    static bool packStates() {
+        return packStates_();
+    }
+
+    /**
+     * Sets whether the sequential builders pack the spec nodes waiting at
+     * lower levels in PackedStore, which keeps the bytes that differ from
+     * the previous node of the level.  A level is unpacked when it is
+     * built, and packed levels are spilled first when a budget is set.
+     * @param flag true to pack them.
+     * @return the old setting.
+     */
+    static bool packStates(bool flag) {
+        bool old = packStates_();
+        packStates_() = flag;
+        return old;
+    }
+
+    /**
+     * Checks if the sequential builders spill or pack the states of a spec.
+     * Only trivially copyable states are moved out of the node tables.
+     * @return true if they do.
+     */
+    template<typename SPEC>
+    static bool movesStates() {
+        return SPEC::TRIVIAL_STATES && (spillBudget() != 0 || packStates());
+    }
+
 protected:
     static int const headerSize = 1;
+    static size_t const SPILL_CHECK_INTERVAL = 4096;
 
     /* SpecNode
      * ┌────────┬────────┬────────┬─────
@@ -80,6 +152,19 @@ protected:
         return p + headerSize;
     }
 
+    /**
+     * Destructs the states of the spec nodes in a list.
+     * @param spec the spec.
+     * @param snodes the list.
+     */
+    template<typename SPEC, typename LIST>
+    static void destructStates(SPEC& spec, LIST& snodes) {
+        for (typename LIST::iterator t = snodes.begin(); t != snodes.end();
+                ++t) {
+            spec.destruct(state(*t));
+        }
+    }
+
     static int getSpecNodeSize(int n) {
         if (n < 0)
             throw std::runtime_error("storage size is not initialized!!!");
@@ -143,6 +228,19 @@ protected:
         return p + headerSize;
     }
 
+    /**
+     * Destructs the states of the spec nodes in a list.
+     * @param spec the spec.
+     * @param snodes the list.
+     */
+    template<typename SPEC, typename LIST>
+    static void destructStates(SPEC& spec, LIST& snodes) {
+        for (typename LIST::iterator t = snodes.begin(); t != snodes.end();
+                ++t) {
+            spec.destruct(state(*t));
+        }
+    }
+
     static int getSpecNodeSize(int n) {
         if (n < 0)
             throw std::runtime_error("storage size is not initialized!!!");
@@ -174,7 +272,7 @@ protected:
 template<typename S>
 class DdBuilder: DdBuilderBase {
     typedef S Spec;
-    typedef MyHashTable<SpecNode*,Hasher<Spec>,Hasher<Spec> > UniqTable;
+    typedef FingerprintTable<SpecNode*> UniqTable;
     static int const AR = Spec::ARITY;
 
     Spec spec;
@@ -183,6 +281,11 @@ class DdBuilder: DdBuilderBase {
     DdSweeper<AR> sweeper;
 
     MyVector<MyList<SpecNode> > snodeTable;
+    MyVector<SpillFile> spillTable;
+    MyVector<PackedStore> packTable;
+    UniqTable uniq;
+    LevelMetrics levelMetrics_;
+    bool settled; ///< All waiting spec nodes hold live states.
 
     MyVector<char> oneStorage;
     void* const one;
@@ -190,22 +293,122 @@ class DdBuilder: DdBuilderBase {
 
     void init(int n) {
         snodeTable.resize(n + 1);
+        spillTable.resize(n + 1);
+        packTable.resize(n + 1);
         if (n >= output.numRows()) output.setNumRows(n + 1);
         oneSrcPtr.clear();
     }
 
+    /**
+     * Packs the spec nodes of a level waiting in memory.
+     * @param ii the level.
+     */
+    void packLevel(int ii) {
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        MyList<SpecNode>& snodes = snodeTable[ii];
+        for (; !snodes.empty(); snodes.pop_front()) {
+            packTable[ii].write(snodes.front(), bytes);
+        }
+    }
+
+    /**
+     * Moves waiting levels lower than @p i to temporary files
+     * if they exceed the memory budget, and packs the others
+     * if packing is enabled.
+     * @param i the level being built.
+     */
+    void spillLevels(int i) {
+        spillLevels(i, std::integral_constant<bool,Spec::TRIVIAL_STATES>());
+    }
+
+    /**
+     * Keeps the levels in memory; the states can't be moved bytewise.
+     */
+    void spillLevels(int, std::false_type) {
+    }
+
+    void spillLevels(int i, std::true_type) {
+        size_t const budget = spillBudget();
+        bool const pack = packStates();
+        if (budget == 0 && !pack) return;
+
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        size_t total = 0;
+        for (int ii = 1; ii < i; ++ii) {
+            total += snodeTable[ii].size() * bytes + packTable[ii].bytes();
+        }
+
+        // Level i - 1 holds a work area and is built next.
+        for (int ii = 1; ii < i - 1; ++ii) {
+            MyList<SpecNode>& snodes = snodeTable[ii];
+            PackedStore& store = packTable[ii];
+
+            if (budget != 0 && total > budget / 2) {
+                total -= snodes.size() * bytes + store.bytes();
+                if (!store.empty()) {
+                    MyVector<SpecNode> buf(specNodeSize);
+                    store.rewind();
+                    for (size_t k = 0; k < store.size(); ++k) {
+                        store.read(buf.data(), bytes);
+                        spillTable[ii].write(buf.data(), bytes);
+                    }
+                    store.clear();
+                }
+                for (; !snodes.empty(); snodes.pop_front()) {
+                    spillTable[ii].write(snodes.front(), bytes);
+                }
+            }
+            else if (pack) {
+                packLevel(ii);
+            }
+        }
+    }
+
+    /**
+     * Reads back the spilled and packed spec nodes of a level.
+     * @param i the level.
+     */
+    void restoreLevel(int i) {
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        SpillFile& file = spillTable[i];
+        if (!file.empty()) {
+            file.rewind();
+            for (size_t k = 0; k < file.size(); ++k) {
+                file.read(snodeTable[i].alloc_front(specNodeSize), bytes);
+            }
+            file.clear();
+        }
+
+        PackedStore& store = packTable[i];
+        if (!store.empty()) {
+            store.rewind();
+            for (size_t k = 0; k < store.size(); ++k) {
+                store.read(snodeTable[i].alloc_front(specNodeSize), bytes);
+            }
+            store.clear();
+        }
+    }
+
 public:
     DdBuilder(Spec const& spec, NodeTableHandler<AR>& output, int n = 0) :
             spec(spec),
             specNodeSize(getSpecNodeSize(spec.datasize())),
             output(output.privateEntity()),
             sweeper(this->output, oneSrcPtr),
+            settled(true),
             oneStorage(spec.datasize()),
             one(oneStorage.data()) {
         if (n >= 1) init(n);
     }
 
     ~DdBuilder() {
+        // states left by an exception between levels; spilled and packed
+        // states are trivially destructible
+        if (settled) {
+            for (size_t i = 0; i < snodeTable.size(); ++i) {
+                destructStates(spec, snodeTable[i]);
+            }
+        }
         if (!oneSrcPtr.empty()) {
             spec.destruct(one);
             oneSrcPtr.clear();
@@ -224,6 +427,28 @@ public:
         srcPtr(p0) = fp;
     }
 
+    /**
+     * Gets the statistics of the level built last.
+     * @return the statistics.
+     */
+    LevelMetrics const& levelMetrics() const {
+        return levelMetrics_;
+    }
+
+    /**
+     * Gets the memory used by the spec nodes waiting in memory.
+     * @return the number of bytes.
+     */
+    size_t pendingBytes() const {
+        size_t count = 0;
+        size_t packed = 0;
+        for (size_t i = 0; i < snodeTable.size(); ++i) {
+            count += snodeTable[i].size();
+            packed += packTable[i].bytes();
+        }
+        return count * specNodeSize * sizeof(SpecNode) + packed;
+    }
+
     /**
      * Initializes the builder.
      * @param root result storage.
@@ -257,6 +482,8 @@ public:
      */
     void construct(int i) {
         assert(0 < i && size_t(i) < snodeTable.size());
+        settled = false;
+        restoreLevel(i);
 
         MyList<SpecNode> &snodes = snodeTable[i];
         size_t j0 = output[i].size();
@@ -266,12 +493,12 @@ public:
 
         {
             Hasher<Spec> hasher(spec, i);
-            UniqTable uniq(snodes.size() * 2, hasher, hasher);
+            uniq.initialize(snodes.size());
 
             for (MyList<SpecNode>::iterator t = snodes.begin();
                     t != snodes.end(); ++t) {
                 SpecNode* p = *t;
-                SpecNode*& p0 = uniq.add(p);
+                SpecNode*& p0 = uniq.add(p, hasher, hasher);
 
                 if (p0 == p) {
                     nodeId(p) = *srcPtr(p) = NodeId(i, m++);
@@ -294,6 +521,11 @@ public:
                     }
                 }
             }
+
+            size_t const made = m - j0;
+            levelMetrics_ = LevelMetrics(i, made, snodes.size() - made, 0,
+                    uniq.tableSize() > 0 ?
+                            double(uniq.size()) / uniq.tableSize() : 0);
 //#ifdef DEBUG
 //            MessageHandler mh;
 //            mh << "table_size[" << i << "] = " << uniq.tableSize() << "\n";
@@ -305,10 +537,22 @@ public:
         size_t jj = j0;
         SpecNode* pp = snodeTable[i - 1].alloc_front(specNodeSize);
 
+        size_t count = 0;
+
         for (; !snodes.empty(); snodes.pop_front()) {
             SpecNode* p = snodes.front();
             Node<AR>& q = outi[jj];
 
+            if (++count % SPILL_CHECK_INTERVAL == 0) {
+                spillLevels(i);
+                if (packStates()) {
+                    // the work area is allocated again after packing
+                    snodeTable[i - 1].pop_front();
+                    packLevel(i - 1);
+                    pp = snodeTable[i - 1].alloc_front(specNodeSize);
+                }
+            }
+
             if (nodeId(p) == 1) {
                 spec.destruct(state(p));
                 continue;
@@ -382,9 +626,12 @@ public:
             if (allZero) ++deadCount;
         }
 
+        spillLevels(i);
         snodeTable[i - 1].pop_front();
         spec.destructLevel(i);
         sweeper.update(i, lowestChild, deadCount);
+        levelMetrics_.dead = deadCount;
+        settled = true;
     }
 };
 
@@ -394,7 +641,7 @@ public:
 template<typename S>
 class DdBuilderMP: DdBuilderMPBase {//TODO oneStorage
     typedef S Spec;
-    typedef MyHashTable<SpecNode*,Hasher<Spec>,Hasher<Spec> > UniqTable;
+    typedef FingerprintTable<SpecNode*> UniqTable;
     static int const AR = Spec::ARITY;
     static int const TASKS_PER_THREAD = 10;
 
@@ -407,6 +654,7 @@ class DdBuilderMP: DdBuilderMPBase {//TODO oneStorage
     DdSweeper<AR> sweeper;
 
     MyVector<MyVector<MyVector<MyList<SpecNode> > > > snodeTables;
+    bool settled; ///< All waiting spec nodes hold live states.
 
 #ifdef DEBUG
     ElapsedTimeCounter etcP1, etcP2, etcS1;
@@ -435,7 +683,8 @@ public:
             specNodeSize(getSpecNodeSize(s.datasize())),
             output(output.privateEntity()),
             sweeper(this->output),
-            snodeTables(threads) {
+            snodeTables(threads),
+            settled(true) {
         if (n >= 1) init(n);
 #ifdef DEBUG
         MessageHandler mh;
@@ -443,14 +692,24 @@ public:
 #endif
     }
 
-#ifdef DEBUG
     ~DdBuilderMP() {
+        // states left by an exception between levels
+        if (settled) {
+            for (int y = 0; y < threads; ++y) {
+                for (size_t x = 0; x < snodeTables[y].size(); ++x) {
+                    for (size_t i = 0; i < snodeTables[y][x].size(); ++i) {
+                        destructStates(specs[0], snodeTables[y][x][i]);
+                    }
+                }
+            }
+        }
+#ifdef DEBUG
         MessageHandler mh;
         mh << "P1: " << etcP1 << "\n";
         mh << "P2: " << etcP2 << "\n";
         mh << "S1: " << etcS1 << "\n";
-    }
 #endif
+    }
 
     /**
      * Schedules a top-down event.
@@ -498,6 +757,7 @@ public:
         MyVector<size_t> nodeColumn(tasks);
         int lowestChild = i - 1;
         size_t deadCount = 0;
+        settled = false;
 
 #ifdef DEBUG
         etcP1.start();
@@ -519,7 +779,7 @@ public:
             MyVector<char> tmp(spec.datasize());
             void* const tmpState = tmp.data();
             Hasher<Spec> hasher(spec, i);
-            UniqTable uniq(hasher, hasher);
+            UniqTable uniq;
             int lc = lowestChild;
 
 #ifdef _OPENMP
@@ -532,7 +792,7 @@ public:
                 }
                 if (m == 0) continue;
 
-                uniq.initialize(m * 2);
+                uniq.initialize(m);
                 size_t j = 0;
 
                 for (int y = 0; y < threads; ++y) {
@@ -541,7 +801,7 @@ public:
                     for (MyList<SpecNode>::iterator t = snodes.begin();
                             t != snodes.end(); ++t) {
                         SpecNode* p = *t;
-                        SpecNode*& p0 = uniq.add(p);
+                        SpecNode*& p0 = uniq.add(p, hasher, hasher);
 
                         if (p0 == p) {
                             code(p) = ++j; // code(p) >= 1
@@ -665,6 +925,7 @@ public:
         }
 
         sweeper.update(i, lowestChild, deadCount);
+        settled = true;
 #ifdef DEBUG
         etcP2.stop();
 #endif
@@ -678,7 +939,7 @@ template<typename S>
 class ZddSubsetter: DdBuilderBase {
 //typedef typename std::remove_const<typename std::remove_reference<S>::type>::type Spec;
     typedef S Spec;
-    typedef MyHashTable<SpecNode*,Hasher<Spec>,Hasher<Spec> > UniqTable;
+    typedef FingerprintTable<SpecNode*> UniqTable;
     static int const AR = Spec::ARITY;
 
     Spec spec;
@@ -693,6 +954,118 @@ class ZddSubsetter: DdBuilderBase {
     MyVector<NodeBranchId> oneSrcPtr;
 
     MemoryPools pools;
+    MyVector<size_t> workCount;
+    MyVector<SpillFile> spillTable;
+    MyVector<PackedStore> packTable;
+    UniqTable uniq;
+    LevelMetrics levelMetrics_;
+    bool settled; ///< All waiting spec nodes hold live states.
+
+    /**
+     * Moves the spec nodes of a level waiting in memory to a store.
+     * Each record is a column number followed by a spec node.
+     * @param ii the level.
+     * @param store the temporary file or the packed store.
+     */
+    template<typename Store>
+    void moveLevel(int ii, Store& store) {
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        MyVector<char> buf(sizeof(size_t) + bytes);
+
+        for (size_t j = 0; j < work[ii].size(); ++j) {
+            MyListOnPool<SpecNode>& list = work[ii][j];
+            for (MyListOnPool<SpecNode>::iterator t = list.begin();
+                    t != list.end(); ++t) {
+                *reinterpret_cast<size_t*>(buf.data()) = j;
+                std::memcpy(buf.data() + sizeof(size_t), *t, bytes);
+                store.write(buf.data(), buf.size());
+            }
+            list.clear();
+        }
+        pools[ii].clear();
+        workCount[ii] = 0;
+    }
+
+    /**
+     * Moves waiting levels lower than @p i to temporary files
+     * if they exceed the memory budget, and packs the others
+     * if packing is enabled.
+     * @param i the level being built.
+     */
+    void spillLevels(int i) {
+        spillLevels(i, std::integral_constant<bool,Spec::TRIVIAL_STATES>());
+    }
+
+    /**
+     * Keeps the levels in memory; the states can't be moved bytewise.
+     */
+    void spillLevels(int, std::false_type) {
+    }
+
+    void spillLevels(int i, std::true_type) {
+        size_t const budget = spillBudget();
+        bool const pack = packStates();
+        if (budget == 0 && !pack) return;
+
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        size_t total = 0;
+        for (int ii = 1; ii < i; ++ii) {
+            total += workCount[ii] * bytes + packTable[ii].bytes();
+        }
+
+        for (int ii = 1; ii < i; ++ii) {
+            PackedStore& store = packTable[ii];
+
+            if (budget != 0 && total > budget / 2) {
+                if (workCount[ii] == 0 && store.empty()) continue;
+                total -= workCount[ii] * bytes + store.bytes();
+                if (!store.empty()) {
+                    MyVector<char> buf(sizeof(size_t) + bytes);
+                    store.rewind();
+                    for (size_t k = 0; k < store.size(); ++k) {
+                        store.read(buf.data(), buf.size());
+                        spillTable[ii].write(buf.data(), buf.size());
+                    }
+                    store.clear();
+                }
+                if (workCount[ii] != 0) moveLevel(ii, spillTable[ii]);
+            }
+            else if (pack && workCount[ii] != 0) {
+                moveLevel(ii, store);
+            }
+        }
+    }
+
+    /**
+     * Reads back the spec nodes of a level from a store.
+     * @param i the level.
+     * @param store the temporary file or the packed store.
+     */
+    template<typename Store>
+    void restoreLevel(int i, Store& store) {
+        if (store.empty()) return;
+
+        size_t const bytes = specNodeSize * sizeof(SpecNode);
+        MyVector<char> buf(sizeof(size_t) + bytes);
+        store.rewind();
+        for (size_t k = 0; k < store.size(); ++k) {
+            store.read(buf.data(), buf.size());
+            size_t j = *reinterpret_cast<size_t*>(buf.data());
+            SpecNode* p = work[i][j].alloc_front(pools[i], specNodeSize);
+            std::memcpy(p, buf.data() + sizeof(size_t), bytes);
+        }
+        workCount[i] += store.size();
+        store.clear();
+    }
+
+    /**
+     * Reads back the spilled and packed spec nodes of a level.
+     * @param i the level.
+     */
+    void restoreLevel(int i) {
+        restoreLevel(i, spillTable[i]);
+        restoreLevel(i, packTable[i]);
+    }
 
 public:
     ZddSubsetter(NodeTableHandler<AR> const& input, Spec const& s,
@@ -704,16 +1077,48 @@ public:
             work(input->numRows()),
             sweeper(this->output, oneSrcPtr),
             oneStorage(spec.datasize()),
-            one(oneStorage.data()) {
+            one(oneStorage.data()),
+            settled(true) {
     }
 
     ~ZddSubsetter() {
+        // states left by an exception between levels; spilled and packed
+        // states are trivially destructible
+        if (settled) {
+            for (int i = 0; i < work.numRows(); ++i) {
+                for (size_t j = 0; j < work[i].size(); ++j) {
+                    destructStates(spec, work[i][j]);
+                }
+            }
+        }
         if (!oneSrcPtr.empty()) {
             spec.destruct(one);
             oneSrcPtr.clear();
         }
     }
 
+    /**
+     * Gets the statistics of the level built last.
+     * @return the statistics.
+     */
+    LevelMetrics const& levelMetrics() const {
+        return levelMetrics_;
+    }
+
+    /**
+     * Gets the memory used by the spec nodes waiting in memory.
+     * @return the number of bytes.
+     */
+    size_t pendingBytes() const {
+        size_t count = 0;
+        size_t packed = 0;
+        for (size_t i = 0; i < workCount.size(); ++i) {
+            count += workCount[i];
+            packed += packTable[i].bytes();
+        }
+        return count * specNodeSize * sizeof(SpecNode) + packed;
+    }
+
     /**
      * Initializes the builder.
      * @param root the root node.
@@ -747,12 +1152,16 @@ public:
             assert(n == root.row());
 
             pools.resize(n + 1);
+            workCount.resize(n + 1);
+            spillTable.resize(n + 1);
+            packTable.resize(n + 1);
             work[n].resize(input[n].size());
 
             SpecNode* p0 = work[n][root.col()].alloc_front(pools[n],
                     specNodeSize);
             spec.get_copy(state(p0), tmpState);
             srcPtr(p0) = &root;
+            workCount[n] = 1;
         }
 
         spec.destruct(tmpState);
@@ -779,21 +1188,27 @@ public:
         size_t mm = 0;
         int lowestChild = i - 1;
         size_t deadCount = 0;
+        size_t total = 0;
+        size_t used = 0;
+        size_t slots = 0;
+        settled = false;
 
         if (work[i].empty()) work[i].resize(m);
         assert(work[i].size() == m);
+        restoreLevel(i);
 
         for (size_t j = 0; j < m; ++j) {
             MyListOnPool<SpecNode> &list = work[i][j];
             size_t n = list.size();
+            total += n;
 
             if (n >= 2) {
-                UniqTable uniq(n * 2, hasher, hasher);
+                uniq.initialize(n);
 
                 for (MyListOnPool<SpecNode>::iterator t = list.begin();
                         t != list.end(); ++t) {
                     SpecNode* p = *t;
-                    SpecNode*& p0 = uniq.add(p);
+                    SpecNode*& p0 = uniq.add(p, hasher, hasher);
 
                     if (p0 == p) {
                         nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
@@ -816,16 +1231,22 @@ public:
                         }
                     }
                 }
+
+                used += uniq.size();
+                slots += uniq.tableSize();
             }
             else if (n == 1) {
                 SpecNode* p = list.front();
                 nodeId(p) = *srcPtr(p) = NodeId(i, mm++);
             }
         }
+        levelMetrics_ = LevelMetrics(i, mm, total - mm, 0,
+                slots > 0 ? double(used) / slots : 0);
 
         output.initRow(i, mm);
         Node<AR>* const outi = output[i].data();
         size_t jj = 0;
+        size_t jj0 = 0;
 
         for (size_t j = 0; j < m; ++j) {
             MyListOnPool<SpecNode> &list = work[i][j];
@@ -909,6 +1330,7 @@ public:
                                 specNodeSize);
                         spec.get_copy(state(pp), tmpState);
                         srcPtr(pp) = &q.branch[b];
+                        ++workCount[ii];
                         if (ii < lowestChild) lowestChild = ii;
                         allZero = false;
                     }
@@ -920,12 +1342,21 @@ public:
                 ++jj;
                 if (allZero) ++deadCount;
             }
+
+            if (jj / SPILL_CHECK_INTERVAL != jj0 / SPILL_CHECK_INTERVAL) {
+                spillLevels(i);
+            }
+            jj0 = jj;
         }
 
+        spillLevels(i);
         work[i].clear();
         pools[i].clear();
+        workCount[i] = 0;
         spec.destructLevel(i);
         sweeper.update(i, lowestChild, deadCount);
+        levelMetrics_.dead = deadCount;
+        settled = true;
     }
 
 private:
@@ -958,7 +1389,7 @@ template<typename S>
 class ZddSubsetterMP: DdBuilderMPBase { //TODO oneStorage
 //typedef typename std::remove_const<typename std::remove_reference<S>::type>::type Spec;
     typedef S Spec;
-    typedef MyHashTable<SpecNode*,Hasher<Spec>,Hasher<Spec> > UniqTable;
+    typedef FingerprintTable<SpecNode*> UniqTable;
     static int const AR = Spec::ARITY;
 
     int const threads;
@@ -971,6 +1402,7 @@ class ZddSubsetterMP: DdBuilderMPBase { //TODO oneStorage
 
     MyVector<MyVector<MyVector<MyListOnPool<SpecNode> > > > snodeTables;
     MyVector<MemoryPools> pools;
+    bool settled; ///< All waiting spec nodes hold live states.
 
 public:
     ZddSubsetterMP(NodeTableHandler<AR> const& input,
@@ -988,7 +1420,21 @@ public:
             output(output.privateEntity()),
             sweeper(this->output),
             snodeTables(threads),
-            pools(threads) {
+            pools(threads),
+            settled(true) {
+    }
+
+    ~ZddSubsetterMP() {
+        // states left by an exception between levels
+        if (settled) {
+            for (int y = 0; y < threads; ++y) {
+                for (size_t i = 0; i < snodeTables[y].size(); ++i) {
+                    for (size_t j = 0; j < snodeTables[y][i].size(); ++j) {
+                        destructStates(specs[0], snodeTables[y][i][j]);
+                    }
+                }
+            }
+        }
     }
 
     /**
@@ -1052,6 +1498,7 @@ public:
         MyVector<size_t> nodeColumn(m);
         int lowestChild = i - 1;
         size_t deadCount = 0;
+        settled = false;
 
 #ifdef _OPENMP
         // OpenMP 2.0 does not support reduction(min:lowestChild)
@@ -1067,7 +1514,7 @@ public:
             MyVector<char> tmp(spec.datasize());
             void* const tmpState = tmp.data();
             Hasher<Spec> hasher(spec, i);
-            UniqTable uniq(hasher, hasher);
+            UniqTable uniq;
             int lc = lowestChild;
 
 #ifdef _OPENMP
@@ -1080,7 +1527,7 @@ public:
                     MyListOnPool<SpecNode> &snodes = snodeTables[y][i][j];
                     mm += snodes.size();
                 }
-                uniq.initialize(mm * 2);
+                uniq.initialize(mm);
                 size_t jj = 0;
 
                 for (int y = 0; y < threads; ++y) {
@@ -1090,7 +1537,7 @@ public:
                     for (MyListOnPool<SpecNode>::iterator t = snodes.begin();
                             t != snodes.end(); ++t) {
                         SpecNode* p = *t;
-                        SpecNode* pp = uniq.add(p);
+                        SpecNode* pp = uniq.add(p, hasher, hasher);
 
                         if (pp == p) {
                             code(p) = ++jj; // code(p) >= 1
@@ -1215,6 +1662,7 @@ public:
         }
 
         sweeper.update(i, lowestChild, deadCount);
+        settled = true;
     }
 
 private:
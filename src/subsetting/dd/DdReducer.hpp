@@ -38,6 +38,7 @@
 #include "../util/MyHashTable.hpp"
 #include "../util/MyList.hpp"
 #include "../util/MyVector.hpp"
+#include "../util/StateHash.hpp"
 
 namespace tdzdd {
 
@@ -69,15 +70,16 @@ class DdReducer {
     };
 
 #ifdef _OPENMP
-    static int const TASKS_PER_THREAD = 10;
+    static size_t const EMPTY = size_t(-1);
+    static size_t const MP_MIN_NODES = 1024; ///< Smallest level for reduceMP_.
 
     int const threads;
-    int const tasks;
-    MyVector<MyVector<MyList<ReducNodeInfo> > > taskMatrix;
+    MyVector<size_t> uniqTable; ///< Open addressing by node columns.
+    MyVector<size_t> uniqSlot; ///< Slot of each node in uniqTable.
     MyVector<size_t> baseColumn;
 
 #ifdef DEBUG
-    ElapsedTimeCounter etcP1, etcP2, etcP3, etcS0, etcS1, etcS2, etcS3, etcS4;
+    ElapsedTimeCounter etcP1, etcP2, etcS0, etcS1, etcS4;
 #endif
 #endif
 
@@ -93,16 +95,14 @@ public:
             rootPtr(input.numRows()),
 #ifdef _OPENMP
             threads(omp_get_max_threads()),
-            tasks(MyHashConstant::primeSize(TASKS_PER_THREAD * threads)),
-            taskMatrix(threads),
-            baseColumn(tasks + 1),
+            baseColumn(threads + 1),
 #endif
             readyForSequentialReduction(false) {
 #ifdef _OPENMP
 #ifdef DEBUG
         if (useMP) {
             MessageHandler mh;
-            mh << "#thread = " << threads << ", #task = " << tasks;
+            mh << "#thread = " << threads;
         }
         etcS0.start();
 #endif
@@ -117,9 +117,6 @@ public:
         newIdTable[0][1] = 1;
 
 #ifdef _OPENMP
-        for (int y = 0; y < threads; ++y) {
-            taskMatrix[y].resize(tasks);
-        }
 #ifdef DEBUG
         etcS0.stop();
 #endif
@@ -133,11 +130,8 @@ public:
             MessageHandler mh;
             mh << "P1: " << etcP1 << "\n";
             mh << "P2: " << etcP2 << "\n";
-            mh << "P3: " << etcP3 << "\n";
             mh << "S0: " << etcS0 << "\n";
             mh << "S1: " << etcS1 << "\n";
-            mh << "S2: " << etcS2 << "\n";
-            mh << "S3: " << etcS3 << "\n";
             mh << "S4: " << etcS4 << "\n";
         }
     }
@@ -200,6 +194,35 @@ public:
         rootPtr[root.row()].push_back(&root);
     }
 
+    /**
+     * Returns a collection of the lower levels that are not referred
+     * by the reduced nodes at the given level or at any higher levels.
+     * The first call must precede the reduction of any level.
+     * @param level the level.
+     */
+    MyVector<int> const& lowerLevels(int level) {
+        makeReadyForSequentialReduction();
+        return input.lowerLevels(level);
+    }
+
+    /**
+     * Gets the table of nodes to be reduced.
+     * Rows are cleared when they are no longer needed.
+     * @return the input table.
+     */
+    NodeTableEntity<ARITY> const& inputTable() const {
+        return input;
+    }
+
+    /**
+     * Gets the table of reduced nodes.
+     * Rows are complete up to the last level reduced.
+     * @return the output table.
+     */
+    NodeTableEntity<ARITY>& reducedTable() {
+        return output;
+    }
+
     /**
      * Reduces one level.
      * @param i level.
@@ -400,17 +423,39 @@ private:
 
     /**
      * Reduces one level using OpenMP.
+     * The nodes are made canonical and entered into a unique table shared
+     * by all threads, in which every slot keeps the smallest column of
+     * the equivalent nodes by compare-and-swap.  The nodes found in their
+     * slots are renumbered in the order of the columns by a prefix sum
+     * of the per-thread counts, so that the result does not depend on
+     * the number of threads.
+     * A single thread and small levels, on which the parallel region costs
+     * more than it saves, are left to reduce_(), which gives the same
+     * result.
      * @param i level.
      */
     void reduceMP_(int i) {
 #ifndef _OPENMP
         reduce_(i);
 #else
+        size_t const m = input[i].size();
+        if (threads == 1 || m < MP_MIN_NODES) {
+            reduce_(i);
+            return;
+        }
 #ifdef DEBUG
         etcS1.start();
 #endif
-        size_t const m = input[i].size();
         newIdTable[i].resize(m);
+        if (uniqSlot.size() < m) uniqSlot.resize(m);
+
+        size_t capacity = 16;
+        while (capacity < m + m / 2) {
+            capacity <<= 1;
+        }
+        if (uniqTable.size() < capacity) uniqTable.resize(capacity);
+        size_t const mask = capacity - 1;
+        MyVector<int> const& levels = input.lowerLevels(i);
 #ifdef DEBUG
         etcS1.stop();
         etcP1.start();
@@ -418,8 +463,15 @@ private:
 
 #pragma omp parallel
         {
-            int y = omp_get_thread_num();
-            MyHashTable<ReducNodeInfo const*> uniq;
+            int const y = omp_get_thread_num();
+            int const yy = omp_get_num_threads();
+            size_t const lo = m * y / yy;
+            size_t const hi = m * (y + 1) / yy;
+
+#pragma omp for schedule(static)
+            for (size_t k = 0; k < capacity; ++k) {
+                uniqTable[k] = EMPTY;
+            }
 
 #pragma omp for schedule(static)
             for (size_t j = 0; j < m; ++j) {
@@ -438,114 +490,79 @@ private:
 
                 if (del) { // f is redundant
                     newIdTable[i][j] = f0;
+                    uniqSlot[j] = EMPTY;
                     continue;
                 }
 
-                // schedule a task
-                int x = f.hash() % tasks;
-                ReducNodeInfo* p = taskMatrix[y][x].alloc_front();
-                p->children = f;
-                p->column = j;
+                // find the slot of f
+                size_t k = StateHash::mix(f.hash()) & mask;
+                for (;;) {
+                    size_t* p = &uniqTable[k];
+                    size_t jj = __atomic_load_n(p, __ATOMIC_ACQUIRE);
+                    if (jj == EMPTY) {
+                        if (__atomic_compare_exchange_n(p, &jj, j, false,
+                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) break;
+                    }
+                    if (input[i][jj] == f) {
+                        while (j < jj && !__atomic_compare_exchange_n(p, &jj,
+                                j, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                        }
+                        break;
+                    }
+                    k = (k + 1) & mask;
+                }
+                uniqSlot[j] = k;
             }
 
-#pragma omp single
-            {
 #ifdef DEBUG
+#pragma omp master
+            {
                 etcP1.stop();
-                etcS2.start();
-#endif
-                MyVector<int> const& levels = input.lowerLevels(i);
-                for (int const* t = levels.begin(); t != levels.end(); ++t) {
-                    newIdTable[*t].clear();
-                }
-#ifdef DEBUG
-                etcS2.stop();
                 etcP2.start();
-#endif
             }
-
-#pragma omp for schedule(dynamic)
-            for (int x = 0; x < tasks; ++x) {
-                size_t mm = 0;
-                for (int yy = 0; yy < threads; ++yy) {
-                    mm += taskMatrix[yy][x].size();
-                }
-                if (mm == 0) {
-                    baseColumn[x + 1] = 0;
-                    continue;
-                }
-
-                uniq.initialize(mm * 2);
-                size_t j = 0;
-
-                for (int yy = 0; yy < threads; ++yy) {
-                    MyList<ReducNodeInfo>& taskq = taskMatrix[yy][x];
-
-                    for (typename MyList<ReducNodeInfo>::iterator t =
-                            taskq.begin(); t != taskq.end(); ++t) {
-                        ReducNodeInfo const* p = *t;
-                        ReducNodeInfo const* pp = uniq.add(p);
-
-                        if (pp == p) {
-                            newIdTable[i][p->column] =
-                                    NodeId(i + x,
-                                           j++,
-                                           p->children.branch[0].hasEmpty()); // row += task ID
-                        }
-                        else {
-                            newIdTable[i][p->column] =
-                                    newIdTable[i][pp->column];
-                        }
-                    }
-                }
-
-                baseColumn[x + 1] = j;
+#endif
+#pragma omp for schedule(dynamic) nowait
+            for (size_t t = 0; t < levels.size(); ++t) {
+                newIdTable[levels[t]].clear();
             }
 
-            for (int x = 0; x < tasks; ++x) {
-                taskMatrix[y][x].clear();
+            size_t n = 0;
+            for (size_t j = lo; j < hi; ++j) {
+                size_t k = uniqSlot[j];
+                if (k != EMPTY && uniqTable[k] == j) ++n;
             }
+            baseColumn[y + 1] = n;
+#pragma omp barrier
 
 #pragma omp single
             {
-#ifdef DEBUG
-                etcP2.stop();
-                etcS3.start();
-#endif
-                for (int x = 1; x < tasks; ++x) {
+                baseColumn[0] = 0;
+                for (int x = 0; x < yy; ++x) {
                     baseColumn[x + 1] += baseColumn[x];
                 }
+                output.initRow(i, baseColumn[yy]);
+            }
 
-//                for (int k = 1; k < tasks; k <<= 1) {
-//#pragma omp for schedule(static)
-//                    for (int x = k; x < tasks; ++x) {
-//                        if (x & k) {
-//                            int w = (x & ~k) | (k - 1);
-//                            baseColumn[x + 1] += baseColumn[w + 1];
-//                        }
-//                    }
-//                }
-
-                output.initRow(i, baseColumn[tasks]);
-#ifdef DEBUG
-                etcS3.stop();
-                etcP3.start();
-#endif
+            size_t jj = baseColumn[y];
+            for (size_t j = lo; j < hi; ++j) {
+                size_t k = uniqSlot[j];
+                if (k != EMPTY && uniqTable[k] == j) {
+                    newIdTable[i][j] = NodeId(i, jj,
+                                              input[i][j].branch[0].hasEmpty());
+                    output[i][jj++] = input[i][j];
+                }
             }
+#pragma omp barrier
 
-#pragma omp for schedule(static)
-            for (size_t j = 0; j < m; ++j) {
-                NodeId& ff = newIdTable[i][j];
-                if (ff.row() >= i) {
-                    ff = NodeId(i,
-                                ff.col() + baseColumn[ff.row() - i],
-                                ff.getAttr());
-                    output[i][ff.col()] = input[i][j];
+            for (size_t j = lo; j < hi; ++j) {
+                size_t k = uniqSlot[j];
+                if (k != EMPTY && uniqTable[k] != j) {
+                    newIdTable[i][j] = newIdTable[i][uniqTable[k]];
                 }
             }
         }
 #ifdef DEBUG
-        etcP3.stop();
+        etcP2.stop();
         etcS4.start();
 #endif
         input[i].clear();
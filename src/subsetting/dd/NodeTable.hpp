@@ -30,6 +30,10 @@
 #include <ostream>
 #include <stdexcept>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "Node.hpp"
 #include "DataTable.hpp"
 #include "../util/MyVector.hpp"
@@ -40,6 +44,29 @@ template<int ARITY>
 class NodeTableEntity: public DataTable<Node<ARITY> > {
     mutable MyVector<MyVector<int> > higherLevelTable;
     mutable MyVector<MyVector<int> > lowerLevelTable;
+    mutable MyVector<size_t> fanInTable;
+
+    /**
+     * Counts the branches of some nodes by the levels they point to.
+     * @param node the nodes.
+     * @param from the first node.
+     * @param to the end of the nodes.
+     * @param count the counters of the levels.
+     * @param lowest the lowest level found so far.
+     * @return the lowest level found.
+     */
+    static int countBranches(MyVector<Node<ARITY> > const& node, size_t from,
+            size_t to, MyVector<size_t>& count, int lowest) {
+        for (size_t j = from; j < to; ++j) {
+            for (int b = 0; b < ARITY; ++b) {
+                int const ii = node[j].branch[b].row();
+                if (ii == 0) continue;
+                if (ii < lowest) lowest = ii;
+                ++count[ii];
+            }
+        }
+        return lowest;
+    }
 
 public:
     /**
@@ -242,6 +269,7 @@ public:
     void deleteIndex() {
         higherLevelTable.clear();
         lowerLevelTable.clear();
+        fanInTable.clear();
     }
 
     /**
@@ -254,50 +282,62 @@ public:
         higherLevelTable.resize(n + 1);
         lowerLevelTable.clear();
         lowerLevelTable.resize(n + 1);
+        fanInTable.clear();
+        fanInTable.resize(n + 1);
         MyVector<bool> lowerMark(n + 1);
 
+#ifdef _OPENMP
+        int const threads = useMP ? omp_get_max_threads() : 1;
+#else
+        int const threads = 1;
+#endif
+        // Each thread counts into its own row, which is cleared when the
+        // counts are merged.
+        MyVector<MyVector<size_t> > counts(threads);
+        MyVector<int> lowests(threads);
+        for (int y = 0; y < threads; ++y) {
+            counts[y].resize(n + 1);
+        }
+
         for (int i = n; i >= 1; --i) {
             MyVector<Node<ARITY> > const& node = (*this)[i];
             size_t const m = node.size();
             int lowest = i;
-            MyVector<bool> myLower(n + 1);
 
 #ifdef _OPENMP
-            if (useMP) {
-#pragma omp parallel for schedule(static)
-                for (intmax_t j = 0; j < intmax_t(m); ++j) {
-                    for (int b = 0; b < ARITY; ++b) {
-                        int const ii = node[j].branch[b].row();
-                        if (ii == 0) continue;
-                        if (ii < lowest) {
-#pragma omp critical
-                            if (ii < lowest) lowest = ii;
-                        }
-                        if (!lowerMark[ii]) {
-                            myLower[ii] = true;
-                            lowerMark[ii] = true;
-                        }
-                    }
+            if (threads > 1) {
+                for (int y = 0; y < threads; ++y) {
+                    lowests[y] = i;
+                }
+#pragma omp parallel
+                {
+                    int y = omp_get_thread_num();
+                    int yy = omp_get_num_threads();
+                    lowests[y] = countBranches(node, m * y / yy,
+                            m * (y + 1) / yy, counts[y], i);
+                }
+                for (int y = 0; y < threads; ++y) {
+                    if (lowests[y] < lowest) lowest = lowests[y];
                 }
             }
             else
 #endif
-            for (size_t j = 0; j < m; ++j) {
-                for (int b = 0; b < ARITY; ++b) {
-                    int const ii = node[j].branch[b].row();
-                    if (ii == 0) continue;
-                    if (ii < lowest) lowest = ii;
-                    if (!lowerMark[ii]) {
-                        myLower[ii] = true;
-                        lowerMark[ii] = true;
-                    }
-                }
-            }
+            lowest = countBranches(node, 0, m, counts[0], lowest);
 
             higherLevelTable[lowest].push_back(i);
             MyVector<int>& lower = lowerLevelTable[i];
             for (int ii = lowest; ii < i; ++ii) {
-                if (myLower[ii]) lower.push_back(ii);
+                size_t c = 0;
+                for (int y = 0; y < threads; ++y) {
+                    c += counts[y][ii];
+                    counts[y][ii] = 0;
+                }
+                if (c == 0) continue;
+                fanInTable[ii] += c;
+                if (!lowerMark[ii]) {
+                    lower.push_back(ii);
+                    lowerMark[ii] = true;
+                }
             }
         }
     }
@@ -323,6 +363,16 @@ public:
         return lowerLevelTable[level];
     }
 
+    /**
+     * Returns the number of branches from higher levels to the nodes
+     * at the given level.
+     * @param level the level.
+     */
+    size_t fanIn(int level) const {
+        if (fanInTable.empty()) makeIndex();
+        return fanInTable[level];
+    }
+
     /**
      * Dumps the node table in Graphviz (dot) format.
      * @param os output stream.
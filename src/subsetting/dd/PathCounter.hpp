@@ -31,7 +31,12 @@
 #include <utility>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "../util/BigNumber.hpp"
+#include "../util/BuildControl.hpp"
 #include "../util/demangle.hpp"
 #include "../util/MessageHandler.hpp"
 #include "../util/MemoryPool.hpp"
@@ -432,6 +437,258 @@ public:
     }
 };
 
+/**
+ * Multi-threaded path counter.
+ * The nodes of each level are distributed over tasks by their hash codes;
+ * the threads merge the equivalent nodes of a task and expand them into
+ * the lower levels.  A level is freed as soon as it has been expanded, so
+ * that only the frontier of the DD is held in memory.
+ * This class uses arbitrary-precision integers of a fixed width enough for
+ * the largest possible count.  The active BuildControl, if any, is checked
+ * after each level with the number of distinct nodes counted so far and the
+ * memory of the nodes waiting at the lower levels.
+ */
+template<typename S>
+class PathCounterMP {
+    typedef S Spec;
+    typedef uint64_t Word;
+    static int const TASKS_PER_THREAD = 10;
+
+    struct Hasher {
+        Spec const& spec;
+        int const level;
+
+        Hasher(Spec const& spec, int level)
+                : spec(spec), level(level) {
+        }
+
+        size_t operator()(Word const* p) const {
+            return spec.hash_code(state(p), level);
+        }
+
+        size_t operator()(Word const* p, Word const* q) const {
+            return spec.equal_to(state(p), state(q), level);
+        }
+    };
+
+    typedef MyHashTable<Word*,Hasher,Hasher> UniqTable;
+
+    int const threads;
+    int const tasks;
+    MyVector<Spec> specs;
+    int const stateWords;
+
+    static int numWords(int n) {
+        if (n < 0) throw std::runtime_error(
+                "storage size is not initialized!!!");
+        return (n + sizeof(Word) - 1) / sizeof(Word);
+    }
+
+    static void* state(Word* p) {
+        return p;
+    }
+
+    static void const* state(Word const* p) {
+        return p;
+    }
+
+    BigNumber number(Word* p) const {
+        return BigNumber(p + stateWords);
+    }
+
+    /**
+     * Destructs the states of the nodes still waiting in the tables.
+     * @param snodeTables the tables.
+     */
+    void destructStates(
+            MyVector<MyVector<MyVector<MyList<Word> > > >& snodeTables) {
+        for (int y = 0; y < threads; ++y) {
+            for (int x = 0; x < tasks; ++x) {
+                MyVector<MyList<Word> >& levels = snodeTables[y][x];
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    for (; !levels[i].empty(); levels[i].pop_front()) {
+                        specs[0].destruct(state(levels[i].front()));
+                    }
+                }
+            }
+        }
+    }
+
+public:
+    PathCounterMP(Spec const& s) :
+#ifdef _OPENMP
+            threads(omp_get_max_threads()),
+            tasks(MyHashConstant::primeSize(TASKS_PER_THREAD * threads)),
+#else
+            threads(1),
+            tasks(1),
+#endif
+            specs(threads, s),
+            stateWords(numWords(s.datasize())) {
+    }
+
+    std::string count() {
+        MessageHandler mh;
+        mh.begin(typenameof(specs[0]));
+
+        MyVector<Word> tmp(stateWords + 1);
+        int const n = specs[0].get_root(state(tmp.data()));
+        if (n <= 0) {
+            mh << " ...";
+            mh.end(0);
+            return (n == 0) ? "0" : "1";
+        }
+
+        // at most ARITY^n paths, 63 bits per word
+        int bits = 0;
+        for (int a = 1; a < Spec::ARITY; a <<= 1) {
+            ++bits;
+        }
+        int const numberWords = n * bits / 63 + 1;
+        int const recordWords = stateWords + numberWords;
+
+        MyVector<MyVector<MyVector<MyList<Word> > > > snodeTables(threads);
+        for (int y = 0; y < threads; ++y) {
+            snodeTables[y].resize(tasks);
+            for (int x = 0; x < tasks; ++x) {
+                snodeTables[y][x].resize(n + 1);
+            }
+        }
+
+        MyVector<Word> totalStorage(threads * numberWords);
+        for (int y = 0; y < threads; ++y) {
+            BigNumber(totalStorage.data() + y * numberWords).store(0);
+        }
+
+        int x0 = specs[0].hash_code(state(tmp.data()), n) % tasks;
+        Word* p0 = snodeTables[0][x0][n].alloc_front(recordWords);
+        specs[0].get_copy(state(p0), state(tmp.data()));
+        specs[0].destruct(state(tmp.data()));
+        number(p0).store(1);
+
+        size_t maxWidth = 0;
+        size_t totalWidth = 0;
+        size_t stored = 1;
+        mh.setSteps(n);
+        for (int i = n; i > 0; --i) {
+            size_t width = 0;
+            size_t added = 0;
+            size_t removed = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:width,added,removed)
+#endif
+            {
+#ifdef _OPENMP
+                int yy = omp_get_thread_num();
+#else
+                int yy = 0;
+#endif
+
+                Spec& spec = specs[yy];
+                MyVector<Word> tmp(stateWords + 1);
+                Word* const pp = tmp.data();
+                BigNumber total(totalStorage.data() + yy * numberWords);
+                Hasher hasher(spec, i);
+                UniqTable uniq(hasher, hasher);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+                for (int x = 0; x < tasks; ++x) {
+                    size_t m = 0;
+                    for (int y = 0; y < threads; ++y) {
+                        m += snodeTables[y][x][i].size();
+                    }
+                    if (m == 0) continue;
+
+                    removed += m;
+                    uniq.initialize(m * 2);
+                    for (int y = 0; y < threads; ++y) {
+                        MyList<Word>& snodes = snodeTables[y][x][i];
+
+                        for (MyList<Word>::iterator t = snodes.begin();
+                                t != snodes.end(); ++t) {
+                            Word* p = *t;
+                            Word* p0 = uniq.add(p);
+
+                            if (p0 == p) {
+                                ++width;
+                            }
+                            else {
+                                number(p0).add(number(p));
+                                number(p).store(0);
+                            }
+                        }
+                    }
+
+                    for (int y = 0; y < threads; ++y) {
+                        MyList<Word>& snodes = snodeTables[y][x][i];
+
+                        for (; !snodes.empty(); snodes.pop_front()) {
+                            Word* p = snodes.front();
+                            if (number(p) == 0) {
+                                spec.destruct(state(p));
+                                continue;
+                            }
+
+                            for (int b = 0; b < Spec::ARITY; ++b) {
+                                spec.get_copy(state(pp), state(p));
+                                int ii = spec.get_child(state(pp), i, b);
+
+                                if (ii <= 0) {
+                                    if (ii != 0) total.add(number(p));
+                                }
+                                else {
+                                    assert(ii <= i - 1);
+                                    int xx = spec.hash_code(state(pp), ii)
+                                            % tasks;
+                                    Word* qq = snodeTables[yy][xx][ii]
+                                            .alloc_front(recordWords);
+                                    spec.get_copy(state(qq), state(pp));
+                                    number(qq).store(number(p));
+                                    ++added;
+                                }
+
+                                spec.destruct(state(pp));
+                            }
+
+                            spec.destruct(state(p));
+                        }
+                    }
+                }
+
+                spec.destructLevel(i);
+            }
+
+            maxWidth = std::max(maxWidth, width);
+            totalWidth += width;
+            stored += added - removed;
+            mh.step();
+
+            BuildControl* control = BuildControl::active();
+            if (control != 0) {
+                try {
+                    control->check(i, totalWidth,
+                            stored * recordWords * sizeof(Word));
+                }
+                catch (...) {
+                    destructStates(snodeTables);
+                    throw;
+                }
+            }
+        }
+
+        BigNumber total(totalStorage.data());
+        for (int y = 1; y < threads; ++y) {
+            total.add(BigNumber(totalStorage.data() + y * numberWords));
+        }
+
+        mh.end(maxWidth);
+        return total;
+    }
+};
+
 /**
  * Counts the number of paths from the root to the 1-terminal
  * without building entire DD structure.
@@ -456,4 +713,15 @@ uint64_t countPaths64(S& spec) {
     return PathCounter<S>(spec).count64();
 }
 
+/**
+ * Counts the number of paths from the root to the 1-terminal
+ * without building entire DD structure, using multiple threads.
+ * This function uses arbitrary-precision integer for counting.
+ * @param spec DD specification.
+ */
+template<typename S>
+std::string countPathsMP(S const& spec) {
+    return PathCounterMP<S>(spec).count();
+}
+
 } // namespace tdzdd
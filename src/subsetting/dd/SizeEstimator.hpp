@@ -0,0 +1,257 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "Node.hpp"
+#include "../util/MyHashTable.hpp"
+#include "../util/MyList.hpp"
+#include "../util/MyVector.hpp"
+
+namespace tdzdd {
+
+/**
+ * Estimated size of the DD that a DD spec would build.
+ */
+struct SizeEstimate {
+    std::vector<double> width; ///< estimated number of nodes at each level.
+    double nodes;              ///< estimated total number of nodes.
+    double bytes;              ///< estimated memory usage of the builder.
+    size_t sampledNodes;       ///< number of distinct nodes visited.
+
+    SizeEstimate()
+            : nodes(0), bytes(0), sampledNodes(0) {
+    }
+};
+
+/**
+ * Sampling-based estimator of DD sizes.
+ * The DD is built top-down as usual, but at most a given number of nodes
+ * chosen at random are expanded at each level.  Each node carries the
+ * estimated number of nodes it stands for, and the width of a level is the
+ * sum of them.  The children of a partly expanded level that are seen
+ * only once stand for those never seen as well, whose number is estimated
+ * from the children seen one to four times as in the improved Chao1
+ * estimator of species richness, so that merged states are not counted
+ * repeatedly.  The nodes to expand are chosen with probabilities
+ * proportional to what they stand for.  The estimate is exact for levels
+ * no wider than the sample size; beyond that it tends to be low when the
+ * numbers of parents of the nodes vary widely.
+ */
+template<typename S>
+class SizeEstimator {
+    typedef S Spec;
+    typedef uint64_t Word;
+
+    struct Hasher {
+        Spec const& spec;
+        int const level;
+
+        Hasher(Spec const& spec, int level)
+                : spec(spec), level(level) {
+        }
+
+        size_t operator()(Word const* p) const {
+            return spec.hash_code(state(p), level);
+        }
+
+        size_t operator()(Word const* p, Word const* q) const {
+            return spec.equal_to(state(p), state(q), level);
+        }
+    };
+
+    typedef MyHashTable<Word*,Hasher,Hasher> UniqTable;
+
+    Spec& spec;
+    int const stateWords;
+
+    static int numWords(int n) {
+        if (n < 0) throw std::runtime_error(
+                "storage size is not initialized!!!");
+        return (n + sizeof(Word) - 1) / sizeof(Word);
+    }
+
+    static void* state(Word* p) {
+        return p;
+    }
+
+    static void const* state(Word const* p) {
+        return p;
+    }
+
+    double& weight(Word* p) const {
+        return *reinterpret_cast<double*>(p + stateWords);
+    }
+
+    Word& parentLevel(Word* p) const {
+        return p[stateWords + 1];
+    }
+
+    Word& inEdges(Word* p) const {
+        return p[stateWords + 2];
+    }
+
+public:
+    SizeEstimator(S& s)
+            : spec(s), stateWords(numWords(spec.datasize())) {
+    }
+
+    /**
+     * Estimates the size of the DD.
+     * The memory usage counts the nodes of the DD and the states of two
+     * levels of the breadth-first construction.
+     * @param sampleSize the maximum number of nodes expanded at a level.
+     * @param seed the seed of the sampling.
+     * @return the estimate.
+     */
+    SizeEstimate estimate(size_t sampleSize, uint64_t seed = 1) {
+        SizeEstimate e;
+        if (sampleSize == 0) sampleSize = 1;
+
+        int const recordWords = stateWords + 3;
+        MyVector<Word> tmp(recordWords);
+        int const n = spec.get_root(state(tmp.data()));
+        if (n <= 0) {
+            spec.destruct(state(tmp.data()));
+            return e;
+        }
+        e.width.assign(n + 1, 0.0);
+
+        MyVector<MyList<Word> > vnodeTable(n + 1);
+        MyVector<UniqTable> uniqTable;
+        MyVector<Hasher> hasher;
+        uniqTable.reserve(n + 1);
+        hasher.reserve(n + 1);
+        for (int i = 0; i <= n; ++i) {
+            hasher.push_back(Hasher(spec, i));
+            uniqTable.push_back(UniqTable(hasher.back(), hasher.back()));
+        }
+
+        Word* p0 = vnodeTable[n].alloc_front(recordWords);
+        spec.get_copy(state(p0), state(tmp.data()));
+        spec.destruct(state(tmp.data()));
+        weight(p0) = 1.0;
+
+        Word* pp = tmp.data();
+        std::vector<Word*> children;
+        Word rng = seed;
+        double maxWidth = 0;
+
+        for (int i = n; i > 0; --i) {
+            MyList<Word>& vnodes = vnodeTable[i];
+            double width = 0;
+            for (MyList<Word>::iterator t = vnodes.begin(); t != vnodes.end();
+                    ++t) {
+                width += weight(*t);
+            }
+            double f = std::min(sampleSize / width, 1.0);
+            children.clear();
+
+            for (; !vnodes.empty(); vnodes.pop_front()) {
+                Word* p = vnodes.front();
+                rng = rng * 6364136223846793005ULL + 1442695040888963407ULL;
+                if ((rng >> 11) / 9007199254740992.0 >= weight(p) * f) {
+                    spec.destruct(state(p));
+                    continue;
+                }
+                ++e.sampledNodes;
+
+                for (int b = 0; b < Spec::ARITY; ++b) {
+                    spec.get_copy(state(pp), state(p));
+                    int ii = spec.get_child(state(pp), i, b);
+                    if (ii <= 0) {
+                        spec.destruct(state(pp));
+                        continue;
+                    }
+
+                    Word* qq = vnodeTable[ii].alloc_front(recordWords);
+                    spec.get_copy(state(qq), state(pp));
+                    spec.destruct(state(pp));
+                    Word* qqq = uniqTable[ii].add(qq);
+                    if (qqq == qq) {
+                        weight(qq) = 0.0;
+                        parentLevel(qq) = 0;
+                    }
+                    else {
+                        spec.destruct(state(qq));
+                        vnodeTable[ii].pop_front();
+                    }
+                    if (parentLevel(qqq) != Word(i)) {
+                        parentLevel(qqq) = i;
+                        inEdges(qqq) = 0;
+                        children.push_back(qqq);
+                    }
+                    ++inEdges(qqq);
+                }
+
+                spec.destruct(state(p));
+            }
+
+            double edges = 0, f1 = 0, f2 = 0, f3 = 0, f4 = 0;
+            for (size_t t = 0; t < children.size(); ++t) {
+                Word r = inEdges(children[t]);
+                edges += r;
+                if (r == 1) ++f1;
+                if (r == 2) ++f2;
+                if (r == 3) ++f3;
+                if (r == 4) ++f4;
+            }
+            double w = 1.0;
+            if (f < 1.0 && f1 > 0) { // improved Chao1 without replacement
+                // bias-corrected form without f2, which also avoids the
+                // division by zero for a single edge
+                double f0 = (f2 > 0)
+                        ? f1 * f1 / (edges / (edges - 1) * 2 * f2
+                                     + f / (1 - f) * f1)
+                        : f1 * (f1 - 1) / (2 + f / (1 - f) * f1);
+                if (f4 > 0) {
+                    f0 += f3 / (4 * f4)
+                            * std::max(f1 - f2 * f3 / (2 * f4), 0.0);
+                }
+                w += f0 / f1;
+            }
+            for (size_t t = 0; t < children.size(); ++t) {
+                Word* c = children[t];
+                double cw = (inEdges(c) == 1) ? w : 1.0;
+                weight(c) = std::max(weight(c), cw);
+            }
+
+            uniqTable[i].clear();
+            spec.destructLevel(i);
+            e.width[i] = width;
+            e.nodes += width;
+            maxWidth = std::max(maxWidth, width);
+        }
+
+        e.bytes = e.nodes * sizeof(Node<Spec::ARITY>)
+                + 2 * maxWidth * (stateWords + 1) * sizeof(Word);
+        return e;
+    }
+};
+
+} // namespace tdzdd
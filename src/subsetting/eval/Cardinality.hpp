@@ -87,6 +87,9 @@ public:
     }
 };
 
+// The numbers of a level are allocated from pools[level] of the copy of
+// the evaluator that computes them, so that the threads of
+// DdStructure::evaluate never share a pool.
 template<typename E, int ARITY, bool BDD>
 class CardinalityBase<E,std::string,ARITY,BDD> : public DdEval<E,BigNumber,
         std::string> {
@@ -209,4 +212,93 @@ template<typename T = std::string, int AR = 2>
 struct ZddCardinality: public CardinalityBase<ZddCardinality<T,AR>,T,AR,false> {
 };
 
+#ifdef __SIZEOF_INT128__
+/**
+ * Count of a node in a 128-bit integer, or in a BigNumber if it does not
+ * fit.
+ */
+struct HybridCount {
+    Count128::Value n; ///< the count unless big is set.
+    uint64_t* big; ///< the BigNumber words of the count, or null.
+
+    HybridCount() :
+            n(0), big(0) {
+    }
+};
+
+/**
+ * ZDD evaluator that counts the number of elements in 128-bit integers.
+ * Only the nodes whose counts overflow, and the nodes above them, are
+ * counted in arbitrary-precision integers, which are allocated from
+ * pools[level] of the copy of the evaluator that computes them as in
+ * ZddCardinality<std::string>.
+ * @tparam AR arity of the nodes.
+ */
+template<int AR = 2>
+class ZddCardinality128: public DdEval<ZddCardinality128<AR>,HybridCount,
+        std::string> {
+    MemoryPools pools;
+    BigNumber tmp1;
+    uint64_t* tmp2;
+
+public:
+    ZddCardinality128() :
+            tmp2(0) {
+    }
+
+    void initialize(int level) {
+        pools.resize(level + 1);
+
+        int max = ceil(double(level) * log2(double(AR)) / 63.0) + 1;
+        if (max < 3) max = 3;
+        tmp1.setArray(pools[level].template allocate<uint64_t>(max));
+        tmp2 = pools[level].template allocate<uint64_t>(3);
+    }
+
+    void evalTerminal(HybridCount& c, bool one) const {
+        c.n = one ? 1 : 0;
+        c.big = 0;
+    }
+
+    void evalNode(HybridCount& c, int i,
+                  DdValues<HybridCount,AR> const& values) {
+        Count128::Value n = 0;
+        bool overflow = false;
+        for (int b = 0; b < AR && !overflow; ++b) {
+            HybridCount const& v = values.get(b);
+            overflow = v.big != 0 || __builtin_add_overflow(n, v.n, &n);
+        }
+        if (!overflow) {
+            c.n = n;
+            c.big = 0;
+            return;
+        }
+
+        size_t w = tmp1.store(0);
+        for (int b = 0; b < AR; ++b) {
+            HybridCount const& v = values.get(b);
+            if (v.big != 0) {
+                w = tmp1.add(BigNumber(v.big));
+            }
+            else {
+                Count128::toBigNumber(tmp2, v.n);
+                w = tmp1.add(BigNumber(tmp2));
+            }
+        }
+        c.n = 0;
+        c.big = pools[i].template allocate<uint64_t>(w);
+        BigNumber(c.big).store(tmp1);
+    }
+
+    std::string getValue(HybridCount const& c) const {
+        if (c.big != 0) return BigNumber(c.big);
+        return Count128::toString(c.n);
+    }
+
+    void destructLevel(int i) {
+        pools[i].clear();
+    }
+};
+#endif
+
 } // namespace tdzdd
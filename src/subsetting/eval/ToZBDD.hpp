@@ -41,6 +41,7 @@ namespace tdzdd {
  * ZBDD nodes at level @a i + @p offset.
  * When the ZBDD variables are not enough, they are
  * created automatically by BDD_NewVar().
+ * Each node is inserted into the ZBDD unique table directly.
  */
 struct ToZBDD: public tdzdd::DdEval<ToZBDD,ZBDD> {
     int const offset;
@@ -65,10 +66,13 @@ public:
     }
 
     void evalNode(ZBDD& f, int level, tdzdd::DdValues<ZBDD,2> const& values) const {
-        f = values.get(0);
         if (level + offset > 0) {
-            ZBDD f1 = values.get(1);
-            f += f1.Change(BDD_VarOfLev(level + offset));
+            // the children are below this level; no union is needed
+            f = ZBDD_Node(BDD_VarOfLev(level + offset), values.get(0),
+                          values.get(1));
+        }
+        else {
+            f = values.get(0);
         }
     }
 };
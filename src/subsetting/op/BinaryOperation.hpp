@@ -33,6 +33,10 @@ namespace tdzdd {
 
 template<typename S, typename S1, typename S2>
 class BinaryOperation: public PodArrayDdSpec<S,size_t,2> {
+public:
+    static bool const TRIVIAL_STATES = S1::TRIVIAL_STATES
+            && S2::TRIVIAL_STATES;
+
 protected:
     typedef S1 Spec1;
     typedef S2 Spec2;
@@ -308,6 +312,8 @@ struct ZddIntersection_
     typedef S1 Spec1;
     typedef S2 Spec2;
     typedef size_t Word;
+    static bool const TRIVIAL_STATES = S1::TRIVIAL_STATES
+            && S2::TRIVIAL_STATES;
 
     Spec1 spec1;
     Spec2 spec2;
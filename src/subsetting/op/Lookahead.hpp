@@ -34,6 +34,10 @@ namespace tdzdd {
 
 template<typename S>
 class BddLookahead: public DdSpecBase<BddLookahead<S>,S::ARITY> {
+public:
+    static bool const TRIVIAL_STATES = S::TRIVIAL_STATES;
+
+private:
     typedef S Spec;
 
     Spec spec;
@@ -120,6 +124,10 @@ public:
 
 template<typename S>
 class ZddLookahead: public DdSpecBase<ZddLookahead<S>,S::ARITY> {
+public:
+    static bool const TRIVIAL_STATES = S::TRIVIAL_STATES;
+
+private:
     typedef S Spec;
 
     Spec spec;
@@ -33,6 +33,9 @@ namespace tdzdd {
 
 template<typename T, typename S, bool ZDD>
 class Unreduction_: public PodArrayDdSpec<T,size_t,S::ARITY> {
+public:
+    static bool const TRIVIAL_STATES = S::TRIVIAL_STATES;
+
 protected:
     typedef S Spec;
     typedef size_t Word;
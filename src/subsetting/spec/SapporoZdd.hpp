@@ -26,6 +26,7 @@
 
 #include <cassert>
 #include <ostream>
+#include <vector>
 
 #ifndef B_64
 #if __SIZEOF_POINTER__ == 8
@@ -35,6 +36,8 @@
 #include <ZBDD.h>
 
 #include "../DdSpec.hpp"
+#include "../DdStructure.hpp"
+#include "../util/MyHashTable.hpp"
 
 namespace tdzdd {
 
@@ -91,4 +94,86 @@ public:
     }
 };
 
+/**
+ * Copies a ZBDD into a DdStructure in one top-down pass.
+ * The level mapping is the same as that of SapporoZdd, but ZBDD nodes are
+ * only read; no ZBDD node is created and no spec state is hashed.
+ * The result does not refer to the ZBDD package any more, so that
+ * subsequent operations on it can use the MP algorithms safely.
+ * @param f the ZBDD.
+ * @param offset ZBDD nodes at level @a i + @p offset are converted to
+ *        TdZdd nodes at level @a i.
+ * @param useMP use algorithms for multiple processors in later operations.
+ * @return the DD structure.
+ */
+inline DdStructure<2> snapshotSapporoZdd(ZBDD const& f, int offset = 0,
+                                         bool useMP = false) {
+    // Resolves a node that has fallen to level <= offset into a terminal.
+    struct Local {
+        static NodeId terminal(ZBDD g) {
+            while (BDD_LevOfVar(g.Top()) >= 1) {
+                g = g.OffSet(g.Top());
+            }
+            return NodeId((g == 1) ? 1 : 0);
+        }
+    };
+
+    DdStructure<2> dd;
+    int const n = BDD_LevOfVar(f.Top()) - offset;
+    if (n < 1) {
+        dd.root() = Local::terminal(f);
+        dd.useMultiProcessors(useMP);
+        return dd;
+    }
+
+    std::vector<std::vector<ZBDD> > nodes(n + 1);
+    typedef MyHashDefaultForInt<bddword> IdHash;
+    MyVector<MyHashMap<bddword,size_t,IdHash,IdHash> > uniq(n + 1);
+    // The keys are shifted by one, since the first ZBDD node has ID 0,
+    // which MyHashMap reserves for empty slots.
+    nodes[n].push_back(f);
+    uniq[n][const_cast<ZBDD&>(f).GetID() + 1] = 0;
+
+    NodeTableHandler<2> diagram(n + 1);
+    NodeTableEntity<2>& table = diagram.privateEntity();
+
+    for (int i = n; i >= 1; --i) {
+        std::vector<ZBDD>& row = nodes[i];
+        size_t const m = row.size();
+        table.initRow(i, m);
+
+        for (size_t j = 0; j < m; ++j) {
+            int const var = row[j].Top();
+            for (int b = 0; b < 2; ++b) {
+                ZBDD g = b ? row[j].OnSet0(var) : row[j].OffSet(var);
+                int const ii = BDD_LevOfVar(g.Top()) - offset;
+                assert(ii < i);
+                if (ii < 1) {
+                    table[i][j].branch[b] = Local::terminal(g);
+                    continue;
+                }
+                bddword const id = g.GetID() + 1;
+                size_t* col = uniq[ii].getValue(id);
+                if (col == 0) {
+                    uniq[ii][id] = nodes[ii].size();
+                    table[i][j].branch[b] = NodeId(ii, nodes[ii].size());
+                    nodes[ii].push_back(g);
+                }
+                else {
+                    table[i][j].branch[b] = NodeId(ii, *col);
+                }
+            }
+        }
+
+        // nodes at this level are no longer referred to
+        std::vector<ZBDD>().swap(row);
+        uniq[i].clear();
+    }
+
+    dd.getDiagram() = diagram;
+    dd.root() = NodeId(n, 0);
+    dd.useMultiProcessors(useMP);
+    return dd;
+}
+
 } // namespace tdzdd
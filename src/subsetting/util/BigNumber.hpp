@@ -27,6 +27,7 @@
 #include <cassert>
 #include <stdint.h>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -370,4 +371,42 @@ public:
     }
 };
 
+#ifdef __SIZEOF_INT128__
+/**
+ * Unsigned 128-bit counts and their conversions.
+ */
+class Count128 {
+public:
+    typedef unsigned __int128 Value;
+
+    /**
+     * Stores a count in BigNumber words.
+     * @param p the words; three of them are enough.
+     * @param n the count.
+     * @return the number of words used.
+     */
+    static size_t toBigNumber(uint64_t* p, Value n) {
+        uint64_t const MSB = uint64_t(1) << 63;
+        size_t w = 0;
+        while (n > ~MSB) {
+            p[w++] = uint64_t(n & ~MSB) | MSB;
+            n >>= 63;
+        }
+        p[w++] = uint64_t(n);
+        return w;
+    }
+
+    static std::string toString(Value n) {
+        char buf[40];
+        char* p = buf + sizeof(buf);
+        *--p = '\0';
+        do {
+            *--p = '0' + int(n % 10);
+            n /= 10;
+        } while (n != 0);
+        return p;
+    }
+};
+#endif
+
 } // namespace tdzdd
@@ -0,0 +1,266 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "ResourceUsage.hpp"
+
+namespace tdzdd {
+
+/**
+ * Exception thrown when a build control stops DD construction.
+ */
+class BuildAborted: public std::runtime_error {
+public:
+    /// Why the construction was stopped.
+    enum Reason {
+        BUDGET, ///< The node or byte budget was exceeded.
+        DEADLINE, ///< The time limit was exceeded.
+        CANCELLED ///< The construction was cancelled.
+    };
+
+private:
+    Reason reason_;
+    int level_;
+
+public:
+    BuildAborted(Reason reason, int level, std::string const& what)
+            : std::runtime_error(what), reason_(reason), level_(level) {
+    }
+
+    /**
+     * Gets the reason of the abort.
+     * @return the reason.
+     */
+    Reason reason() const {
+        return reason_;
+    }
+
+    /**
+     * Gets the level at which the construction was stopped.
+     * @return the level.
+     */
+    int level() const {
+        return level_;
+    }
+};
+
+/**
+ * Limits and monitors DD construction.
+ * A control is activated by a BuildControl::Scope object for the calling
+ * thread and is checked by DdStructure between levels of construction,
+ * subsetting, reduction and evaluation on that thread.  When a limit is
+ * exceeded, BuildAborted is thrown and the partially built structures,
+ * including the pending spec states, are released as the stack unwinds.
+ * Concurrent builds use separate controls.
+ */
+class BuildControl {
+public:
+    /**
+     * Progress callback.
+     * It is called with the level just processed, the number of nodes and
+     * the estimated bytes of the diagram being built, the elapsed seconds
+     * since activation, and the user argument.
+     * Returning false cancels the construction in progress, but not later
+     * ones.
+     */
+    typedef bool (*Callback)(int level, size_t nodes, size_t bytes,
+            double elapsed, void* arg);
+
+private:
+    size_t maxNodes_;
+    size_t maxBytes_;
+    double timeLimit_;
+    Callback callback_;
+    void* callbackArg_;
+    double startTime_;
+    std::atomic<bool> cancelled_;
+
+    static BuildControl*& active_() {
+        static thread_local BuildControl* control = 0;
+        return control;
+    }
+
+public:
+    BuildControl()
+            : maxNodes_(0), maxBytes_(0), timeLimit_(0), callback_(0),
+              callbackArg_(0), startTime_(0), cancelled_(false) {
+    }
+
+    BuildControl(BuildControl const& o)
+            : maxNodes_(o.maxNodes_), maxBytes_(o.maxBytes_),
+              timeLimit_(o.timeLimit_), callback_(o.callback_),
+              callbackArg_(o.callbackArg_), startTime_(o.startTime_),
+              cancelled_(o.cancelled()) {
+    }
+
+    BuildControl& operator=(BuildControl const& o) {
+        maxNodes_ = o.maxNodes_;
+        maxBytes_ = o.maxBytes_;
+        timeLimit_ = o.timeLimit_;
+        callback_ = o.callback_;
+        callbackArg_ = o.callbackArg_;
+        startTime_ = o.startTime_;
+        cancelled_.store(o.cancelled(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /**
+     * Sets the maximum number of nodes of a diagram.
+     * @param n the number of nodes; 0 means unlimited.
+     */
+    void setMaxNodes(size_t n) {
+        maxNodes_ = n;
+    }
+
+    size_t maxNodes() const {
+        return maxNodes_;
+    }
+
+    /**
+     * Sets the maximum memory of a diagram and its pending states.
+     * @param bytes the number of bytes; 0 means unlimited.
+     */
+    void setMaxBytes(size_t bytes) {
+        maxBytes_ = bytes;
+    }
+
+    size_t maxBytes() const {
+        return maxBytes_;
+    }
+
+    /**
+     * Sets the wall-clock time limit counted from activation.
+     * @param seconds the time limit; 0 means unlimited.
+     */
+    void setTimeLimit(double seconds) {
+        timeLimit_ = seconds;
+    }
+
+    double timeLimit() const {
+        return timeLimit_;
+    }
+
+    /**
+     * Sets the progress callback.
+     * @param callback the function, or null to remove it.
+     * @param arg the argument passed to the function.
+     */
+    void setCallback(Callback callback, void* arg = 0) {
+        callback_ = callback;
+        callbackArg_ = arg;
+    }
+
+    /**
+     * Requests cancellation of the running construction.
+     * It may be called from another thread or a signal handler, also
+     * before the construction starts.  The request is never withdrawn;
+     * every later construction under this control stops at its first
+     * check.
+     */
+    void cancel() {
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Checks if cancellation has been requested.
+     * @return true if cancel() has been called.
+     */
+    bool cancelled() const {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the elapsed time since activation.
+     * @return the elapsed seconds.
+     */
+    double elapsedTime() const {
+        return getWallClockTime() - startTime_;
+    }
+
+    /**
+     * Reports progress and checks the limits.
+     * @param level the level just processed.
+     * @param nodes the number of nodes of the diagram being built.
+     * @param bytes the estimated memory of the diagram being built.
+     * @throw BuildAborted a limit is exceeded or cancellation is requested.
+     */
+    void check(int level, size_t nodes, size_t bytes) {
+        double elapsed = elapsedTime();
+        if (cancelled() || (callback_ != 0
+                && !callback_(level, nodes, bytes, elapsed, callbackArg_))) {
+            throw BuildAborted(BuildAborted::CANCELLED, level,
+                    "DD construction cancelled");
+        }
+        if (maxNodes_ != 0 && nodes > maxNodes_) {
+            throw BuildAborted(BuildAborted::BUDGET, level,
+                    "DD construction exceeded the node budget");
+        }
+        if (maxBytes_ != 0 && bytes > maxBytes_) {
+            throw BuildAborted(BuildAborted::BUDGET, level,
+                    "DD construction exceeded the memory budget");
+        }
+        if (timeLimit_ != 0 && elapsed > timeLimit_) {
+            throw BuildAborted(BuildAborted::DEADLINE, level,
+                    "DD construction exceeded the time limit");
+        }
+    }
+
+    /**
+     * Gets the control active on the calling thread.
+     * @return the active control, or null if none is active.
+     */
+    static BuildControl* active() {
+        return active_();
+    }
+
+    /**
+     * Activates a control on the calling thread during its lifetime.
+     * The clock of the control is reset on activation; a cancellation
+     * requested earlier stays in effect.
+     */
+    class Scope {
+        BuildControl* prev;
+
+        Scope(Scope const&);
+        Scope& operator=(Scope const&);
+
+    public:
+        explicit Scope(BuildControl& control)
+                : prev(active_()) {
+            control.startTime_ = getWallClockTime();
+            active_() = &control;
+        }
+
+        ~Scope() {
+            active_() = prev;
+        }
+    };
+};
+
+} // namespace tdzdd
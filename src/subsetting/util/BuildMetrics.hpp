@@ -0,0 +1,248 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ResourceUsage.hpp"
+
+namespace tdzdd {
+
+/**
+ * Statistics of one level of a DD operation.
+ */
+struct LevelMetrics {
+    int level;         ///< The level.
+    size_t nodes;      ///< The number of nodes made at the level.
+    size_t merged;     ///< The number of states or nodes merged into others.
+    size_t dead;       ///< The number of nodes whose children are all 0.
+    double loadFactor; ///< The load factor of the unique table.
+    double elapsed;    ///< The elapsed seconds of the level.
+
+    LevelMetrics(int level = 0, size_t nodes = 0, size_t merged = 0,
+            size_t dead = 0, double loadFactor = 0)
+            : level(level), nodes(nodes), merged(merged), dead(dead),
+              loadFactor(loadFactor), elapsed(0) {
+    }
+};
+
+/**
+ * Statistics of one DD operation such as construction, subsetting,
+ * reduction and evaluation.
+ */
+struct OperationMetrics {
+    std::string name;                 ///< The operation.
+    std::vector<LevelMetrics> levels; ///< The levels in processing order.
+    size_t size;                      ///< The number of nodes of the result.
+    double elapsed;                   ///< The elapsed seconds.
+    long rssDelta;      ///< The growth of the maximum resident set in KB.
+    bool aborted;       ///< True if the operation did not finish.
+
+    OperationMetrics()
+            : size(0), elapsed(0), rssDelta(0), aborted(true) {
+    }
+};
+
+/**
+ * Recorder of DD operation statistics.
+ * A recorder is activated by a BuildMetrics::Scope object, and
+ * DdStructure appends the statistics of its operations to it.
+ */
+class BuildMetrics {
+    std::vector<OperationMetrics> operations_;
+
+    static BuildMetrics*& active_() {
+        static BuildMetrics* metrics = 0;
+        return metrics;
+    }
+
+    static void writeString(std::ostream& os, std::string const& s) {
+        os << '"';
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char c = s[i];
+            if (c == '"' || c == '\\') {
+                os << '\\' << c;
+            }
+            else if (c < 0x20) {
+                char buf[8];
+                std::sprintf(buf, "\\u%04x", c);
+                os << buf;
+            }
+            else {
+                os << c;
+            }
+        }
+        os << '"';
+    }
+
+public:
+    /**
+     * Gets the recorded operations.
+     * @return the operations in the order of their start.
+     */
+    std::vector<OperationMetrics> const& operations() const {
+        return operations_;
+    }
+
+    /**
+     * Deletes all records.
+     */
+    void clear() {
+        operations_.clear();
+    }
+
+    /**
+     * Writes the records as a JSON array.
+     * @param os the output stream.
+     */
+    void dumpJson(std::ostream& os) const {
+        os << "[";
+        for (size_t k = 0; k < operations_.size(); ++k) {
+            OperationMetrics const& op = operations_[k];
+            if (k > 0) os << ",";
+            os << "\n{\"name\":";
+            writeString(os, op.name);
+            os << ",\"size\":" << op.size << ",\"elapsed\":" << op.elapsed
+                    << ",\"rss_delta\":" << op.rssDelta << ",\"aborted\":"
+                    << (op.aborted ? "true" : "false") << ",\"levels\":[";
+            for (size_t t = 0; t < op.levels.size(); ++t) {
+                LevelMetrics const& lm = op.levels[t];
+                if (t > 0) os << ",";
+                os << "\n {\"level\":" << lm.level << ",\"nodes\":" << lm.nodes
+                        << ",\"merged\":" << lm.merged << ",\"dead\":"
+                        << lm.dead << ",\"load_factor\":" << lm.loadFactor
+                        << ",\"elapsed\":" << lm.elapsed << "}";
+            }
+            os << "]}";
+        }
+        os << "]\n";
+    }
+
+    /**
+     * Gets the active recorder.
+     * @return the active recorder, or null if none is active.
+     */
+    static BuildMetrics* active() {
+        return active_();
+    }
+
+    /**
+     * Activates a recorder during its lifetime.
+     */
+    class Scope {
+        BuildMetrics* prev;
+
+        Scope(Scope const&);
+        Scope& operator=(Scope const&);
+
+    public:
+        /**
+         * @param metrics the recorder, or null to record nothing.
+         */
+        explicit Scope(BuildMetrics* metrics)
+                : prev(active_()) {
+            active_() = metrics;
+        }
+
+        ~Scope() {
+            active_() = prev;
+        }
+    };
+
+    /**
+     * Records one operation into the active recorder, if any.
+     * An operation not ended before destruction is marked as aborted.
+     */
+    class Recorder {
+        BuildMetrics* metrics;
+        size_t index;
+        ResourceUsage initialUsage;
+        double prevTime;
+
+        Recorder(Recorder const&);
+        Recorder& operator=(Recorder const&);
+
+        OperationMetrics& op() {
+            return metrics->operations_[index];
+        }
+
+        void finish() {
+            ResourceUsage usage;
+            op().elapsed = usage.etime - initialUsage.etime;
+            op().rssDelta = usage.maxrss - initialUsage.maxrss;
+            metrics = 0;
+        }
+
+    public:
+        explicit Recorder(std::string const& name)
+                : metrics(active_()), index(0), prevTime(0) {
+            if (metrics == 0) return;
+            index = metrics->operations_.size();
+            metrics->operations_.push_back(OperationMetrics());
+            op().name = name;
+            prevTime = initialUsage.etime;
+        }
+
+        ~Recorder() {
+            if (metrics != 0) finish();
+        }
+
+        /**
+         * Checks if the statistics are recorded.
+         * @return true if a recorder is active.
+         */
+        bool enabled() const {
+            return metrics != 0;
+        }
+
+        /**
+         * Records a level.
+         * @param lm the statistics of the level.
+         */
+        void level(LevelMetrics const& lm) {
+            if (metrics == 0) return;
+            double t = getWallClockTime();
+            op().levels.push_back(lm);
+            op().levels.back().elapsed = t - prevTime;
+            prevTime = t;
+        }
+
+        /**
+         * Ends the operation.
+         * @param size the number of nodes of the result.
+         */
+        void end(size_t size) {
+            if (metrics == 0) return;
+            op().size = size;
+            op().aborted = false;
+            finish();
+        }
+    };
+};
+
+} // namespace tdzdd
@@ -0,0 +1,268 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "StateHash.hpp"
+
+namespace tdzdd {
+
+/**
+ * Insert-only open-addressing hash table keeping fingerprints inline.
+ * The slots are divided into groups of 16, and each slot has a metadata
+ * byte holding 7 bits of the hash code of its element or marking it
+ * empty, as in Swiss tables.  A lookup scans the metadata of a group at
+ * once and calls the equality function only on the slots with the same
+ * fingerprint, so that elements pointing to cold memory are rarely
+ * dereferenced in vain.  The hash and equality functions are given to
+ * each call, and initialize() empties the table keeping its storage, so
+ * that one table serves all the levels of a DD.
+ * @param T type of elements.
+ */
+template<typename T>
+class FingerprintTable {
+    static size_t const GROUP = 16;
+    static uint8_t const EMPTY = 0x80;
+    static size_t const MAX_FILL = 7; ///< in eighths.
+
+    size_t tableCapacity_; ///< Size of the storage.
+    size_t tableSize_;     ///< Size of the table in use.
+    size_t maxSize_;       ///< The maximum number of elements.
+    size_t size_;          ///< The number of elements.
+    size_t collisions_;    ///< The number of false fingerprint matches.
+    uint8_t* meta;         ///< Metadata bytes of the slots.
+    T* slots;              ///< Elements.
+
+    static unsigned matchBytes(uint8_t const* p, uint8_t b) {
+#ifdef __SSE2__
+        __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(b)));
+#else
+        unsigned mask = 0;
+        for (size_t k = 0; k < GROUP; ++k) {
+            if (p[k] == b) mask |= 1U << k;
+        }
+        return mask;
+#endif
+    }
+
+    static int lowestBit(unsigned mask) {
+        return __builtin_ctz(mask);
+    }
+
+    void allocate(size_t n) {
+        tableSize_ = GROUP;
+        while (tableSize_ * MAX_FILL / 8 < n) {
+            tableSize_ *= 2;
+        }
+        maxSize_ = tableSize_ * MAX_FILL / 8;
+        size_ = 0;
+        collisions_ = 0;
+
+        if (tableSize_ > tableCapacity_) {
+            delete[] meta;
+            delete[] slots;
+            tableCapacity_ = tableSize_;
+            meta = new uint8_t[tableCapacity_];
+            slots = new T[tableCapacity_];
+        }
+        std::memset(meta, EMPTY, tableSize_);
+    }
+
+    /*
+     * Places an element known to be absent.
+     */
+    T& place(T const& elem, size_t h) {
+        uint8_t const fp = h & 0x7f;
+        size_t const mask = tableSize_ / GROUP - 1;
+        size_t g = (h >> 7) & mask;
+
+        for (size_t step = 1;; ++step) {
+            size_t const base = g * GROUP;
+            unsigned empty = matchBytes(meta + base, EMPTY);
+            if (empty) {
+                size_t k = base + lowestBit(empty);
+                meta[k] = fp;
+                slots[k] = elem;
+                ++size_;
+                return slots[k];
+            }
+            g = (g + step) & mask; // triangular probing visits all groups
+        }
+    }
+
+    template<typename Hash>
+    void grow(Hash const& hash) {
+        size_t const oldSize = tableSize_;
+        uint8_t* const oldMeta = meta;
+        T* const oldSlots = slots;
+        size_t const oldCollisions = collisions_;
+
+        tableCapacity_ = 0;
+        meta = 0;
+        slots = 0;
+        allocate(oldSize);
+
+        for (size_t k = 0; k < oldSize; ++k) {
+            if (oldMeta[k] != EMPTY) {
+                place(oldSlots[k], StateHash::mix(hash(oldSlots[k])));
+            }
+        }
+        collisions_ = oldCollisions;
+        delete[] oldMeta;
+        delete[] oldSlots;
+    }
+
+public:
+    /**
+     * Default constructor.
+     */
+    FingerprintTable()
+            : tableCapacity_(0), tableSize_(0), maxSize_(0), size_(0),
+              collisions_(0), meta(0), slots(0) {
+    }
+
+    /**
+     * Copy constructor.
+     * @param o object to be copied.
+     */
+    FingerprintTable(FingerprintTable const& o)
+            : tableCapacity_(0), tableSize_(0), maxSize_(0), size_(0),
+              collisions_(0), meta(0), slots(0) {
+        *this = o;
+    }
+
+    FingerprintTable& operator=(FingerprintTable const& o) {
+        if (this == &o) return *this;
+        if (o.tableSize_ == 0) {
+            tableSize_ = maxSize_ = size_ = collisions_ = 0;
+            return *this;
+        }
+        allocate(o.maxSize_);
+        std::copy(o.meta, o.meta + tableSize_, meta);
+        std::copy(o.slots, o.slots + tableSize_, slots);
+        size_ = o.size_;
+        collisions_ = o.collisions_;
+        return *this;
+    }
+
+    ~FingerprintTable() {
+        delete[] meta;
+        delete[] slots;
+    }
+
+    size_t tableCapacity() const {
+        return tableCapacity_ * (sizeof(T) + 1);
+    }
+
+    size_t tableSize() const {
+        return tableSize_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_t collisions() const {
+        return collisions_;
+    }
+
+    /**
+     * Initializes the table to be empty.
+     * The memory is deallocated.
+     */
+    void clear() {
+        delete[] meta;
+        delete[] slots;
+        tableCapacity_ = tableSize_ = maxSize_ = size_ = collisions_ = 0;
+        meta = 0;
+        slots = 0;
+    }
+
+    /**
+     * Initializes the table to be empty.
+     * The storage is reused if it is large enough.
+     * @param n the number of elements to be added without growing.
+     */
+    void initialize(size_t n) {
+        allocate(n);
+    }
+
+    /**
+     * Inserts an element if no other equivalent element is registered.
+     * The table grows when it is full, which invalidates the references
+     * returned before.
+     * @param elem the element to be inserted.
+     * @param hash hash function.
+     * @param equal equality function.
+     * @return reference to the element in the table.
+     */
+    template<typename Hash, typename Equal>
+    T& add(T const& elem, Hash const& hash, Equal const& equal) {
+        if (size_ >= maxSize_) {
+            if (tableSize_ == 0) allocate(1);
+            else grow(hash);
+        }
+
+        size_t const h = StateHash::mix(hash(elem));
+        uint8_t const fp = h & 0x7f;
+        size_t const mask = tableSize_ / GROUP - 1;
+        size_t g = (h >> 7) & mask;
+
+        for (size_t step = 1;; ++step) {
+            size_t const base = g * GROUP;
+            uint8_t const* m = meta + base;
+
+            for (unsigned hit = matchBytes(m, fp); hit; hit &= hit - 1) {
+                T& e = slots[base + lowestBit(hit)];
+                if (equal(e, elem)) return e;
+                ++collisions_;
+            }
+
+            unsigned empty = matchBytes(m, EMPTY);
+            if (empty) {
+                size_t k = base + lowestBit(empty);
+                meta[k] = fp;
+                slots[k] = elem;
+                ++size_;
+                return slots[k];
+            }
+            g = (g + step) & mask;
+        }
+    }
+};
+
+} // namespace tdzdd
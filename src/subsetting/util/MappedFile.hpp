@@ -0,0 +1,120 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TDZDD_MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tdzdd {
+
+/**
+ * Read-only image of a file.
+ * The file is mapped into memory where mmap is available, and read into
+ * a buffer elsewhere.
+ */
+class MappedFile {
+    char const* data_;
+    size_t size_;
+    std::vector<char> buffer;
+
+    MappedFile(MappedFile const&);
+    MappedFile& operator=(MappedFile const&);
+
+public:
+    /**
+     * Opens a file.
+     * @param path the file name.
+     */
+    explicit MappedFile(std::string const& path)
+            : data_(0), size_(0) {
+#ifdef TDZDD_MAPPED_FILE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error(
+                "MappedFile: Can't open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: Can't stat " + path);
+        }
+        size_ = st.st_size;
+        if (size_ > 0) {
+            void* p = ::mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: Can't map " + path);
+            }
+            data_ = static_cast<char const*>(p);
+        }
+        ::close(fd);
+#else
+        std::FILE* fp = std::fopen(path.c_str(), "rb");
+        if (fp == 0) throw std::runtime_error(
+                "MappedFile: Can't open " + path);
+        char chunk[1 << 16];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+            buffer.insert(buffer.end(), chunk, chunk + n);
+        }
+        std::fclose(fp);
+        size_ = buffer.size();
+        data_ = buffer.empty() ? 0 : &buffer[0];
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef TDZDD_MAPPED_FILE_MMAP
+        if (data_ != 0) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    /**
+     * Returns the contents.
+     * @return pointer to the first byte.
+     */
+    char const* data() const {
+        return data_;
+    }
+
+    /**
+     * Returns the size of the file.
+     * @return the size in bytes.
+     */
+    size_t size() const {
+        return size_;
+    }
+};
+
+} // namespace tdzdd
@@ -29,12 +29,14 @@
 #include <stdexcept>
 
 #include "MyVector.hpp"
+#include "ThreadArena.hpp"
 
 namespace tdzdd {
 
 /**
  * Memory pool.
  * Allocated memory blocks are kept until the pool is destructed.
+ * The blocks come from the ThreadArena of the calling thread.
  */
 class MemoryPool {
     struct Unit {
@@ -42,7 +44,8 @@ class MemoryPool {
     };
 
     static size_t const UNIT_SIZE = sizeof(Unit);
-    static size_t const BLOCK_UNITS = 400000 / UNIT_SIZE;
+    // 512 KB including the header of ThreadArena
+    static size_t const BLOCK_UNITS = ((size_t(1) << 19) - 16) / UNIT_SIZE;
     static size_t const MAX_ELEMENT_UNIS = BLOCK_UNITS / 10;
 
     Unit* blockList;
@@ -95,7 +98,7 @@ public:
         while (blockList != 0) {
             Unit* block = blockList;
             blockList = blockList->next;
-            delete[] block;
+            ThreadArena::release(block);
         }
         nextUnit = BLOCK_UNITS;
     }
@@ -105,7 +108,7 @@ public:
         while (blockList->next != 0) {
             Unit* block = blockList;
             blockList = blockList->next;
-            delete[] block;
+            ThreadArena::release(block);
         }
         nextUnit = 1;
     }
@@ -131,7 +134,7 @@ public:
 
         if (elementUnits > MAX_ELEMENT_UNIS) {
             size_t m = elementUnits + 1;
-            Unit* block = new Unit[m];
+            Unit* block = static_cast<Unit*>(ThreadArena::alloc(m * UNIT_SIZE));
             if (blockList == 0) {
                 block->next = 0;
                 blockList = block;
@@ -144,7 +147,8 @@ public:
         }
 
         if (nextUnit + elementUnits > BLOCK_UNITS) {
-            Unit* block = new Unit[BLOCK_UNITS];
+            Unit* block = static_cast<Unit*>(ThreadArena::alloc(
+                    BLOCK_UNITS * UNIT_SIZE));
             block->next = blockList;
             blockList = block;
             nextUnit = 1;
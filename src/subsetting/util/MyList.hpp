@@ -28,6 +28,8 @@
 #include <cstring>
 #include <stdexcept>
 
+#include "ThreadArena.hpp"
+
 namespace tdzdd {
 
 template<typename T, size_t BLOCK_ELEMENTS = 1000>
@@ -127,7 +129,7 @@ public:
                 p = p->next;
             }
 
-            delete[] blockStart(front_);
+            ThreadArena::release(blockStart(front_));
             front_ = clearFlag(p);
         }
         size_ = 0;
@@ -160,8 +162,10 @@ public:
         size_t const n = numCells(numElements * sizeof(T)) + 1;
 
         if (front_ == 0 || front_ < blockStart(front_) + headerCells + n) {
-            size_t const m = headerCells + n * BLOCK_ELEMENTS;
-            Cell* newBlock = new Cell[m];
+            size_t m = headerCells + n * BLOCK_ELEMENTS;
+            Cell* newBlock = static_cast<Cell*>(ThreadArena::alloc(
+                    m * sizeof(Cell), &m));
+            m /= sizeof(Cell);
             Cell* newFront = newBlock + m - n;
             blockStart(newFront) = newBlock;
             newFront->next = setFlag(front_);
@@ -186,7 +190,7 @@ public:
         Cell* next = front_->next;
 
         if (flagged(next)) {
-            delete[] blockStart(front_);
+            ThreadArena::release(blockStart(front_));
             front_ = clearFlag(next);
         }
         else {
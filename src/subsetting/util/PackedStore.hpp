@@ -0,0 +1,177 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+#include <vector>
+
+namespace tdzdd {
+
+/**
+ * In-memory store of compressed records.
+ * Records are appended sequentially and read back in the same order, as
+ * in SpillFile.  Each word of a record is XORed with the same word of the
+ * previous record, and only the nonzero bytes of the difference are kept
+ * after a byte marking them.  States of a level that share most of their
+ * words, such as mate arrays of small offsets, shrink to a few bytes.
+ */
+class PackedStore {
+    typedef uint64_t Word;
+
+    std::vector<uint8_t> data;
+    std::vector<Word> lastWritten;
+    std::vector<Word> lastRead;
+    size_t size_;
+    size_t used;
+    size_t pos;
+
+    static size_t numWords(size_t n) {
+        assert(n % sizeof(Word) == 0);
+        return n / sizeof(Word);
+    }
+
+    /*
+     * Returns the mask of the nonzero bytes of a word.
+     */
+    static int nonzeroBytes(Word w) {
+        w |= w >> 4;
+        w |= w >> 2;
+        w |= w >> 1;
+        w &= 0x0101010101010101ULL;
+        return (w * 0x0102040810204080ULL) >> 56;
+    }
+
+public:
+    PackedStore()
+            : size_(0), used(0), pos(0) {
+    }
+
+    /**
+     * Returns the number of records.
+     * @return the number of records.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Checks emptiness.
+     * @return true if empty.
+     */
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Returns the memory used by the records.
+     * @return the number of bytes.
+     */
+    size_t bytes() const {
+        return data.size();
+    }
+
+    /**
+     * Appends a record.
+     * @param p pointer to the record.
+     * @param n size of the record in bytes, a multiple of 8.
+     */
+    void write(void const* p, size_t n) {
+        size_t const m = numWords(n);
+        if (lastWritten.size() != m) lastWritten.assign(m, 0);
+
+        size_t const maxBytes = m * (sizeof(Word) + 1);
+        if (data.size() < used + maxBytes) {
+            data.resize(std::max(data.size() * 2, used + maxBytes));
+        }
+        uint8_t* q = &data[used];
+        uint8_t const* s = static_cast<uint8_t const*>(p);
+
+        for (size_t i = 0; i < m; ++i) {
+            Word w;
+            std::memcpy(&w, s + i * sizeof(Word), sizeof(Word));
+            Word d = w ^ lastWritten[i];
+            lastWritten[i] = w;
+
+            int mask = nonzeroBytes(d);
+            *q++ = mask;
+            for (; mask != 0; mask &= mask - 1) {
+                *q++ = d >> (__builtin_ctz(mask) * 8);
+            }
+        }
+
+        used = q - &data[0];
+        ++size_;
+    }
+
+    /**
+     * Moves to the first record.
+     */
+    void rewind() {
+        pos = 0;
+        lastRead.clear();
+    }
+
+    /**
+     * Reads the next record.
+     * @param p pointer to the storage.
+     * @param n size of the record in bytes, a multiple of 8.
+     */
+    void read(void* p, size_t n) {
+        size_t const m = numWords(n);
+        if (lastRead.size() != m) lastRead.assign(m, 0);
+        uint8_t* s = static_cast<uint8_t*>(p);
+
+        if (pos >= used) throw std::runtime_error("PackedStore: Read error");
+
+        for (size_t i = 0; i < m; ++i) {
+            int mask = data[pos++];
+            Word d = 0;
+            for (; mask != 0; mask &= mask - 1) {
+                d |= Word(data[pos++]) << (__builtin_ctz(mask) * 8);
+            }
+            Word w = lastRead[i] ^ d;
+            lastRead[i] = w;
+            std::memcpy(s + i * sizeof(Word), &w, sizeof(Word));
+        }
+    }
+
+    /**
+     * Deletes all records and releases the memory.
+     */
+    void clear() {
+        std::vector<uint8_t>().swap(data);
+        lastWritten.clear();
+        lastRead.clear();
+        size_ = 0;
+        used = 0;
+        pos = 0;
+    }
+};
+
+} // namespace tdzdd
@@ -0,0 +1,122 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+
+namespace tdzdd {
+
+/**
+ * Temporary file of records.
+ * Records are appended sequentially and read back in the same order.
+ * The file is deleted when it is cleared.
+ */
+class SpillFile {
+    std::FILE* fp;
+    size_t size_;
+
+public:
+    SpillFile()
+            : fp(0), size_(0) {
+    }
+
+    SpillFile(SpillFile const& o)
+            : fp(0), size_(0) {
+        if (o.fp != 0) throw std::runtime_error(
+                "SpillFile can't be copied unless it is empty!");
+    }
+
+    SpillFile& operator=(SpillFile const& o) {
+        if (o.fp != 0) throw std::runtime_error(
+                "SpillFile can't be copied unless it is empty!");
+        clear();
+        return *this;
+    }
+
+    ~SpillFile() {
+        clear();
+    }
+
+    /**
+     * Returns the number of records.
+     * @return the number of records.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Checks emptiness.
+     * @return true if empty.
+     */
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Appends a record.
+     * @param p pointer to the record.
+     * @param n size of the record in bytes.
+     */
+    void write(void const* p, size_t n) {
+        if (fp == 0) {
+            fp = std::tmpfile();
+            if (fp == 0) throw std::runtime_error(
+                    "SpillFile: Can't create a temporary file");
+        }
+        if (std::fwrite(p, 1, n, fp) != n) throw std::runtime_error(
+                "SpillFile: Write error");
+        ++size_;
+    }
+
+    /**
+     * Moves to the first record.
+     */
+    void rewind() {
+        if (fp != 0) std::rewind(fp);
+    }
+
+    /**
+     * Reads the next record.
+     * @param p pointer to the storage.
+     * @param n size of the record in bytes.
+     */
+    void read(void* p, size_t n) {
+        if (fp == 0 || std::fread(p, 1, n, fp) != n)
+            throw std::runtime_error("SpillFile: Read error");
+    }
+
+    /**
+     * Deletes all records and the file.
+     */
+    void clear() {
+        if (fp != 0) std::fclose(fp);
+        fp = 0;
+        size_ = 0;
+    }
+};
+
+} // namespace tdzdd
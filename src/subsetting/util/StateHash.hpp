@@ -0,0 +1,306 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define TDZDD_STATE_HASH_X86
+#include <immintrin.h>
+#endif
+
+namespace tdzdd {
+
+/**
+ * Hashing and comparison of POD states stored in words.
+ * States shorter than SHORT_WORDS words, such as the mate arrays of the
+ * frontier-based specs, are hashed by the original multiplicative loop.
+ * Longer ones use the implementation selected at run time by the CPU
+ * features: AVX2, SSE4.2 (CRC32C), or portable scalar code, whose hash
+ * codes are finished by a 64-bit mixer.  The hash codes differ among the
+ * implementations; select() must not be called while DDs are being built.
+ */
+class StateHash {
+public:
+    typedef size_t Word;
+
+    /// Implementations.
+    enum Impl {
+        AUTO, ///< The best one supported by the CPU.
+        SCALAR, ///< Portable scalar code.
+        SSE42, ///< CRC32C of SSE4.2 and 128-bit comparison.
+        AVX2 ///< 256-bit multiply-accumulate and comparison.
+    };
+
+private:
+    template<int N = 0>
+    struct Current {
+        static std::atomic<Impl> impl; ///< AUTO until detected.
+    };
+
+    // Shorter states are handled by the inlined original loops, which are
+    // faster than a call to the vectorized code and need no mixer.
+    static int const SHORT_WORDS = 8;
+
+    static uint64_t const K1 = 0x9e3779b97f4a7c15ULL;
+    static uint64_t const K2 = 0xc2b2ae3d27d4eb4fULL;
+
+    static size_t hashShort(Word const* p, int n) {
+        size_t h = 0;
+        for (int i = 0; i < n; ++i) {
+            h += p[i];
+            h *= 314159257;
+        }
+        return h;
+    }
+
+    // Two lanes of multiply-accumulate.
+    static size_t hashScalar(Word const* p, int n) {
+        uint64_t a = n;
+        uint64_t b = K2;
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            a = (a + p[i]) * K1;
+            b = (b + p[i + 1]) * K2;
+        }
+        if (i < n) a = (a + p[i]) * K1;
+        return mix(a ^ (b << 32 | b >> 32));
+    }
+
+    static bool equalScalar(Word const* p, Word const* q, int n) {
+        for (int i = 0; i < n; ++i) {
+            if (p[i] != q[i]) return false;
+        }
+        return true;
+    }
+
+#ifdef TDZDD_STATE_HASH_X86
+    // Two CRC32C streams over the even and the odd words.
+    __attribute__((target("sse4.2")))
+    static size_t hashSse42(Word const* p, int n) {
+        uint64_t a = n;
+        uint64_t b = ~uint64_t(n);
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            a = _mm_crc32_u64(a, p[i]);
+            b = _mm_crc32_u64(b, p[i + 1]);
+        }
+        if (i < n) a = _mm_crc32_u64(a, p[i]);
+        return mix((a << 32) ^ b);
+    }
+
+    __attribute__((target("sse4.2")))
+    static bool equalSse42(Word const* p, Word const* q, int n) {
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(q + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff) return false;
+        }
+        return i == n || p[i] == q[i];
+    }
+
+    // Four lanes accumulating the products of the 32-bit halves of the
+    // keyed words as in XXH3.
+    __attribute__((target("avx2")))
+    static size_t hashAvx2(Word const* p, int n) {
+        __m256i const key = _mm256_set_epi64x(K1, K2, ~K1, ~K2);
+        __m256i acc = _mm256_set1_epi64x(n);
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(p + i));
+            __m256i y = _mm256_xor_si256(x, key);
+            acc = _mm256_add_epi64(acc,
+                    _mm256_mul_epu32(y, _mm256_srli_epi64(y, 32)));
+            acc = _mm256_add_epi64(acc, _mm256_shuffle_epi32(x, 0x4e));
+            acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+        }
+        uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        uint64_t a = (lanes[0] + lanes[2]) * K1;
+        uint64_t b = (lanes[1] + lanes[3]) * K2;
+        for (; i < n; ++i) {
+            a = (a + p[i]) * K1;
+        }
+        return mix(a ^ (b << 32 | b >> 32));
+    }
+
+    __attribute__((target("avx2")))
+    static bool equalAvx2(Word const* p, Word const* q, int n) {
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(p + i));
+            __m256i y = _mm256_loadu_si256(
+                    reinterpret_cast<__m256i const*>(q + i));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(x, y)) != -1)
+                return false;
+        }
+        for (; i < n; ++i) {
+            if (p[i] != q[i]) return false;
+        }
+        return true;
+    }
+#endif
+
+    static Impl detect() {
+#ifdef TDZDD_STATE_HASH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return AVX2;
+        if (__builtin_cpu_supports("sse4.2")) return SSE42;
+#endif
+        return SCALAR;
+    }
+
+public:
+    /**
+     * Checks if an implementation runs on this CPU.
+     * @param impl the implementation.
+     * @return true if it is supported.
+     */
+    static bool supported(Impl impl) {
+        switch (impl) {
+        case AUTO:
+        case SCALAR:
+            return true;
+#ifdef TDZDD_STATE_HASH_X86
+        case SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        case AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Selects the implementation.
+     * An unsupported one falls back to the best supported one.
+     * @param impl the implementation, or AUTO for the best one.
+     * @return the implementation selected.
+     */
+    static Impl select(Impl impl = AUTO) {
+        if (impl == AUTO || !supported(impl)) impl = detect();
+        Current<>::impl.store(impl, std::memory_order_relaxed);
+        return impl;
+    }
+
+    /**
+     * Gets the implementation in use.
+     * @return the implementation.
+     */
+    static Impl selected() {
+        Impl impl = Current<>::impl.load(std::memory_order_relaxed);
+        return (impl != AUTO) ? impl : select();
+    }
+
+    /**
+     * Gets the name of an implementation.
+     * @param impl the implementation.
+     * @return the name.
+     */
+    static char const* name(Impl impl) {
+        switch (impl) {
+        case SCALAR:
+            return "scalar";
+        case SSE42:
+            return "sse4.2";
+        case AVX2:
+            return "avx2";
+        default:
+            return "auto";
+        }
+    }
+
+    /**
+     * Mixes the bits of a hash code (the finalizer of MurmurHash3).
+     * @param h the hash code.
+     * @return the mixed hash code.
+     */
+    static size_t mix(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /**
+     * Computes the hash code of words.
+     * @param p the words.
+     * @param n the number of words.
+     * @return the hash code.
+     */
+    static size_t hash(Word const* p, int n) {
+        if (n < SHORT_WORDS) return hashShort(p, n);
+        switch (Current<>::impl.load(std::memory_order_relaxed)) {
+#ifdef TDZDD_STATE_HASH_X86
+        case AVX2:
+            return hashAvx2(p, n);
+        case SSE42:
+            return hashSse42(p, n);
+#endif
+        case SCALAR:
+            return hashScalar(p, n);
+        default:
+            selected();
+            return hash(p, n);
+        }
+    }
+
+    /**
+     * Compares words.
+     * @param p the words.
+     * @param q the other words.
+     * @param n the number of words.
+     * @return true if they are equal.
+     */
+    static bool equal(Word const* p, Word const* q, int n) {
+        if (n < SHORT_WORDS) return equalScalar(p, q, n);
+        switch (Current<>::impl.load(std::memory_order_relaxed)) {
+#ifdef TDZDD_STATE_HASH_X86
+        case AVX2:
+            return equalAvx2(p, q, n);
+        case SSE42:
+            return equalSse42(p, q, n);
+#endif
+        case SCALAR:
+            return equalScalar(p, q, n);
+        default:
+            selected();
+            return equal(p, q, n);
+        }
+    }
+};
+
+template<int N>
+std::atomic<StateHash::Impl> StateHash::Current<N>::impl(StateHash::AUTO);
+
+} // namespace tdzdd
@@ -0,0 +1,245 @@
+/*
+ * TdZdd: a Top-down/Breadth-first Decision Diagram Manipulation Framework
+ * by Hiroaki Iwashita <iwashita@erato.ist.hokudai.ac.jp>
+ * Copyright (c) 2014 ERATO MINATO Project
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace tdzdd {
+
+/**
+ * Per-thread cache of memory blocks.
+ * Blocks are rounded up to size classes of powers of two and carry their
+ * class in a hidden header word.  A released block is kept in the cache
+ * of the releasing thread and handed out again by the next allocation of
+ * the same class on that thread, so that the parallel builders, which
+ * free the spec nodes of a level while producing those of the next one,
+ * rarely enter the global allocator.  A block released by another thread
+ * than the one that allocated it moves to the cache of the releasing
+ * thread, so no NUMA placement is implied.  The cached bytes of all the
+ * threads are bounded by cacheLimit() per thread and reported by
+ * cachedBytes(), so that a BuildControl can charge them to a build.
+ */
+class ThreadArena {
+    static int const CLASSES = 64;
+    static int const MIN_CLASS = 6; ///< 64 bytes.
+
+    struct Block {
+        Block* next;
+    };
+
+    struct Header {
+        size_t sizeClass;
+        size_t padding; ///< keeps blocks 16-byte aligned.
+    };
+
+    Block* freeList[CLASSES];
+    size_t localBytes;
+
+    template<int N = 0>
+    struct Shared {
+        static std::atomic<size_t> limit;
+        static std::atomic<size_t> cached; ///< the total of all threads.
+    };
+
+    ThreadArena()
+            : localBytes(0) {
+        for (int k = 0; k < CLASSES; ++k) {
+            freeList[k] = 0;
+        }
+    }
+
+    ThreadArena(ThreadArena const&);
+    ThreadArena& operator=(ThreadArena const&);
+
+    ~ThreadArena() {
+        trimCache();
+        dead() = true;
+    }
+
+    static bool& dead() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    static ThreadArena* local() {
+        if (dead()) return 0;
+        static thread_local ThreadArena arena;
+        return &arena;
+    }
+
+    static int sizeClass(size_t bytes) {
+        int k = MIN_CLASS;
+        while ((size_t(1) << k) < bytes) {
+            ++k;
+        }
+        return k;
+    }
+
+    void* allocBlock(int k) {
+        if (freeList[k] != 0) {
+            Block* b = freeList[k];
+            freeList[k] = b->next;
+            localBytes -= size_t(1) << k;
+            Shared<>::cached.fetch_sub(size_t(1) << k,
+                    std::memory_order_relaxed);
+            return b;
+        }
+        return ::operator new(size_t(1) << k);
+    }
+
+    void releaseBlock(void* p, int k) {
+        size_t const bytes = size_t(1) << k;
+        if (localBytes + bytes
+                > Shared<>::limit.load(std::memory_order_relaxed)) {
+            ::operator delete(p);
+            return;
+        }
+        Block* b = static_cast<Block*>(p);
+        b->next = freeList[k];
+        freeList[k] = b;
+        localBytes += bytes;
+        Shared<>::cached.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void trimCache() {
+        for (int k = 0; k < CLASSES; ++k) {
+            while (freeList[k] != 0) {
+                Block* b = freeList[k];
+                freeList[k] = b->next;
+                ::operator delete(b);
+            }
+        }
+        Shared<>::cached.fetch_sub(localBytes, std::memory_order_relaxed);
+        localBytes = 0;
+    }
+
+public:
+    /**
+     * Allocates a memory block.
+     * @param bytes the minimum size in bytes.
+     * @param capacity the size actually usable, if not null.
+     * @return pointer to the block.
+     */
+    static void* alloc(size_t bytes, size_t* capacity = 0) {
+        int const k = sizeClass(bytes + sizeof(Header));
+        ThreadArena* arena = local();
+        Header* h = static_cast<Header*>(
+                arena ? arena->allocBlock(k) : ::operator new(size_t(1) << k));
+        h->sizeClass = k;
+        if (capacity) *capacity = (size_t(1) << k) - sizeof(Header);
+        return h + 1;
+    }
+
+    /**
+     * Releases a memory block to the cache of the calling thread.
+     * @param p pointer to the block allocated by alloc(), or null.
+     */
+    static void release(void* p) {
+        if (p == 0) return;
+        Header* h = static_cast<Header*>(p) - 1;
+        ThreadArena* arena = local();
+        if (arena) {
+            arena->releaseBlock(h, h->sizeClass);
+        }
+        else {
+            ::operator delete(h);
+        }
+    }
+
+    /**
+     * Returns the cached blocks of the calling thread to the system.
+     */
+    static void trim() {
+        ThreadArena* arena = local();
+        if (arena) arena->trimCache();
+    }
+
+    /**
+     * Returns the cached blocks of all the OpenMP threads to the system.
+     */
+    static void trimAll() {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        trim();
+    }
+
+    /**
+     * Returns the cached blocks of all the OpenMP threads to the system
+     * at the end of its scope, also when the scope is left by an exception.
+     */
+    class TrimScope {
+        TrimScope(TrimScope const&);
+        TrimScope& operator=(TrimScope const&);
+
+    public:
+        TrimScope() {
+        }
+
+        ~TrimScope() {
+            trimAll();
+        }
+    };
+
+    /**
+     * Gets the total size of the blocks cached by all the threads.
+     * @return the size in bytes.
+     */
+    static size_t cachedBytes() {
+        return Shared<>::cached.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the maximum size of the cache of each thread.
+     * @return the size in bytes.
+     */
+    static size_t cacheLimit() {
+        return Shared<>::limit.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Sets the maximum size of the cache of each thread (4 MB by default).
+     * Released blocks beyond the limit are returned to the system.
+     * @param bytes the size in bytes; 0 disables the cache.
+     * @return the old limit.
+     */
+    static size_t cacheLimit(size_t bytes) {
+        return Shared<>::limit.exchange(bytes, std::memory_order_relaxed);
+    }
+};
+
+template<int N>
+std::atomic<size_t> ThreadArena::Shared<N>::limit(size_t(4) << 20);
+
+template<int N>
+std::atomic<size_t> ThreadArena::Shared<N>::cached(0);
+
+} // namespace tdzdd
@@ -23,9 +23,12 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 **********************************************************************/
 
 #include <cassert>
+#include <cstdlib>
 #include <cstdarg>
 #include <cstdio>
+#include <unistd.h>
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <string>
@@ -33,8 +36,15 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 
 #include "graphillion/graphset.h"
+#include "graphillion/ordering/EdgeOrdering.h"
 #include "graphillion/setset.h"
 #include "graphillion/util.h"
+#include "subsetting/DdStructure.hpp"
+#include "subsetting/dd/NodeTable.hpp"
+#include "subsetting/dd/PathCounter.hpp"
+#include "subsetting/spec/SapporoZdd.hpp"
+#include "subsetting/util/StateHash.hpp"
+#include "subsetting/util/ThreadArena.hpp"
 
 namespace graphillion {
 
@@ -75,6 +85,38 @@ vector<vector<vertex_t> > V(const string& str) {
   return v;
 }
 
+// A state counting its live copies.
+struct CountedState {
+  static int live;
+  int k;
+  CountedState() : k(0) { ++live; }
+  CountedState(const CountedState& o) : k(o.k) { ++live; }
+  ~CountedState() { --live; }
+  bool operator==(const CountedState& o) const { return k == o.k; }
+};
+
+int CountedState::live = 0;
+
+// The sets of n items counted by the number of chosen items.
+class CountedSpec
+    : public tdzdd::DdSpec<CountedSpec, CountedState, 2> {
+ public:
+  explicit CountedSpec(int n) : n_(n) {}
+
+  int getRoot(CountedState& s) {
+    s.k = 0;
+    return n_;
+  }
+
+  int getChild(CountedState& s, int level, int value) {
+    s.k += value;
+    return level > 1 ? level - 1 : -1;
+  }
+
+ private:
+  int n_;
+};
+
 int e12 = 0;
 int e13 = 0;
 int e14 = 0;
@@ -209,6 +251,19 @@ class TestGraphSet {
     this->rooted_paths();
     this->hamilton_paths();
     this->large();
+    this->fused_constraints();
+    this->counted_graphs();
+    this->spilled_states();
+    this->build_control();
+    this->aborted_states();
+    this->build_metrics();
+    this->size_estimate();
+    this->state_hash();
+    this->level_index();
+    this->cardinality();
+    this->enumerator();
+    this->save_and_load();
+    this->frontier_order();
   }
 
   void any_subgraphs() {
@@ -275,6 +330,25 @@ class TestGraphSet {
     assert(ss.size() == "66");
     assert(ss.find(S(3, e12, e14, e25)) != ss.end());
     assert(ss.find(S(4, e12, e14, e25, e45)) == ss.end());
+
+    // search spaces that collapse to terminals
+    setset empty;
+    assert(SearchGraphs(graph, NULL, NULL, NULL, -1, true, &empty).empty());
+    setset null_set(vector<set<elem_t> >(1));
+    ss = SearchGraphs(graph, NULL, NULL, NULL, -1, true, &null_set);
+    assert(ss.size() == "1");
+    assert(ss.find(set<elem_t>()) != ss.end());
+
+    // search space whose top element is not the first one
+    vector<set<elem_t> > v;
+    v.push_back(S(2, e25, e36));
+    v.push_back(S(2, e45, e56));
+    v.push_back(S(3, e36, e45, e56));
+    v.push_back(S(1, e56));
+    setset sub(v);
+    ss = SearchGraphs(graph, NULL, NULL, NULL, -1, true, &sub);
+    assert(ss == (SearchGraphs(graph, NULL, NULL, NULL, -1, true) & sub));
+    assert(ss.size() == "4");
   }
 
   void two_clusters_only() {
@@ -437,17 +511,397 @@ class TestGraphSet {
   }
 
   void large() {
-    setup_large(8);
-    vector<vector<vertex_t> > vertex_groups = V("{{1, 64}}");
+    vector<vector<vertex_t> > vertex_groups;
     map<vertex_t, Range> degree_constraints;
-    for (vector<vertex_t>::const_iterator v = vertices.begin();
-         v != vertices.end(); ++v)
-      degree_constraints[*v]
-          = *v == "1" || *v == "64" ? Range(1, 2) : Range(0, 3, 2);
+    setup_large_paths(&vertex_groups, &degree_constraints);
     setset ss = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL,
                              0, true);
     assert(ss.size() == "789360053252");
   }
+
+  void fused_constraints() {  // fused into the frontier-based search
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    setset ss = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL,
+                             0, true);
+    Range num_edges(14, 21);
+    setset fused = SearchGraphs(graph, &vertex_groups, &degree_constraints,
+                                &num_edges, 0, true);
+    assert(fused == ss.size_between(14, 20));
+    map<vertex_t, Range> end_degrees;
+    end_degrees["1"] = Range(1, 2);
+    end_degrees["64"] = Range(1, 2);
+    setset trees = SearchGraphs(graph, &vertex_groups, &end_degrees, NULL, 0,
+                                true);
+    num_edges = Range(14, 16);  // the degree constraint is fused as well
+    fused = SearchGraphs(graph, &vertex_groups, &end_degrees, &num_edges, 0,
+                         true);
+    assert(fused == trees.size_between(14, 15));
+  }
+
+  void counted_graphs() {  // counted without building the DD
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    setset ss = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL,
+                             0, true);
+    map<vertex_t, Range> end_degrees;
+    end_degrees["1"] = Range(1, 2);
+    end_degrees["64"] = Range(1, 2);
+    Range num_edges(14, 16);
+    setset fused = SearchGraphs(graph, &vertex_groups, &end_degrees,
+                                &num_edges, 0, true);
+    assert(CountGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0,
+                       true) == "789360053252");
+    assert(CountGraphs(graph, &vertex_groups, &end_degrees, &num_edges, 0,
+                       true) == fused.size());
+    assert(CountGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0,
+                       true, &fused) == (ss & fused).size());
+  }
+
+  void spilled_states() {  // pending levels moved out of memory
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    setset ss = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL,
+                             0, true);
+    size_t budget = SpillBudget(0);
+    bool pack = PackStates(false);
+
+    // only trivially copyable states are moved
+    static_assert(tdzdd::DdStructure<2>::TRIVIAL_STATES, "");
+    static_assert(!tdzdd::SapporoZdd::TRIVIAL_STATES, "");
+
+    // pending levels are spilled to temporary files
+    assert(SpillBudget(1) == 0);
+    setset spilled = SearchGraphs(graph, &vertex_groups, &degree_constraints,
+                                  NULL, 0, true);
+    assert(SpillBudget(0) == 1);
+    assert(spilled == ss);
+
+    // pending levels are packed in memory, and spilled as well
+    assert(!PackStates(true));
+    setset packed = SearchGraphs(graph, &vertex_groups, &degree_constraints,
+                                 NULL, 0, true);
+    assert(packed == ss);
+    SpillBudget(1 << 16);
+    packed = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0,
+                          true);
+    assert(packed == ss);
+
+    SpillBudget(budget);
+    PackStates(pack);
+  }
+
+  void build_control() {  // stops the search between levels
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    setset ss = SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL,
+                             0, true);
+    tdzdd::BuildControl control;
+    control.setMaxNodes(1000);
+    try {
+      tdzdd::BuildControl::Scope scope(control);
+      SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0, true);
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::BUDGET);
+    }
+    control.setMaxNodes(0);
+    int levels = 0;
+    control.setCallback(count_levels, &levels);
+    {
+      tdzdd::BuildControl::Scope scope(control);
+      assert(SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0,
+                          true) == ss);
+    }
+    assert(levels >= 112);  // one per edge at least
+    control.setCallback(cancel_at_level, NULL);
+    try {
+      tdzdd::BuildControl::Scope scope(control);
+      SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0, true);
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::CANCELLED);
+      assert(e.level() == 50);
+    }
+    control.setCallback(NULL);
+    control.cancel();  // before the search starts
+    try {
+      tdzdd::BuildControl::Scope scope(control);
+      SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0, true);
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::CANCELLED);
+    }
+    assert(tdzdd::BuildControl::active() == NULL);
+  }
+
+  void aborted_states() {  // destructed when a build is aborted
+    tdzdd::BuildControl control;
+    control.setMaxNodes(100);
+    try {
+      tdzdd::BuildControl::Scope scope(control);
+      tdzdd::DdStructure<2> dd((CountedSpec(40)));
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::BUDGET);
+    }
+    assert(CountedState::live == 0);
+    assert(tdzdd::ThreadArena::cachedBytes() == 0);
+    try {
+      tdzdd::DdStructure<2> dd(40);
+      tdzdd::BuildControl::Scope scope(control);
+      dd.zddSubset(CountedSpec(40));
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::BUDGET);
+    }
+    assert(CountedState::live == 0);
+    try {
+      tdzdd::BuildControl::Scope scope(control);
+      tdzdd::countPathsMP(CountedSpec(40));
+      assert(false);
+    } catch (const tdzdd::BuildAborted& e) {
+      assert(e.reason() == tdzdd::BuildAborted::BUDGET);
+    }
+    assert(CountedState::live == 0);
+  }
+
+  void build_metrics() {  // recorded level by level
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    tdzdd::BuildMetrics metrics;
+    {
+      tdzdd::BuildMetrics::Scope scope(&metrics);
+      SearchGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0, true);
+    }
+    assert(tdzdd::BuildMetrics::active() == NULL);
+    assert(!metrics.operations().empty());
+    const tdzdd::OperationMetrics& op = metrics.operations().front();
+    assert(!op.aborted);
+    assert(op.levels.size() == graph.size());
+    size_t nodes = 0;
+    for (size_t i = 0; i < op.levels.size(); ++i)
+      nodes += op.levels[i].nodes;
+    assert(nodes == op.size);
+    stringstream json;
+    metrics.dumpJson(json);
+    assert(json.str().find("\"levels\":[") != string::npos);
+  }
+
+  void size_estimate() {  // exact if the sample covers the levels
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    tdzdd::BuildMetrics metrics;
+    {
+      tdzdd::BuildMetrics::Scope scope(&metrics);
+      SearchGraphs(graph, &vertex_groups);
+    }
+    const tdzdd::OperationMetrics& search = metrics.operations().front();
+    tdzdd::SizeEstimate estimate = EstimateGraphs(
+        graph, &vertex_groups, NULL, NULL, -1, false, NULL, search.size);
+    assert(estimate.width.size() == graph.size() + 1);
+    for (size_t i = 0; i < search.levels.size(); ++i)
+      assert(estimate.width[search.levels[i].level]
+             == search.levels[i].nodes);
+    assert(estimate.nodes == search.size);
+    estimate = EstimateGraphs(graph, &vertex_groups, NULL, NULL, -1, false,
+                              NULL, 1000);
+    assert(estimate.nodes > search.size / 10);
+    assert(estimate.nodes < search.size * 10);
+    assert(estimate.bytes > estimate.nodes);
+  }
+
+  void state_hash() {  // the implementations agree on equality
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    tdzdd::StateHash::Impl selected = tdzdd::StateHash::selected();
+    size_t words[2][20];
+    for (int i = 0; i < 20; ++i) words[0][i] = words[1][i] = i * 0x10001;
+    for (int impl = tdzdd::StateHash::SCALAR;
+         impl <= tdzdd::StateHash::AVX2; ++impl) {
+      tdzdd::StateHash::select(static_cast<tdzdd::StateHash::Impl>(impl));
+      for (int n = 1; n <= 20; ++n) {
+        assert(tdzdd::StateHash::equal(words[0], words[1], n));
+        assert(tdzdd::StateHash::hash(words[0], n)
+               == tdzdd::StateHash::hash(words[1], n));
+        words[1][n - 1] ^= 1;
+        assert(!tdzdd::StateHash::equal(words[0], words[1], n));
+        assert(tdzdd::StateHash::hash(words[0], n)
+               != tdzdd::StateHash::hash(words[1], n));
+        words[1][n - 1] ^= 1;
+      }
+      assert(CountGraphs(graph, &vertex_groups, &degree_constraints, NULL, 0,
+                         true) == "789360053252");
+    }
+    tdzdd::StateHash::select(selected);
+  }
+
+  void level_index() {  // counts the branches into each level
+    tdzdd::NodeTableEntity<2> table(5);
+    table.initRow(4, 2);
+    table.initRow(3, 1);
+    table.initRow(2, 1);
+    table.initRow(1, 1);
+    table[4][0] = tdzdd::Node<2>(tdzdd::NodeId(3, 0), tdzdd::NodeId(1, 0));
+    table[4][1] = tdzdd::Node<2>(tdzdd::NodeId(1, 0), 1);
+    table[3][0] = tdzdd::Node<2>(tdzdd::NodeId(2, 0), 0);
+    table[2][0] = tdzdd::Node<2>(tdzdd::NodeId(1, 0), tdzdd::NodeId(1, 0));
+    table[1][0] = tdzdd::Node<2>(0, 1);
+    for (int mp = 0; mp < 2; ++mp) {
+      table.makeIndex(mp);
+      assert(table.fanIn(4) == 0 && table.fanIn(3) == 1);
+      assert(table.fanIn(2) == 1 && table.fanIn(1) == 4);
+      assert(table.lowerLevels(4).size() == 2);
+      assert(table.lowerLevels(4)[0] == 1 && table.lowerLevels(4)[1] == 3);
+      assert(table.lowerLevels(3).size() == 1);
+      assert(table.lowerLevels(2).empty());
+      assert(table.higherLevels(1).size() == 3);  // 4, 2 and 1 itself
+      assert(table.higherLevels(1)[0] == 4 && table.higherLevels(1)[1] == 2);
+      assert(table.higherLevels(2).size() == 1);
+    }
+  }
+
+  void cardinality() {  // in 128 bits unless the counts do not fit
+    assert(tdzdd::DdStructure<2>(100).zddCardinality()
+           == "1267650600228229401496703205376");
+    assert(tdzdd::DdStructure<2>(127).zddCardinality()
+           == "170141183460469231731687303715884105728");
+    assert(tdzdd::DdStructure<2>(128).zddCardinality()
+           == "340282366920938463463374607431768211456");
+    assert(tdzdd::DdStructure<2>(200).zddCardinality()
+           == "1606938044258990275541962092341162602522202993782792835301376");
+  }
+
+  void enumerator() {  // resumes from a saved cursor as the iterator
+    tdzdd::DdStructure<2> power_set(4);
+    tdzdd::DdStructure<2>::Enumerator enumerator(power_set);
+    tdzdd::DdStructure<2>::const_iterator it = power_set.begin();
+    vector<int> items;
+    vector<size_t> offsets;
+    size_t emitted = 0;
+    for (size_t k; (k = enumerator.next(items, offsets, 3)) > 0; ) {
+      assert(k <= 3 && offsets.size() == k + 1);
+      for (size_t j = 0; j < k; ++j, ++it)
+        assert(set<int>(items.begin() + offsets[j],
+                        items.begin() + offsets[j + 1]) == *it);
+      emitted += k;
+      enumerator.restore(enumerator.save());
+    }
+    assert(emitted == 16 && it == power_set.end() && enumerator.finished());
+  }
+
+  void save_and_load() {  // in the binary format
+    tdzdd::DdStructure<2> power_set(4);
+    power_set.zddReduce();
+    power_set.save("/tmp/graphillion_dd");
+    tdzdd::DdStructure<2> loaded;
+    loaded.load("/tmp/graphillion_dd");
+    assert(loaded.size() == power_set.size());
+    assert(loaded.zddCardinality() == "16");
+    tdzdd::DdStructure<3> ternary(5);
+    ternary.save("/tmp/graphillion_dd");
+    tdzdd::DdStructure<3> loaded3;
+    loaded3.load("/tmp/graphillion_dd");
+    assert(loaded3.zddCardinality() == "243");
+    try {
+      loaded.load("/tmp/graphillion_dd");
+      assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    FILE* fp = fopen("/tmp/graphillion_dd", "w");
+    fputs("TDZDDNT2", fp);
+    fclose(fp);
+    try {
+      loaded3.load("/tmp/graphillion_dd");
+      assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    assert(loaded3.zddCardinality() == "243");
+
+    // written while reduced, with a label
+    tdzdd::DdStructure<2> unreduced(4);
+    {
+      tdzdd::DdStructure<2>::Writer writer("/tmp/graphillion_dd", "key");
+      assert(unreduced.zddReduceAndEvaluate(
+          tdzdd::ZddCardinality<std::string>(), &writer) == "16");
+      assert(writer.finished());
+    }
+    loaded.load("/tmp/graphillion_dd", "key");
+    assert(loaded.size() == power_set.size());
+    assert(loaded.zddCardinality() == "16");
+    try {
+      loaded.load("/tmp/graphillion_dd", "another key");
+      assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    fp = fopen("/tmp/graphillion_dd", "r+");
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    assert(truncate("/tmp/graphillion_dd", size - 8) == 0);
+    try {
+      loaded.load("/tmp/graphillion_dd", "key");
+      assert(false);
+    } catch (const std::runtime_error&) {
+    }
+    assert(loaded.zddCardinality() == "16");
+    remove("/tmp/graphillion_dd");
+  }
+
+  void frontier_order() {  // no worse than the given one
+    vector<vector<vertex_t> > vertex_groups;
+    map<vertex_t, Range> degree_constraints;
+    setup_large_paths(&vertex_groups, &degree_constraints);
+    vector<pair<int, int> > edges;
+    for (size_t i = 0; i < graph.size(); ++i)
+      edges.push_back(make_pair(atoi(graph[i].first.c_str()) - 1,
+                                atoi(graph[i].second.c_str()) - 1));
+    vector<int> order = OrderEdgesByFrontier(64, edges, 0, false, 0.1);
+    vector<int> sorted_order(order);
+    sort(sorted_order.begin(), sorted_order.end());
+    for (size_t i = 0; i < sorted_order.size(); ++i)
+      assert(sorted_order[i] == static_cast<int>(i));
+    FrontierCost cost = EvaluateEdgeOrder(64, edges, order);
+    assert(cost.max <= EvaluateEdgeOrder(64, edges, sorted_order).max);
+    assert(cost.max <= 9);
+    // the order does not depend on the speed of the machine
+    assert(OrderEdgesByFrontier(64, edges, 0, false, 60.0) ==
+           OrderEdgesByFrontier(64, edges, 0, false, 60.0));
+    vector<edge_t> ordered_graph;
+    for (size_t i = 0; i < order.size(); ++i)
+      ordered_graph.push_back(graph[order[i]]);
+    assert(SearchGraphs(ordered_graph, &vertex_groups, &degree_constraints,
+                        NULL, 0, true).size() == "789360053252");
+  }
+
+  // s-t paths of the 8x8 grid from 1 to 64
+  static void setup_large_paths(vector<vector<vertex_t> >* vertex_groups,
+                                map<vertex_t, Range>* degree_constraints) {
+    setup_large(8);
+    *vertex_groups = V("{{1, 64}}");
+    degree_constraints->clear();
+    for (vector<vertex_t>::const_iterator v = vertices.begin();
+         v != vertices.end(); ++v)
+      (*degree_constraints)[*v]
+          = *v == "1" || *v == "64" ? Range(1, 2) : Range(0, 3, 2);
+  }
+
+  static bool count_levels(int, size_t, size_t, double, void* arg) {
+    ++*static_cast<int*>(arg);
+    return true;
+  }
+
+  static bool cancel_at_level(int level, size_t, size_t, double, void*) {
+    return level != 50;
+  }
+
 };
 
 }  // namespace graphillion
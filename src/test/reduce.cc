@@ -0,0 +1,107 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+// Checks that the parallel reduction gives the same DDs as the sequential
+// one at several numbers of threads, for both ZDD and BDD reductions.
+// Like bench_reduce, this program is compiled with OpenMP while the
+// library is not.
+
+#include <cassert>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "subsetting/DdStructure.hpp"
+#include "subsetting/spec/FrontierBasedSearch.hpp"
+#include "subsetting/util/Graph.hpp"
+
+using std::string;
+
+static string name(int v) {
+  std::stringstream s;
+  s << v;
+  return s.str();
+}
+
+static void grid(int n, tdzdd::Graph* g) {
+  for (int v = 1; v <= n * n; ++v) {
+    if (v % n != 0) g->addEdge(name(v), name(v + 1));
+    if (v <= (n - 1) * n) g->addEdge(name(v), name(v + n));
+  }
+  g->setColor(name(1), 1);
+  g->setColor(name(n * n), 1);
+  g->update();
+}
+
+static string dump(tdzdd::DdStructure<2> const& dd) {
+  std::stringstream s;
+  dd.dumpSapporo(s);
+  return s.str();
+}
+
+// Reduces the paths between the corners of an n x n grid sequentially and
+// in parallel, and compares the results.
+template<bool BDD>
+static void compare(int n) {
+  tdzdd::Graph g;
+  grid(n, &g);
+  tdzdd::FrontierBasedSearch spec(g, 0, true);
+
+  tdzdd::DdStructure<2> sequential(spec);
+  if (BDD) sequential.bddReduce();
+  else sequential.zddReduce();
+  string cardinality = BDD ? sequential.bddCardinality(g.edgeSize())
+                           : sequential.zddCardinality();
+
+  string first;
+  int const threads[] = {1, 2, 3, 4, 7};
+  for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads[t]);
+#endif
+    tdzdd::DdStructure<2> dd(spec);
+    dd.useMultiProcessors(true);
+    if (BDD) dd.bddReduce();
+    else dd.zddReduce();
+    assert(dd.size() == sequential.size());
+    assert((BDD ? dd.bddCardinality(g.edgeSize()) : dd.zddCardinality())
+           == cardinality);
+    // the columns do not depend on the number of threads
+    if (t == 0) first = dump(dd);
+    else assert(dump(dd) == first);
+  }
+}
+
+int main() {
+  for (int n = 2; n <= 7; ++n) {
+    compare<false>(n);
+    compare<true>(n);
+  }
+  printf("ok\n");
+  return 0;
+}
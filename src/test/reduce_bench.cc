@@ -0,0 +1,100 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+// Benchmark of the ZDD reduction: builds the unreduced DD of the paths
+// between the corners of a grid by FrontierBasedSearch, and reduces it
+// by the sequential algorithm and by the parallel one with 1, 2, 4, ...
+// threads.  Run as `bench_reduce [grid size] [max threads]`.  Like
+// bench_scaling, this program can be compiled with OpenMP while the
+// library is not.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "subsetting/DdStructure.hpp"
+#include "subsetting/spec/FrontierBasedSearch.hpp"
+#include "subsetting/util/Graph.hpp"
+
+using std::string;
+
+typedef std::chrono::steady_clock Clock;
+
+static string name(int v) {
+  std::stringstream s;
+  s << v;
+  return s.str();
+}
+
+static double reduce(tdzdd::Graph const& g, bool use_mp, int threads,
+                     size_t* size) {
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+  tdzdd::FrontierBasedSearch spec(g, 0, true);
+  tdzdd::DdStructure<2> dd(spec);
+  dd.useMultiProcessors(use_mp);
+  Clock::time_point start = Clock::now();
+  dd.zddReduce();
+  double t = std::chrono::duration<double>(Clock::now() - start).count();
+  *size = dd.size();
+  return t;
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 8;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+
+  tdzdd::Graph g;
+  for (int v = 1; v <= n * n; ++v) {
+    if (v % n != 0) g.addEdge(name(v), name(v + 1));
+    if (v <= (n - 1) * n) g.addEdge(name(v), name(v + n));
+  }
+  g.setColor(name(1), 1);
+  g.setColor(name(n * n), 1);
+  g.update();
+
+  size_t size = 0;
+  double base = reduce(g, false, 1, &size);
+  printf("%10s  %10s  %8s  %10s\n", "threads", "time", "speedup", "nodes");
+  printf("%10s  %8.3f s  %7.2fx  %10zu\n", "sequential", base, 1.0, size);
+#ifdef _OPENMP
+  // threads beyond the processors only add overhead
+  printf("(processors: %d)\n", omp_get_num_procs());
+  for (int t = 1; t <= max_threads; t *= 2) {
+    double mp = reduce(g, true, t, &size);
+    printf("%10d  %8.3f s  %7.2fx  %10zu\n", t, mp, base / mp, size);
+  }
+#else
+  (void) max_threads;
+  printf("(compiled without OpenMP; no parallel reduction)\n");
+#endif
+  return 0;
+}
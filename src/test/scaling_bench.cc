@@ -0,0 +1,113 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+// Scaling benchmark of the parallel DD builders: builds the DD of the
+// paths between the corners of a grid by FrontierBasedSearch with 1, 2,
+// 4, ... threads, with and without the per-thread block caches, and
+// counts its paths by the parallel evaluator.  Run as
+// `bench_scaling [grid size] [max threads]`.  The builders are used
+// directly so that this program can be compiled with OpenMP while the
+// library is not.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "subsetting/DdStructure.hpp"
+#include "subsetting/spec/FrontierBasedSearch.hpp"
+#include "subsetting/util/Graph.hpp"
+#include "subsetting/util/ThreadArena.hpp"
+
+using std::string;
+using tdzdd::ThreadArena;
+
+typedef std::chrono::steady_clock Clock;
+
+static string name(int v) {
+  std::stringstream s;
+  s << v;
+  return s.str();
+}
+
+static double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static double build(tdzdd::Graph const& g, int threads, size_t* size,
+                    double* count) {
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+  tdzdd::FrontierBasedSearch spec(g, 0, true);
+  Clock::time_point start = Clock::now();
+  tdzdd::DdStructure<2> dd(spec, true);
+  double t = seconds_since(start);
+  *size = dd.size();
+  start = Clock::now();
+  dd.zddCardinality();
+  *count = seconds_since(start);
+  return t;
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 8;
+  int max_threads = argc > 2 ? atoi(argv[2]) : 64;
+
+  tdzdd::Graph g;
+  for (int v = 1; v <= n * n; ++v) {
+    if (v % n != 0) g.addEdge(name(v), name(v + 1));
+    if (v <= (n - 1) * n) g.addEdge(name(v), name(v + n));
+  }
+  g.setColor(name(1), 1);
+  g.setColor(name(n * n), 1);
+  g.update();
+
+#ifndef _OPENMP
+  printf("(compiled without OpenMP; one thread only)\n");
+  max_threads = 1;
+#endif
+  size_t const limit = ThreadArena::cacheLimit();
+  printf("%7s  %10s  %10s  %8s  %10s  %10s\n", "threads", "arena", "malloc",
+         "speedup", "count", "nodes");
+  double base = 0;
+  for (int t = 1; t <= max_threads; t *= 2) {
+    size_t size = 0;
+    double count = 0;
+    ThreadArena::cacheLimit(limit);
+    double arena = build(g, t, &size, &count);
+    ThreadArena::cacheLimit(0);
+    double malloc = build(g, t, &size, &count);
+    if (t == 1) base = arena;
+    printf("%7d  %8.3f s  %8.3f s  %7.2fx  %8.3f s  %10zu\n", t, arena,
+           malloc, base / arena, count, size);
+  }
+  ThreadArena::cacheLimit(limit);
+  return 0;
+}
@@ -26,10 +26,12 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cmath>
 #include <cstdio>
 
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include "graphillion/zdd.h"
@@ -104,6 +106,7 @@ class TestSetset {
     this->lookup();
     this->modifiers();
     this->probability();
+    this->cost();
     this->io();
     this->large();
   }
@@ -116,13 +119,13 @@ class TestSetset {
     assert(setset::num_elems() == 2);
 
     map<string, vector<int> > m;
-    setset ss(m);
+    setset ss(m, setset::num_elems());
     assert(ss.zdd_ == s0 + s1 + s12 + s2);
 
     setset::num_elems(1);
     assert(setset::num_elems() == 1);
 
-    ss = setset(m);
+    ss = setset(m, setset::num_elems());
     assert(ss.zdd_ == s0 + s1);
   }
 
@@ -134,13 +137,13 @@ class TestSetset {
     assert(ss.zdd_ == s0 + s12 + s13);
 
     map<string, vector<int> > m;
-    ss = setset(m);
+    ss = setset(m, setset::num_elems());
     assert(ss.zdd_ == s0 + s1 + s2 + s3 + s12 + s13 + s23 + s123);
 
     m["include"].push_back(1);
     m["include"].push_back(2);
     m["exclude"].push_back(4);
-    ss = setset(m);
+    ss = setset(m, setset::num_elems());
     assert(ss.zdd_ == s12 + s123);
 
     // copy constructor
@@ -182,13 +185,20 @@ class TestSetset {
     assert(ss.smaller(3).zdd_ == s0 + s1 + s12 + s14 + s4);
     assert(ss.larger(3).zdd_ == s1234);
     assert(ss.set_size(3).zdd_ == s123 + s134);
+    assert(ss.set_size(0).zdd_ == s0);
+    assert(ss.larger(4).zdd_ == bot());
+    assert(ss.size_between(1, 2).zdd_ == s1 + s12 + s14 + s4);
+    assert(ss.size_between(2, 1).zdd_ == bot());
+    map<size_t, string> d = ss.size_dist();
+    assert(d.size() == 5);
+    assert(d[0] == "1" && d[1] == "2" && d[2] == "2" && d[3] == "2" && d[4] == "1");
 
     ss = setset(V("{{1,2}, {1,2,3}, {2,3,4}}"));
     assert(ss.minimal().zdd_ == s12 + s234);
     assert(ss.maximal().zdd_ == s123 + s234);
 
     ss = setset(V("{{1,2}, {1,4}, {2,3}, {3,4}}"));
-    assert(ss.hitting().zdd_ == s123 + s1234 + s124 + s13 + s134 + s234 + s24);
+    assert(ss.hitting(setset::num_elems()).zdd_ == s123 + s1234 + s124 + s13 + s134 + s234 + s24);
   }
 
   void binary_operators() {
@@ -413,25 +423,169 @@ class TestSetset {
     p.push_back(.6);
 
     setset ss = setset();
-    assert(ss.probability(p) == 0);
+    assert(ss.probability(p, setset::num_elems()) == 0);
 
     ss = setset(V("{{}}"));
-    assert_almost_equal(ss.probability(p), .0024);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .0024);
 
     ss = setset(V("{{1}}"));
-    assert_almost_equal(ss.probability(p), .0216);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .0216);
 
     ss = setset(V("{{2}}"));
-    assert_almost_equal(ss.probability(p), .0096);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .0096);
 
     ss = setset(V("{{1,2}, {1,3}}"));
-    assert_almost_equal(ss.probability(p), .1368);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .1368);
 
     ss = setset(V("{{1,2,3,4}}"));
-    assert_almost_equal(ss.probability(p), .3024);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .3024);
 
     ss = setset(V("{{}, {1}, {2}, {1,2}, {1,3}, {1,2,3,4}}"));
-    assert_almost_equal(ss.probability(p), .4728);
+    assert_almost_equal(ss.probability(p, setset::num_elems()), .4728);
+  }
+
+  void cost() {
+    setset::num_elems(4);
+
+    vector<bddcost> c;
+    c.push_back(2);
+    c.push_back(14);
+    c.push_back(4);
+    c.push_back(7);
+
+    setset ss(V("{{}, {1}, {2}, {3}, {4}, {1,2}, {1,4}, {1,3,4}, {2,3,4}, {1,2,3,4}}"));
+    assert(ss.cost_le(c, 13).zdd_ == s0 + s1 + s3 + s4 + s14 + s134);
+    assert(ss.cost_between(c, 4, 14).zdd_ == s2 + s3 + s4 + s14 + s134);
+    assert(ss.cost_between(c, 13, 13).zdd_ == s134);
+    assert(ss.cost_between(c, 14, 4).zdd_ == bot());
+    // each query builds its own cost table
+    assert(ss.cost_le(c, 9).zdd_ == s0 + s1 + s3 + s4 + s14);
+
+    map<bddcost, string> d = ss.cost_dist(c);
+    assert(d.size() == 10);
+    assert(d[0] == "1" && d[13] == "1" && d[27] == "1");
+    d = ss.cost_dist(c, 13);
+    assert(d.size() == 6);
+    assert(d.rbegin()->first == 13);
+    vector<double> p(5, 0.5);
+    map<bddcost, double> pd = ss.cost_dist(c, p);
+    assert(pd.size() == 10);
+    assert(pd[9] == 0.0625);
+
+    vector<double> w(5, 0);
+    w[1] = -1;
+    w[2] = 2;
+    w[4] = -1;
+    assert(ss.min_cost(w) == -2);
+    assert(ss.max_cost(w) == 2);
+    assert(ss.min_cost_sets(w).zdd_ == s14 + s134);
+    assert(ss.max_cost_sets(w).zdd_ == s2);
+    setset opt(V("{{1,4}, {1,3,4}}"));
+    assert(opt.find(ss.argmin(w)) != opt.end());
+    assert(ss.argmax(w) == *setset(V("{{2}}")).begin());
+    w[3] = 1;
+    assert(ss.min_cost(w) == -2);
+    assert(ss.min_cost_sets(w).zdd_ == s14);
+    assert(setset().min_cost(w) == std::numeric_limits<double>::infinity());
+    assert(setset().min_cost_sets(w).zdd_ == bot());
+    // weights must cover every element of the family
+    vector<double> short_w(4, 0);
+    int errors = 0;
+    try {
+      ss.min_cost(short_w);
+    } catch (const std::invalid_argument&) {
+      ++errors;
+    }
+    try {
+      ss.argmax(short_w);
+    } catch (const std::invalid_argument&) {
+      ++errors;
+    }
+    try {
+      ss.max_cost_sets(short_w);
+    } catch (const std::invalid_argument&) {
+      ++errors;
+    }
+    assert(errors == 3);
+    assert(setset(V("{{1,3}}")).min_cost(short_w) == 0);
+
+    vector<vector<bddcost> > cs(2, c);
+    cs[1] = vector<bddcost>(4, 1);
+    vector<bddcost> b;
+    b.push_back(13);
+    b.push_back(2);
+    assert(ss.cost_le(cs, b).zdd_ == s0 + s1 + s3 + s4 + s14);
+    b[1] = 3;
+    assert(ss.cost_le(cs, b).zdd_ == s0 + s1 + s3 + s4 + s14 + s134);
+
+    // a cost vector with unknown elements is rejected
+    bool rejected = false;
+    try {
+      ss.cost_le(vector<bddcost>(5, 1), 1);
+    } catch (const std::invalid_argument&) {
+      rejected = true;
+    }
+    assert(rejected);
+
+    // a context keeps its caches across queries
+    setset::cost_context ctx(c);
+    assert(ctx.le(ss, 13).zdd_ == s0 + s1 + s3 + s4 + s14 + s134);
+    assert(ctx.le(ss, 9).zdd_ == s0 + s1 + s3 + s4 + s14);
+    assert(ctx.between(ss, 4, 14).zdd_ == s2 + s3 + s4 + s14 + s134);
+    assert(ctx.dist(ss, 13) == ss.cost_dist(c, 13));
+    // and answers weight queries with the costs as weights
+    vector<double> cw(1, 0);
+    cw.insert(cw.end(), c.begin(), c.end());
+    assert(ctx.min_cost(ss) == 0);
+    assert(ctx.max_cost(ss) == 27);
+    assert(ctx.max_cost(ss - setset(V("{{1,2,3,4}}"))) == 25);
+    assert(ctx.argmax(ss) == ss.argmax(cw));
+    assert(ctx.argmin(ss).empty());
+    assert(ctx.min_cost_sets(ss).zdd_ == s0);
+    assert(ctx.max_cost_sets(ss).zdd_ == ss.max_cost_sets(cw).zdd_);
+    setset::cost_context short_ctx(vector<bddcost>(3, 1));
+    bool short_rejected = false;
+    try {
+      short_ctx.min_cost(ss);
+    } catch (const std::invalid_argument&) {
+      short_rejected = true;
+    }
+    assert(short_rejected);
+    // and rebuilds its table when new elements move the levels
+    setset::num_elems(BDD_VarUsed() + 1);
+    setset::num_elems(4);
+    assert(ctx.le(ss, 9).zdd_ == s0 + s1 + s3 + s4 + s14);
+    bool rejected_ctx = false;
+    try {
+      setset::cost_context bad(vector<bddcost>(5, 1));
+    } catch (const std::invalid_argument&) {
+      rejected_ctx = true;
+    }
+    assert(rejected_ctx);
+
+    // cost tables are independent of each other
+    BDDCT t1, t2;
+    t1.Alloc(BDD_VarUsed());
+    t2.Alloc(BDD_VarUsed());
+    for (int e = 1; e <= 4; ++e)
+      t1.SetCostOfLev(BDD_LevOfVar(e), c[e - 1]);
+    assert(t1.ZBDD_CostLE(ss.zdd_, 9) == s0 + s1 + s3 + s4 + s14);
+    assert(t2.ZBDD_CostLE(ss.zdd_, 1) == s0 + s1 + s2 + s3 + s4);
+    assert(t1.ZBDD_CostBetween(ss.zdd_, 4, 14) == s2 + s3 + s4 + s14 + s134);
+    assert(t1._stat[BDDCT::CA]._ent > 0);
+    assert(t1._stat[BDDCT::CA]._flush == 0);
+    t1.SetCacheLimit(1);
+    t1.CacheClear();
+    assert(t1.ZBDD_CostLE(ss.zdd_, 13) == s0 + s1 + s3 + s4 + s14 + s134);
+    assert(t1._stat[BDDCT::CA]._flush > 0);
+    assert(t1._caent <= 1);
+    // the bounds kept for each node are charged to the limit
+    t1.SetCacheLimit(4);
+    t1.CacheClear();
+    for (bddcost bound = 0; bound <= 20; ++bound) {
+      t1.ZBDD_CostLE(ss.zdd_, bound);
+      assert(t1._caent + t1._cakey <= 4 + 2);
+    }
   }
 
   void io() {
@@ -494,7 +648,7 @@ class TestSetset {
     int n = 1000;
     setset::num_elems(n);
     map<string, vector<int> > m;
-    setset ss = setset(m) - setset(V("{{1}, {1,2}}"));
+    setset ss = setset(m, setset::num_elems()) - setset(V("{{1}, {1,2}}"));
     assert(ss.size() == "10715086071862673209484250490600018105614048117055336074437503883703510511249361224931983788156958581275946729175531468251871452856923140435984577574698574803934567774824230985421074605062371141877954182153046474983581941267398767559165543946077062914571196477686542167660429831652624386837205668069374");
 
     int i = 0;
@@ -0,0 +1,161 @@
+/*********************************************************************
+Copyright 2013  JST ERATO Minato project and other contributors
+http://www-erato.ist.hokudai.ac.jp/?language=en
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**********************************************************************/
+
+// Microbenchmark of the state hashing implementations: raw hashing and
+// comparison of states of several sizes, and searches whose specs store
+// their states in words.  Run as `bench_state_hash [grid size]`.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "graphillion/graphset.h"
+#include "graphillion/partition/Partition.h"
+#include "graphillion/setset.h"
+#include "subsetting/util/StateHash.hpp"
+
+using namespace graphillion;
+using std::string;
+using std::vector;
+using tdzdd::StateHash;
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// The word loops used before StateHash, for reference.
+static size_t legacy_hash(const size_t* p, int n) {
+  size_t h = 0;
+  for (int i = 0; i < n; ++i) {
+    h += p[i];
+    h *= 314159257;
+  }
+  return h;
+}
+
+static bool legacy_equal(const size_t* p, const size_t* q, int n) {
+  for (int i = 0; i < n; ++i)
+    if (p[i] != q[i]) return false;
+  return true;
+}
+
+// Hashes states of n words and compares neighbouring ones, which are
+// mostly equal as in a unique table.
+static double bench_raw(int n, bool legacy, size_t* checksum) {
+  const int kStates = 1 << 12;
+  const int kRounds = (1 << 24) / kStates / n;
+  vector<size_t> words(static_cast<size_t>(kStates) * n);
+  unsigned long long x = 88172645463325252ULL;
+  for (size_t i = 0; i < words.size(); ++i) {
+    x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+    words[i] = (i / n) % 2 == 0 ? x & 0x00ff00ff00ff00ffULL : words[i - n];
+  }
+  Clock::time_point start = Clock::now();
+  size_t sum = 0;
+  for (int r = 0; r < kRounds; ++r) {
+    for (int i = 0; i + 1 < kStates; ++i) {
+      const size_t* p = &words[static_cast<size_t>(i) * n];
+      if (legacy) {
+        sum += legacy_hash(p, n);
+        sum += legacy_equal(p, p + n, n);
+      } else {
+        sum += StateHash::hash(p, n);
+        sum += StateHash::equal(p, p + n, n);
+      }
+    }
+  }
+  *checksum += sum;
+  return seconds_since(start) * 1e9 / (static_cast<double>(kRounds) * kStates);
+}
+
+static vector<edge_t> grid(int n) {
+  vector<edge_t> g;
+  for (int v = 1; v <= n * n; ++v) {
+    std::stringstream s1, s2, s3;
+    s1 << v;
+    s2 << v + 1;
+    s3 << v + n;
+    if (v % n != 0) g.push_back(std::make_pair(s1.str(), s2.str()));
+    if (v <= (n - 1) * n) g.push_back(std::make_pair(s1.str(), s3.str()));
+  }
+  return g;
+}
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 7;
+  vector<edge_t> g = grid(n);
+  setset::num_elems(g.size());
+
+  std::stringstream last;
+  last << n * n;
+  vector<vector<vertex_t> > ends(1);
+  ends[0].push_back("1");
+  ends[0].push_back(last.str());
+  std::map<vertex_t, Range> degrees;
+  for (int v = 1; v <= n * n; ++v) {
+    std::stringstream s;
+    s << v;
+    degrees[s.str()] = v == 1 || v == n * n ? Range(1, 2) : Range(0, 3, 2);
+  }
+
+  const int sizes[] = {2, 4, 8, 16, 32};
+  const StateHash::Impl impls[] = {StateHash::SCALAR, StateHash::SSE42,
+                                   StateHash::AVX2};
+  size_t checksum = 0;
+
+  printf("%-8s", "impl");
+  for (int i = 0; i < 5; ++i) printf("  %5d words", sizes[i]);
+  printf("  %10s  %10s  %10s\n", "paths", "partitions", "count");
+  printf("%-8s", "legacy");
+  for (int i = 0; i < 5; ++i)
+    printf("  %8.2f ns", bench_raw(sizes[i], true, &checksum));
+  printf("\n");
+  for (int k = 0; k < 3; ++k) {
+    if (!StateHash::supported(impls[k])) continue;
+    StateHash::select(impls[k]);
+    printf("%-8s", StateHash::name(impls[k]));
+    for (int i = 0; i < 5; ++i)
+      printf("  %8.2f ns", bench_raw(sizes[i], false, &checksum));
+
+    Clock::time_point start = Clock::now();
+    setset paths = SearchGraphs(g, &ends, &degrees, NULL, 0, true);
+    printf("  %8.3f s", seconds_since(start));
+    start = Clock::now();
+    setset partitions = SearchPartitions(g, 2, 3);
+    printf("  %8.3f s", seconds_since(start));
+    start = Clock::now();
+    string count = CountGraphs(g, &ends, &degrees, NULL, 0, true);
+    printf("  %8.3f s\n", seconds_since(start));
+    checksum += paths.size().size() + partitions.size().size() + count.size();
+  }
+  StateHash::select();
+  printf("(checksum %zu)\n", checksum);
+  return 0;
+}